@@ -3,13 +3,14 @@
 #include <math.h>
 
 #include "matrix.h"
+#include "memory.h"
 
 /**
  * @brief Tanımsız bir matrix yapısı oluştur.
  * işlem basamakalrında yaşanacak olumsuzluklar
  * için bir geridönüş değeridir.
  */
-const matrix MATRIX_UNDEFINED = {0, 0, NULL, NULL};
+const fmatrix FMATRIX_UNDEFINED = {0, 0, NULL};
 
 /**
  * @brief Matrix için bellekten alan tahsilatı
@@ -18,32 +19,50 @@ const matrix MATRIX_UNDEFINED = {0, 0, NULL, NULL};
  * @param col
  * @return matrix
  */
-matrix allocate_matrix_mem(MX row, MX col)
+fmatrix allocate_matrix_mem(MX row, MX col)
 {
     /* MATRIX ESLESMESI */
-    matrix rt_matrix;
+    fmatrix rt_matrix;
     rt_matrix.row = row;
     rt_matrix.col = col;
 
-    /* ilk pointer için row adet float pointer tahsil edilir */
-    // BURADA ASLINDA SADECE ROW ADET float POINTER OLUŞTURUYORUZ
-    rt_matrix.elements = malloc(row * sizeof(float));
+    /* row adet float pointer ve ardından row * col float tek blokta tahsil edilir */
+    rt_matrix.elements = (float **)MEMORY_ALLOC(row * sizeof(float *) + (size_t)row * col * sizeof(float));
 
-    /* ayrılan her bir pointer için col adet float değer tahsil edilir */
+    if (rt_matrix.elements == NULL)
+    {
+        printf("\n\nMatrix allocation failed\n\n");
+        return FMATRIX_UNDEFINED;
+    }
+
+    float *data = (float *)(rt_matrix.elements + row);
+
+    /* her pointer kendi satırının başlangıcını gösterir */
     for (MX i = 0; i < row; i++)
     {
-        rt_matrix.elements[i] = malloc(col * sizeof(float));
+        rt_matrix.elements[i] = data + (size_t)i * col;
     }
 
     return rt_matrix;
 }
 
+/**
+ * @brief Matrixin belleğini bırakır.
+ *
+ * @param matx
+ */
+void free_matrix(fmatrix *matx)
+{
+    memory_free(matx->elements);
+    *matx = FMATRIX_UNDEFINED;
+}
+
 /**
  * @brief Matrix konsolda yazdırmak için kullanılan fonksiyon.
  *
  * @param matx
  */
-void print_matrix(matrix matx)
+void print_matrix(fmatrix matx)
 {
 
     if (matx.row == 0 && matx.col == 0 && matx.elements == NULL)
@@ -91,16 +110,16 @@ void print_matrix(matrix matx)
  * @param col
  * @return matrix
  */
-matrix identity_matrix(MX row, MX col)
+fmatrix identity_matrix(MX row, MX col)
 {
     if ((row != col) || row < 1 || col < 1)
     {
-        return MATRIX_UNDEFINED;
+        return FMATRIX_UNDEFINED;
     }
 
-    matrix rt_matrix = allocate_matrix_mem(row, col);
+    fmatrix rt_matrix = allocate_matrix_mem(row, col);
 
-    for (MX i = 0; i < row; i++)
+    for (MX i = 0; i < rt_matrix.row; i++)
     {
         for (MX c = 0; c < col; c++)
         {
@@ -126,17 +145,14 @@ matrix identity_matrix(MX row, MX col)
  * @param col
  * @return matrix
  */
-matrix zero_matrix(MX row, MX col)
+fmatrix zero_matrix(MX row, MX col)
 {
 
-    matrix rt_matrix = allocate_matrix_mem(row, col);
+    fmatrix rt_matrix = allocate_matrix_mem(row, col);
 
-    for (MX i = 0; i < row; i++)
+    for (MX i = 0; i < rt_matrix.row; i++)
     {
-        for (MX c = 0; c < col; c++)
-        {
-            rt_matrix.elements[i][c] = 0.0f;
-        }
+        memset(rt_matrix.elements[i], 0, col * sizeof(float));
     }
 
     return rt_matrix;
@@ -150,15 +166,14 @@ matrix zero_matrix(MX row, MX col)
  * @param ... (liste şeklinde elemanları alır)
  * @return matrix
  */
-matrix create_matrix(MX row, MX col, ...)
+fmatrix create_matrix(MX row, MX col, ...)
 {
-    matrix ret_matrix = allocate_matrix_mem(row, col);
-    MX size = row * col;
+    fmatrix ret_matrix = allocate_matrix_mem(row, col);
 
     va_list list;
-    va_start(list, size);
+    va_start(list, col);
 
-    for (MX i = 0; i < row; i++)
+    for (MX i = 0; i < ret_matrix.row; i++)
     {
         for (MX c = 0; c < col; c++)
         {
@@ -175,14 +190,30 @@ matrix create_matrix(MX row, MX col, ...)
  * @brief Bir Matrix öğesini kopyalamak için.
  *
  * @param mat
- * @return matrix
+ * @return fmatrix
  */
-matrix copy_matrix(matrix mat);
+fmatrix copy_matrix(fmatrix mat)
+{
+    fmatrix ret_matrix = allocate_matrix_mem(mat.row, mat.col);
+
+    for (MX i = 0; i < ret_matrix.row; i++)
+    {
+        memcpy(ret_matrix.elements[i], mat.elements[i], mat.col * sizeof(float));
+    }
+
+    return ret_matrix;
+}
 
 /**
  * @brief Bir matrix öğesini pointer ile kopyalamak için.
  *
- * @param mat Kopyalanacak öğe
+ * @param mat Kopyalanacak öğe; artık kendi kopyasını gösterir
  * @return void
  */
-void copy_matrix_ptr(matrix *mat);
\ No newline at end of file
+void copy_matrix_ptr(fmatrix *mat)
+{
+    fmatrix own = copy_matrix(*mat);
+
+    free_matrix(mat);
+    *mat = own;
+}
\ No newline at end of file
@@ -10,8 +10,12 @@ typedef unsigned int MX;
 #define MATRIX_H
 
 /**
- * @brief Bu Struct tanımı matrixin genel tanımıdır.
+ * @brief Satır pointerları ile tutulan matrix (elements[i][j]).
  *
+ * VMATRIX/vmatrix.h'deki matrix ile aynı programda kullanılabilmesi için
+ * fmatrix adını taşır. Satırlar ve pointer dizisi tek blokta tahsis edilir;
+ * __matrix_from_fmatrix ve __fmatrix_from_matrix iki düzen arasında
+ * kopyalamadan geçiş sağlar.
  */
 typedef struct
 {
@@ -22,13 +26,13 @@ typedef struct
     /* Matrix Vectors */
     float **elements;
 
-} matrix;
+} fmatrix;
 
 /**
  * @brief Tanımsız ifade oluşturabilecek durumlarda geri dönüş değeridir.
  *
  */
-extern const matrix MATRIX_UNDEFINED;
+extern const fmatrix FMATRIX_UNDEFINED;
 
 /**
  * @brief Matrix için bellekten alan tahsilatı
@@ -37,14 +41,21 @@ extern const matrix MATRIX_UNDEFINED;
  * @param col
  * @return matrix
  */
-matrix allocate_matrix_mem(MX row, MX col);
+fmatrix allocate_matrix_mem(MX row, MX col);
+
+/**
+ * @brief allocate_matrix_mem veya __fmatrix_from_matrix ile alınan belleği bırakır.
+ *
+ * @param matx
+ */
+void free_matrix(fmatrix *matx);
 
 /**
  * @brief Matrix konsolda yazdırmak için kullanılan fonksiyon.
  *
  * @param matx
  */
-void print_matrix(matrix matx);
+void print_matrix(fmatrix matx);
 
 /**
  * @brief Row*Col Boyutunda Birim matris oluşturur
@@ -53,7 +64,7 @@ void print_matrix(matrix matx);
  * @param col
  * @return matrix
  */
-matrix identity_matrix(MX row, MX col);
+fmatrix identity_matrix(MX row, MX col);
 
 /**
  * @brief Row*Col Boyutunda 0(sıfır) Matris oluşturur
@@ -62,7 +73,7 @@ matrix identity_matrix(MX row, MX col);
  * @param col
  * @return matrix
  */
-matrix zero_matrix(MX row, MX col);
+fmatrix zero_matrix(MX row, MX col);
 
 /**
  * @brief Matrix objesi oluşturmak için
@@ -72,7 +83,7 @@ matrix zero_matrix(MX row, MX col);
  * @param ... (liste şeklinde istenilen elemanları alır)
  * @return matrix
  */
-matrix create_matrix(MX row, MX col, ...);
+fmatrix create_matrix(MX row, MX col, ...);
 
 /**
  * @brief Bir Matrix öğesini kopyalamak için.
@@ -80,14 +91,17 @@ matrix create_matrix(MX row, MX col, ...);
  * @param mat
  * @return matrix
  */
-matrix copy_matrix(matrix mat);
+fmatrix copy_matrix(fmatrix mat);
 
 /**
  * @brief Bir matrix öğesini pointer ile kopyalamak için.
  *
+ * mat kendi kopyasını gösterecek şekilde değiştirilir; başka bir depolamanın
+ * görünümü ise (__fmatrix_from_matrix) görünüm bırakılır ve bağımsız hale gelir.
+ *
  * @param mat Kopyalanacak öğe
  * @return void
  */
-void copy_matrix_ptr(matrix *mat);
+void copy_matrix_ptr(fmatrix *mat);
 
 #endif
\ No newline at end of file
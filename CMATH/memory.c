@@ -0,0 +1,400 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+#include "memory.h"
+#include "profile.h"
+
+/**
+ * @brief Takip tablosunun kova sayısı (2'nin kuvveti olmalı).
+ */
+#define MEMORY_BUCKETS 65536
+
+/**
+ * @brief Takip edilen her blok için bir kayıt.
+ */
+typedef struct memory_block
+{
+    void *ptr;
+    size_t size;
+
+    const char *func;
+    const char *file;
+    int line;
+
+    struct memory_block *next;
+
+} memory_block;
+
+static memory_alloc_fn memory_alloc_hook = NULL;
+static memory_free_fn memory_free_hook = NULL;
+static void *memory_hook_ctx = NULL;
+
+static pthread_mutex_t memory_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t memory_env_once = PTHREAD_ONCE_INIT;
+
+static volatile bool memory_is_tracking = false;
+static memory_block **memory_table = NULL;
+static memory_stats memory_current;
+
+/**
+ * @brief Blok adresinden kova indeksi.
+ */
+static size_t memory_hash(const void *ptr)
+{
+    size_t h = (size_t)ptr;
+
+    h ^= h >> 17;
+    h *= (size_t)0x9E3779B97F4A7C15ull;
+    h ^= h >> 29;
+
+    return h & (MEMORY_BUCKETS - 1);
+}
+
+/**
+ * @brief CMATRIX_MEMTRACK ortam değişkeni ile takibi açar.
+ */
+static void memory_read_env(void)
+{
+    const char *env = getenv("CMATRIX_MEMTRACK");
+
+    if (env != NULL && env[0] != '\0' && env[0] != '0')
+    {
+        memory_tracking(true);
+        memory_report_at_exit();
+    }
+}
+
+void memory_set_allocator(memory_alloc_fn alloc_fn, memory_free_fn free_fn, void *ctx)
+{
+    pthread_mutex_lock(&memory_lock);
+
+    memory_alloc_hook = alloc_fn;
+    memory_free_hook = free_fn;
+    memory_hook_ctx = ctx;
+
+    pthread_mutex_unlock(&memory_lock);
+}
+
+void memory_tracking(bool enable)
+{
+    pthread_mutex_lock(&memory_lock);
+
+    if (enable && memory_table == NULL)
+    {
+        memory_table = (memory_block **)calloc(MEMORY_BUCKETS, sizeof(memory_block *));
+    }
+
+    memory_is_tracking = enable && memory_table != NULL;
+
+    pthread_mutex_unlock(&memory_lock);
+}
+
+bool memory_tracking_enabled(void)
+{
+    return memory_is_tracking;
+}
+
+/**
+ * @brief Takip açıksa bloğu tabloya ekler.
+ */
+static void memory_track(void *ptr, size_t size, const char *func, const char *file, int line)
+{
+    PROFILE_ALLOC(size);
+
+    if (!memory_is_tracking)
+    {
+        return;
+    }
+
+    memory_block *block = (memory_block *)malloc(sizeof(memory_block));
+
+    if (block == NULL)
+    {
+        return;
+    }
+
+    block->ptr = ptr;
+    block->size = size;
+    block->func = func;
+    block->file = file;
+    block->line = line;
+
+    pthread_mutex_lock(&memory_lock);
+
+    size_t h = memory_hash(ptr);
+    block->next = memory_table[h];
+    memory_table[h] = block;
+
+    memory_current.live_bytes += size;
+    memory_current.live_blocks++;
+    memory_current.total_allocations++;
+
+    if (memory_current.live_bytes > memory_current.peak_bytes)
+    {
+        memory_current.peak_bytes = memory_current.live_bytes;
+    }
+
+    pthread_mutex_unlock(&memory_lock);
+}
+
+/**
+ * @brief Blok takip ediliyorsa tablodan çıkarır.
+ */
+static void memory_untrack(void *ptr)
+{
+    /* Takip kapatılmış olsa bile daha önce kaydedilen bloklar tablodan düşülür */
+    if (memory_table != NULL)
+    {
+        pthread_mutex_lock(&memory_lock);
+
+        memory_block **link = &memory_table[memory_hash(ptr)];
+
+        while (*link != NULL && (*link)->ptr != ptr)
+        {
+            link = &(*link)->next;
+        }
+
+        memory_block *block = *link;
+
+        if (block != NULL)
+        {
+            *link = block->next;
+
+            memory_current.live_bytes -= block->size;
+            memory_current.live_blocks--;
+            memory_current.total_frees++;
+        }
+
+        pthread_mutex_unlock(&memory_lock);
+
+        free(block);
+    }
+}
+
+void *memory_alloc(size_t size, const char *func, const char *file, int line)
+{
+    pthread_once(&memory_env_once, memory_read_env);
+
+    void *ptr = memory_alloc_hook != NULL ? memory_alloc_hook(size, memory_hook_ctx)
+                                          : malloc(size);
+
+    if (ptr != NULL)
+    {
+        memory_track(ptr, size, func, file, line);
+    }
+
+    return ptr;
+}
+
+void memory_free(void *ptr)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    memory_untrack(ptr);
+
+    if (memory_free_hook != NULL)
+    {
+        memory_free_hook(ptr, memory_hook_ctx);
+    }
+    else
+    {
+        free(ptr);
+    }
+}
+
+void *memory_alloc_aligned(size_t size, size_t alignment, const char *func, const char *file, int line)
+{
+    pthread_once(&memory_env_once, memory_read_env);
+
+    /* Boyut hizalamanın katına yuvarlanır; 0 boyut da geçerli bir blok döndürür */
+    size_t rounded = (size + alignment - 1) & ~(alignment - 1);
+
+    if (rounded == 0)
+    {
+        rounded = alignment;
+    }
+
+    void *ptr = NULL;
+
+    if (memory_alloc_hook != NULL)
+    {
+        /* Kullanıcı tahsis edicisinin hizalama garantisi yok; fazladan alınır
+           ve asıl adres hizalı bloğun hemen önüne yazılır */
+        void *raw = memory_alloc_hook(rounded + alignment + sizeof(void *), memory_hook_ctx);
+
+        if (raw != NULL)
+        {
+            uintptr_t start = (uintptr_t)raw + sizeof(void *);
+            ptr = (void *)((start + alignment - 1) & ~(uintptr_t)(alignment - 1));
+            ((void **)ptr)[-1] = raw;
+        }
+    }
+    else
+    {
+#ifdef _WIN32
+        ptr = _aligned_malloc(rounded, alignment);
+#else
+        if (posix_memalign(&ptr, alignment, rounded) != 0)
+        {
+            ptr = NULL;
+        }
+#endif
+    }
+
+    if (ptr != NULL)
+    {
+        memory_track(ptr, rounded, func, file, line);
+    }
+
+    return ptr;
+}
+
+void memory_free_aligned(void *ptr)
+{
+    if (ptr == NULL)
+    {
+        return;
+    }
+
+    memory_untrack(ptr);
+
+    if (memory_free_hook != NULL)
+    {
+        memory_free_hook(((void **)ptr)[-1], memory_hook_ctx);
+    }
+    else
+    {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        free(ptr);
+#endif
+    }
+}
+
+void memory_get_stats(memory_stats *stats)
+{
+    pthread_mutex_lock(&memory_lock);
+    *stats = memory_current;
+    pthread_mutex_unlock(&memory_lock);
+}
+
+/**
+ * @brief Rapor için tahsis yeri başına toplam.
+ */
+typedef struct
+{
+    const char *func;
+    const char *file;
+    int line;
+
+    unsigned long long blocks;
+    unsigned long long bytes;
+
+} memory_site_total;
+
+static int memory_site_compare(const void *a, const void *b)
+{
+    const memory_site_total *x = (const memory_site_total *)a;
+    const memory_site_total *y = (const memory_site_total *)b;
+
+    if (x->bytes != y->bytes)
+    {
+        return x->bytes < y->bytes ? 1 : -1;
+    }
+
+    return 0;
+}
+
+void memory_report(FILE *out)
+{
+    pthread_mutex_lock(&memory_lock);
+
+    memory_stats stats = memory_current;
+
+    fprintf(out, "\nMemory: live %llu bytes in %llu blocks, peak %llu bytes, %llu allocations, %llu frees\n",
+            stats.live_bytes, stats.live_blocks, stats.peak_bytes,
+            stats.total_allocations, stats.total_frees);
+
+    if (memory_table == NULL || stats.live_blocks == 0)
+    {
+        pthread_mutex_unlock(&memory_lock);
+        return;
+    }
+
+    /* En kötü durumda her blok farklı bir yerden tahsis edilmiştir */
+    memory_site_total *sites = (memory_site_total *)calloc(stats.live_blocks, sizeof(memory_site_total));
+    size_t site_count = 0;
+
+    if (sites == NULL)
+    {
+        pthread_mutex_unlock(&memory_lock);
+        return;
+    }
+
+    for (size_t b = 0; b < MEMORY_BUCKETS; b++)
+    {
+        for (memory_block *block = memory_table[b]; block != NULL; block = block->next)
+        {
+            size_t s = 0;
+
+            /* Aynı yer için string sabitleri aynı adrestedir */
+            while (s < site_count &&
+                   !(sites[s].line == block->line && sites[s].file == block->file &&
+                     sites[s].func == block->func))
+            {
+                s++;
+            }
+
+            if (s == site_count)
+            {
+                sites[s].func = block->func;
+                sites[s].file = block->file;
+                sites[s].line = block->line;
+                site_count++;
+            }
+
+            sites[s].blocks++;
+            sites[s].bytes += block->size;
+        }
+    }
+
+    pthread_mutex_unlock(&memory_lock);
+
+    qsort(sites, site_count, sizeof(memory_site_total), memory_site_compare);
+
+    fprintf(out, "Outstanding allocations by site:\n");
+
+    for (size_t s = 0; s < site_count; s++)
+    {
+        fprintf(out, "  %14llu bytes %10llu blocks  %s (%s:%d)\n",
+                sites[s].bytes, sites[s].blocks, sites[s].func, sites[s].file, sites[s].line);
+    }
+
+    free(sites);
+}
+
+static void memory_report_stderr(void)
+{
+    memory_report(stderr);
+}
+
+void memory_report_at_exit(void)
+{
+    static bool registered = false;
+
+    if (!registered)
+    {
+        registered = true;
+        atexit(memory_report_stderr);
+    }
+}
\ No newline at end of file
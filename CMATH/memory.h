@@ -0,0 +1,139 @@
+#include <stddef.h>
+#include <stdio.h>
+
+#include "cmath.h"
+
+#ifndef MEMORY_H
+#define MEMORY_H
+
+/**
+ * @brief Kullanıcı tarafından verilebilen tahsis fonksiyonları.
+ *
+ * ctx memory_set_allocator ile verilen bağlamdır.
+ */
+typedef void *(*memory_alloc_fn)(size_t size, void *ctx);
+typedef void (*memory_free_fn)(void *ptr, void *ctx);
+
+/**
+ * @brief Bellek muhasebesi sonuçları.
+ *
+ * Değerler yalnızca takip açıkken tahsis edilen bloklar için tutulur.
+ */
+typedef struct
+{
+    unsigned long long live_bytes;
+    unsigned long long peak_bytes;
+    unsigned long long live_blocks;
+
+    unsigned long long total_allocations;
+    unsigned long long total_frees;
+
+} memory_stats;
+
+/**
+ * @brief Vektör ve matrix tamponlarının tahsis edileceği fonksiyonları değiştirir.
+ *
+ * NULL verilirse malloc/free kullanılır. Zaten tahsis edilmiş bloklar
+ * varken değiştirilmemelidir; her blok kendi tahsis edicisi ile serbest bırakılır.
+ *
+ * @param alloc_fn
+ * @param free_fn
+ * @param ctx
+ */
+void memory_set_allocator(memory_alloc_fn alloc_fn, memory_free_fn free_fn, void *ctx);
+
+/**
+ * @brief Tahsis takibini açar veya kapatır.
+ *
+ * Açıkken her blok boyutu ve tahsis yeri ile birlikte kaydedilir.
+ * CMATRIX_MEMTRACK ortam değişkeni tanımlıysa takip ilk tahsiste
+ * kendiliğinden açılır ve çıkışta rapor stderr'e yazılır.
+ *
+ * @param enable
+ */
+void memory_tracking(bool enable);
+
+/**
+ * @brief Tahsis takibinin açık olup olmadığını döndürür.
+ *
+ * @return bool
+ */
+bool memory_tracking_enabled(void);
+
+/**
+ * @brief Bellek tahsis eder.
+ *
+ * Doğrudan değil MEMORY_ALLOC makrosu ile çağrılır.
+ *
+ * @param size
+ * @param func Tahsisi isteyen fonksiyon
+ * @param file
+ * @param line
+ * @return void*
+ */
+void *memory_alloc(size_t size, const char *func, const char *file, int line);
+
+/**
+ * @brief memory_alloc ile alınmış bir bloğu serbest bırakır. NULL kabul eder.
+ *
+ * @param ptr
+ */
+void memory_free(void *ptr);
+
+/**
+ * @brief Başlangıç adresi alignment baytına hizalı bellek tahsis eder.
+ *
+ * Doğrudan değil MEMORY_ALLOC_ALIGNED makrosu ile çağrılır.
+ * alignment 2'nin kuvveti ve en az sizeof(void *) olmalıdır.
+ *
+ * @param size
+ * @param alignment
+ * @param func
+ * @param file
+ * @param line
+ * @return void*
+ */
+void *memory_alloc_aligned(size_t size, size_t alignment, const char *func, const char *file, int line);
+
+/**
+ * @brief memory_alloc_aligned ile alınmış bir bloğu serbest bırakır. NULL kabul eder.
+ *
+ * @param ptr
+ */
+void memory_free_aligned(void *ptr);
+
+/**
+ * @brief Anlık muhasebe değerleri.
+ *
+ * @param stats
+ */
+void memory_get_stats(memory_stats *stats);
+
+/**
+ * @brief Serbest bırakılmamış blokları tahsis yerine göre gruplayıp yazdırır.
+ *
+ * @param out
+ */
+void memory_report(FILE *out);
+
+/**
+ * @brief Program sonlanırken memory_report(stderr) çağrılmasını sağlar.
+ *
+ */
+void memory_report_at_exit(void);
+
+/**
+ * Çağrıldığı yerin fonksiyon, dosya ve satır bilgisi.
+ */
+#define MEMORY_SITE __func__, __FILE__, __LINE__
+
+#define MEMORY_ALLOC(size) memory_alloc((size), MEMORY_SITE)
+
+/**
+ * Vektör ve matrix satırları için hizalama (bir önbellek satırı).
+ */
+#define MEMORY_ALIGNMENT 64
+
+#define MEMORY_ALLOC_ALIGNED(size) memory_alloc_aligned((size), MEMORY_ALIGNMENT, MEMORY_SITE)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,594 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "parallel.h"
+#include "profile.h"
+
+/**
+ * @brief Bir işçinin görev kuyruğunun kapasitesi. Dolarsa görev
+ * parallel_spawn içinde hemen çalıştırılır.
+ */
+#define PARALLEL_DEQUE_SIZE 1024
+
+/**
+ * @brief Kuyruktaki görev.
+ */
+typedef struct
+{
+    parallel_task_fn fn;
+    void *arg;
+    parallel_group *group;
+
+} parallel_task;
+
+/**
+ * @brief İşçi başına iki uçlu kuyruk. Sahibi alt uca ekler ve oradan
+ * alır (LIFO), boşta kalan işçiler üst uçtan çalar (FIFO). Kuyruk kısa
+ * tutulan bir spin kilit ile korunur.
+ */
+typedef struct
+{
+    atomic_flag lock;
+    unsigned int top;
+    unsigned int bottom;
+
+    parallel_task tasks[PARALLEL_DEQUE_SIZE];
+
+} parallel_deque;
+
+/**
+ * @brief Havuzda çalışan iş.
+ * parallel_for işlerinde parçalar atomik bir sayaçtan sırayla alınır;
+ * görev oturumlarında (tasks) işçiler kuyruklardan görev çalar.
+ */
+typedef struct
+{
+    parallel_range_fn fn;
+    void *ctx;
+
+    bool tasks;
+    atomic_bool tasks_done;
+
+    unsigned long end;
+    unsigned long grain;
+    atomic_ulong next;
+
+    /* İşi henüz bitirmemiş havuz thread'leri */
+    unsigned int pending;
+
+    /* İşçilerin donanım sayaçlarının ekleneceği thread (PROFILE_HW_OWNER) */
+    void *profile_owner;
+
+} parallel_job;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t pool_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t pool_done = PTHREAD_COND_INITIALIZER;
+
+/* Aynı anda havuzda tek bir iş çalışır */
+static pthread_mutex_t pool_submit = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_t *pool_workers = NULL;
+static unsigned int pool_count = 0;
+static unsigned long pool_generation = 0;
+static bool pool_stop = false;
+static parallel_job pool_job;
+static parallel_deque *pool_deques = NULL;
+
+static unsigned int parallel_requested = 0;
+
+/* Havuz thread'inde veya bir parallel_for içinde miyiz */
+static _Thread_local bool parallel_inside = false;
+
+/* Görev oturumundaki işçi numarası, oturum dışında -1 */
+static _Thread_local int parallel_task_worker = -1;
+
+/**
+ * @brief CMATRIX_THREADS veya işlemci sayısı.
+ */
+static unsigned int parallel_default_threads(void)
+{
+    const char *env = getenv("CMATRIX_THREADS");
+
+    if (env != NULL && atoi(env) > 0)
+    {
+        return (unsigned int)atoi(env);
+    }
+
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (unsigned int)info.dwNumberOfProcessors : 1;
+#else
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (unsigned int)n : 1;
+#endif
+}
+
+/**
+ * @brief Parçalar bitene kadar iş çalıştırır.
+ */
+static void parallel_run_chunks(unsigned int worker)
+{
+    const unsigned long end = pool_job.end;
+    const unsigned long grain = pool_job.grain;
+
+    for (;;)
+    {
+        unsigned long begin = atomic_fetch_add(&pool_job.next, grain);
+
+        if (begin >= end)
+        {
+            break;
+        }
+
+        unsigned long stop = end - begin > grain ? begin + grain : end;
+        pool_job.fn(pool_job.ctx, begin, stop, worker);
+    }
+}
+
+//
+//  İş çalan görev zamanlayıcısı
+//
+
+static void parallel_deque_lock(parallel_deque *d)
+{
+    while (atomic_flag_test_and_set_explicit(&d->lock, memory_order_acquire))
+    {
+    }
+}
+
+static void parallel_deque_unlock(parallel_deque *d)
+{
+    atomic_flag_clear_explicit(&d->lock, memory_order_release);
+}
+
+static bool parallel_deque_push(parallel_deque *d, parallel_task task)
+{
+    bool pushed = false;
+
+    parallel_deque_lock(d);
+
+    if (d->bottom - d->top < PARALLEL_DEQUE_SIZE)
+    {
+        d->tasks[d->bottom % PARALLEL_DEQUE_SIZE] = task;
+        d->bottom++;
+        pushed = true;
+    }
+
+    parallel_deque_unlock(d);
+
+    return pushed;
+}
+
+/**
+ * @brief Sahibin kuyruğun alt ucundan (en son eklenen) veya başka bir
+ * işçinin üst ucundan (en eski) görev alması.
+ */
+static bool parallel_deque_take(parallel_deque *d, parallel_task *task, bool steal)
+{
+    bool taken = false;
+
+    parallel_deque_lock(d);
+
+    if (d->bottom != d->top)
+    {
+        if (steal)
+        {
+            *task = d->tasks[d->top % PARALLEL_DEQUE_SIZE];
+            d->top++;
+        }
+        else
+        {
+            d->bottom--;
+            *task = d->tasks[d->bottom % PARALLEL_DEQUE_SIZE];
+        }
+        taken = true;
+    }
+
+    parallel_deque_unlock(d);
+
+    return taken;
+}
+
+/**
+ * @brief Kendi kuyruğundan, o boşsa diğer işçilerden bir görev alıp çalıştırır.
+ *
+ * @return bool Görev çalıştırıldıysa true
+ */
+static bool parallel_run_one(unsigned int worker)
+{
+    const unsigned int workers = pool_count + 1;
+    parallel_task task;
+    bool found = parallel_deque_take(&pool_deques[worker], &task, false);
+
+    for (unsigned int i = 1; !found && i < workers; i++)
+    {
+        found = parallel_deque_take(&pool_deques[(worker + i) % workers], &task, true);
+    }
+
+    if (!found)
+    {
+        return false;
+    }
+
+    task.fn(task.arg);
+    atomic_fetch_sub(&task.group->pending, 1);
+
+    return true;
+}
+
+/**
+ * @brief Havuz thread'lerinin görev oturumu boyunca çalıştırdığı döngü.
+ */
+static void parallel_task_loop(unsigned int worker)
+{
+    unsigned int idle = 0;
+
+    parallel_task_worker = (int)worker;
+
+    while (!atomic_load(&pool_job.tasks_done))
+    {
+        if (parallel_run_one(worker))
+        {
+            idle = 0;
+        }
+        else if (++idle > 64)
+        {
+            sched_yield();
+        }
+    }
+
+    parallel_task_worker = -1;
+}
+
+void parallel_group_init(parallel_group *group)
+{
+    atomic_init(&group->pending, 0);
+}
+
+void parallel_spawn(parallel_group *group, parallel_task_fn fn, void *arg)
+{
+    // Oturum dışında (veya seri durumda) görev hemen çalışır
+    if (parallel_task_worker < 0)
+    {
+        fn(arg);
+        return;
+    }
+
+    parallel_task task = {fn, arg, group};
+
+    atomic_fetch_add(&group->pending, 1);
+
+    if (!parallel_deque_push(&pool_deques[parallel_task_worker], task))
+    {
+        atomic_fetch_sub(&group->pending, 1);
+        fn(arg);
+    }
+}
+
+void parallel_wait(parallel_group *group)
+{
+    unsigned int idle = 0;
+
+    // Beklerken boş durulmaz; kendi kuyruğundaki veya çalınan görevler çalıştırılır
+    while (atomic_load(&group->pending) > 0)
+    {
+        if (parallel_run_one((unsigned int)parallel_task_worker))
+        {
+            idle = 0;
+        }
+        else if (++idle > 64)
+        {
+            sched_yield();
+        }
+    }
+}
+
+void parallel_join(parallel_task_fn fn_a, void *arg_a, parallel_task_fn fn_b, void *arg_b)
+{
+    parallel_group group;
+
+    parallel_group_init(&group);
+    parallel_spawn(&group, fn_b, arg_b);
+
+    fn_a(arg_a);
+
+    parallel_wait(&group);
+}
+
+static void *parallel_worker_main(void *arg)
+{
+    unsigned int worker = (unsigned int)(size_t)arg;
+    unsigned long seen = 0;
+
+    parallel_inside = true;
+
+    pthread_mutex_lock(&pool_lock);
+
+    for (;;)
+    {
+        while (!pool_stop && pool_generation == seen)
+        {
+            pthread_cond_wait(&pool_wake, &pool_lock);
+        }
+
+        if (pool_stop)
+        {
+            break;
+        }
+
+        seen = pool_generation;
+        pthread_mutex_unlock(&pool_lock);
+
+        // İşçide sayılan donanım olayları işi başlatan thread'in ölçümüne eklenir
+        PROFILE_TASK_BEGIN(pool_job.profile_owner);
+
+        if (pool_job.tasks)
+        {
+            parallel_task_loop(worker);
+        }
+        else
+        {
+            parallel_run_chunks(worker);
+        }
+
+        PROFILE_TASK_END();
+
+        pthread_mutex_lock(&pool_lock);
+
+        if (--pool_job.pending == 0)
+        {
+            pthread_cond_signal(&pool_done);
+        }
+    }
+
+    pthread_mutex_unlock(&pool_lock);
+
+    return NULL;
+}
+
+/**
+ * @brief Havuz thread'lerini durdurur. pool_submit tutulurken çağrılır.
+ */
+static void parallel_stop_pool(void)
+{
+    pthread_mutex_lock(&pool_lock);
+    pool_stop = true;
+    pthread_cond_broadcast(&pool_wake);
+    pthread_mutex_unlock(&pool_lock);
+
+    for (unsigned int i = 0; i < pool_count; i++)
+    {
+        pthread_join(pool_workers[i], NULL);
+    }
+
+    free(pool_workers);
+    free(pool_deques);
+    pool_workers = NULL;
+    pool_deques = NULL;
+    pool_count = 0;
+    pool_stop = false;
+}
+
+/**
+ * @brief Havuzu istenen boyutta başlatır. pool_submit tutulurken çağrılır.
+ */
+static void parallel_start_pool(unsigned int threads)
+{
+    if (pool_count + 1 == threads)
+    {
+        return;
+    }
+
+    if (pool_count > 0)
+    {
+        parallel_stop_pool();
+    }
+
+    pool_workers = (pthread_t *)malloc((threads - 1) * sizeof(pthread_t));
+    pool_deques = (parallel_deque *)calloc(threads, sizeof(parallel_deque));
+
+    if (pool_workers == NULL || pool_deques == NULL)
+    {
+        free(pool_workers);
+        free(pool_deques);
+        pool_workers = NULL;
+        pool_deques = NULL;
+        return;
+    }
+
+    for (unsigned int i = 0; i < threads; i++)
+    {
+        atomic_flag_clear(&pool_deques[i].lock);
+    }
+
+    for (unsigned int i = 0; i < threads - 1; i++)
+    {
+        if (pthread_create(&pool_workers[i], NULL, parallel_worker_main, (void *)(size_t)(i + 1)) != 0)
+        {
+            break;
+        }
+        pool_count++;
+    }
+}
+
+void parallel_set_threads(unsigned int threads)
+{
+    parallel_requested = threads;
+}
+
+unsigned int parallel_threads(void)
+{
+    return parallel_requested > 0 ? parallel_requested : parallel_default_threads();
+}
+
+/**
+ * @brief Görev oturumunda parallel_for aralığının bir parçası.
+ */
+typedef struct
+{
+    parallel_range_fn fn;
+    void *ctx;
+    unsigned long begin;
+    unsigned long end;
+    unsigned long grain;
+
+} parallel_split;
+
+static void parallel_split_run(void *arg)
+{
+    parallel_split *s = (parallel_split *)arg;
+
+    if (s->end - s->begin <= s->grain)
+    {
+        s->fn(s->ctx, s->begin, s->end, (unsigned int)parallel_task_worker);
+        return;
+    }
+
+    unsigned long mid = s->begin + (s->end - s->begin) / 2;
+    parallel_split left = {s->fn, s->ctx, s->begin, mid, s->grain};
+    parallel_split right = {s->fn, s->ctx, mid, s->end, s->grain};
+
+    parallel_join(parallel_split_run, &left, parallel_split_run, &right);
+}
+
+void parallel_for(unsigned long begin, unsigned long end, unsigned long grain,
+                  parallel_range_fn fn, void *ctx)
+{
+    if (end <= begin)
+    {
+        return;
+    }
+
+    if (grain == 0)
+    {
+        grain = 1;
+    }
+
+    // Bir görev oturumunda aralık ikiye bölünerek görevlere dağıtılır
+    if (parallel_task_worker >= 0)
+    {
+        parallel_split split = {fn, ctx, begin, end, grain};
+        parallel_split_run(&split);
+        return;
+    }
+
+    unsigned int threads = parallel_threads();
+
+    // İç içe çağrılar, tek parça işler ve havuz meşgulken seri çalışılır
+    if (parallel_inside || threads <= 1 || end - begin <= grain ||
+        pthread_mutex_trylock(&pool_submit) != 0)
+    {
+        fn(ctx, begin, end, 0);
+        return;
+    }
+
+    parallel_start_pool(threads);
+
+    if (pool_count == 0)
+    {
+        pthread_mutex_unlock(&pool_submit);
+        fn(ctx, begin, end, 0);
+        return;
+    }
+
+    pthread_mutex_lock(&pool_lock);
+
+    pool_job.tasks = false;
+    pool_job.fn = fn;
+    pool_job.ctx = ctx;
+    pool_job.end = end;
+    pool_job.grain = grain;
+    atomic_store(&pool_job.next, begin);
+    pool_job.pending = pool_count;
+    pool_job.profile_owner = PROFILE_HW_OWNER();
+
+    pool_generation++;
+    pthread_cond_broadcast(&pool_wake);
+
+    pthread_mutex_unlock(&pool_lock);
+
+    parallel_inside = true;
+    parallel_run_chunks(0);
+    parallel_inside = false;
+
+    pthread_mutex_lock(&pool_lock);
+
+    while (pool_job.pending > 0)
+    {
+        pthread_cond_wait(&pool_done, &pool_lock);
+    }
+
+    pthread_mutex_unlock(&pool_lock);
+    pthread_mutex_unlock(&pool_submit);
+}
+void parallel_run(parallel_task_fn fn, void *arg)
+{
+    // İç içe oturumlar mevcut oturumun görevleri olarak çalışır
+    if (parallel_task_worker >= 0)
+    {
+        fn(arg);
+        return;
+    }
+
+    unsigned int threads = parallel_threads();
+
+    // Bir parallel_for işçisi içinden, tek thread ile veya havuz meşgulken
+    // seri çalışılır; parallel_spawn görevleri hemen çalıştırır
+    if (parallel_inside || threads <= 1 || pthread_mutex_trylock(&pool_submit) != 0)
+    {
+        fn(arg);
+        return;
+    }
+
+    parallel_start_pool(threads);
+
+    if (pool_count == 0)
+    {
+        pthread_mutex_unlock(&pool_submit);
+        fn(arg);
+        return;
+    }
+
+    pthread_mutex_lock(&pool_lock);
+
+    pool_job.tasks = true;
+    atomic_store(&pool_job.tasks_done, false);
+    pool_job.pending = pool_count;
+    pool_job.profile_owner = PROFILE_HW_OWNER();
+
+    pool_generation++;
+    pthread_cond_broadcast(&pool_wake);
+
+    pthread_mutex_unlock(&pool_lock);
+
+    // Çağıran thread 0 numaralı işçidir
+    parallel_inside = true;
+    parallel_task_worker = 0;
+
+    fn(arg);
+
+    parallel_task_worker = -1;
+    parallel_inside = false;
+
+    atomic_store(&pool_job.tasks_done, true);
+
+    pthread_mutex_lock(&pool_lock);
+
+    while (pool_job.pending > 0)
+    {
+        pthread_cond_wait(&pool_done, &pool_lock);
+    }
+
+    pthread_mutex_unlock(&pool_lock);
+    pthread_mutex_unlock(&pool_submit);
+}
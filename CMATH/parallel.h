@@ -0,0 +1,119 @@
+#include <stdatomic.h>
+
+#include "cmath.h"
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+/**
+ * @brief parallel_for tarafından her parça için çağrılan fonksiyon.
+ *
+ * @param ctx parallel_for'a verilen bağlam
+ * @param begin Parçanın ilk indeksi
+ * @param end Parçanın son indeksinden bir sonrası
+ * @param worker Parçayı çalıştıran thread'in numarası, [0, parallel_threads())
+ *               aralığındadır; thread başına geçici bellek için kullanılabilir.
+ */
+typedef void (*parallel_range_fn)(void *ctx, unsigned long begin, unsigned long end, unsigned int worker);
+
+/**
+ * @brief Kütüphanenin kullanacağı thread sayısını belirler.
+ *
+ * 0 verilirse CMATRIX_THREADS ortam değişkeni, o da yoksa işlemci sayısı kullanılır.
+ * 1 verilirse tüm fonksiyonlar çağıran thread'de seri çalışır.
+ *
+ * @param threads
+ */
+void parallel_set_threads(unsigned int threads);
+
+/**
+ * @brief Kullanılan thread sayısı (çağıran thread dahil).
+ *
+ * @return unsigned int
+ */
+unsigned int parallel_threads(void);
+
+/**
+ * @brief [begin, end) aralığını en az grain büyüklüğünde parçalara bölüp paralel çalıştırır.
+ *
+ * Çağıran thread de parçaları çalıştırır ve tüm parçalar bitince döner.
+ * Başka bir parallel_for içinden çağrıldığında seri çalışır.
+ *
+ * @param begin
+ * @param end
+ * @param grain Bir parçadaki en az indeks sayısı (0 ise 1)
+ * @param fn
+ * @param ctx
+ */
+void parallel_for(unsigned long begin, unsigned long end, unsigned long grain,
+                  parallel_range_fn fn, void *ctx);
+
+/**
+ * @brief İş çalan zamanlayıcının çalıştırdığı görev.
+ */
+typedef void (*parallel_task_fn)(void *arg);
+
+/**
+ * @brief Birlikte beklenen görevler.
+ */
+typedef struct
+{
+    atomic_uint pending;
+
+} parallel_group;
+
+/**
+ * @brief Özyinelemeli algoritmalar için fork/join oturumu başlatır.
+ *
+ * fn çağıran thread'de çalışır. İçinden parallel_spawn ile açılan görevler
+ * işçi başına kuyruklara eklenir ve boşta kalan işçiler tarafından çalınır.
+ * Görevler de görev açabilir (iç içe paralellik). Oturum içindeki
+ * parallel_for çağrıları aralığı ikiye bölerek görevlere dağıtır.
+ *
+ * Bir oturum içinden çağrılırsa fn mevcut oturumun parçası olarak çalışır.
+ * Bir parallel_for işçisi içinden, tek thread ile veya havuz başka bir iş
+ * çalıştırırken çağrılırsa her şey çağıran thread'de seri çalışır.
+ *
+ * fn dönmeden önce açtığı tüm görevleri parallel_wait ile beklemelidir.
+ *
+ * @param fn
+ * @param arg
+ */
+void parallel_run(parallel_task_fn fn, void *arg);
+
+/**
+ * @brief Görev grubunu sıfırlar.
+ *
+ * @param group
+ */
+void parallel_group_init(parallel_group *group);
+
+/**
+ * @brief Görevi gruba ekler (fork). Oturum dışında görev hemen çalışır.
+ * arg, parallel_wait dönene kadar geçerli kalmalıdır.
+ *
+ * @param group
+ * @param fn
+ * @param arg
+ */
+void parallel_spawn(parallel_group *group, parallel_task_fn fn, void *arg);
+
+/**
+ * @brief Gruptaki tüm görevler bitene kadar bekler (join). Beklerken
+ * thread boş durmaz, kuyruklardaki diğer görevleri çalıştırır.
+ *
+ * @param group
+ */
+void parallel_wait(parallel_group *group);
+
+/**
+ * @brief fn_a ve fn_b'yi paralel çalıştırıp ikisini de bekler.
+ *
+ * @param fn_a
+ * @param arg_a
+ * @param fn_b
+ * @param arg_b
+ */
+void parallel_join(parallel_task_fn fn_a, void *arg_a, parallel_task_fn fn_b, void *arg_b);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,868 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#ifdef __linux__
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+
+#include "profile.h"
+
+/**
+ * @brief İç içe açılabilecek en fazla ölçüm noktası.
+ */
+#define PROFILE_MAX_DEPTH 32
+
+/**
+ * @brief Her thread kendi sayaçlarına kilitsiz yazar.
+ * Okuma sırasında tüm thread'lerin sayaçları toplanır.
+ *
+ * ops yalnızca sahibi tarafından, seq tek iken yazılır (seqlock); okuyucu
+ * seq değişmediyse kopyasını kabul eder, aksi halde yeniden dener.
+ * epoch profile_epoch'tan geri kalmışsa sayaçlar sıfırlanmış sayılır ve
+ * sahibi onları bir sonraki yazışında sıfırlar.
+ */
+typedef struct profile_slot
+{
+    profile_counter ops[PROFILE_OP_COUNT];
+    atomic_uint seq;
+    unsigned long epoch;
+
+    /* Açık ölçüm noktaları (tahsis baytlarını dağıtmak için) */
+    profile_op stack[PROFILE_MAX_DEPTH];
+    unsigned int depth;
+
+    /* Donanım sayaçları: thread'in kendi perf_event grubu (-1: açık değil)
+       ve grubun açıldığı kuşak; yalnızca sahibi açar, okur ve kapatır */
+    int hw_fd[PROFILE_HW_COUNT];
+    unsigned long hw_open_generation;
+
+    /* Bu thread'in başlattığı parallel işlerinde havuz işçilerinin saydıkları */
+    atomic_ullong hw_extra[PROFILE_HW_COUNT];
+
+    /* Açık ölçüm noktalarındaki başlangıç değerleri; kuşak 0 ise okunmadı */
+    unsigned long long hw_start[PROFILE_MAX_DEPTH][PROFILE_HW_COUNT];
+    unsigned long hw_generation[PROFILE_MAX_DEPTH];
+
+    struct profile_slot *next;
+
+} profile_slot;
+
+static volatile bool profile_is_enabled = false;
+
+static pthread_mutex_t profile_lock = PTHREAD_MUTEX_INITIALIZER;
+static profile_slot *profile_slots = NULL;
+
+static _Thread_local profile_slot *profile_local = NULL;
+
+/* Sonlanan thread'lerin slotları silinir; sayaçları burada birikir (profile_lock altında) */
+static pthread_key_t profile_key;
+static pthread_once_t profile_key_once = PTHREAD_ONCE_INIT;
+static profile_counter profile_retired[PROFILE_OP_COUNT];
+static unsigned long profile_retired_epoch = 1;
+
+/* profile_reset her çağrıldığında artar */
+static atomic_ulong profile_epoch = 1;
+
+/* Sayaçlar her açılıp kapandığında artar; her thread kendi grubunu buna göre yeniden açar */
+static volatile bool profile_hw_is_enabled = false;
+static atomic_ulong profile_hw_generation = 1;
+
+static const char *const profile_hw_names[PROFILE_HW_COUNT] = {
+    "cycles",
+    "instructions",
+    "l1d_misses",
+    "llc_misses",
+    "branch_misses",
+};
+
+static const char *const profile_names[PROFILE_OP_COUNT] = {
+    "allocation",
+    "vector_construct",
+    "vector_scalar",
+    "vector_norm",
+    "vector_dot",
+    "vector_cross",
+    "vector_add",
+    "vector_substract",
+    "vector_divide",
+    "vector_power",
+    "vector_normalize",
+    "vector_distance",
+    "matrix_create",
+    "matrix_copy",
+    "matrix_free",
+    "matrix_sum",
+    "matrix_substract",
+    "matrix_divide",
+    "matrix_scalar",
+    "matrix_multiplication",
+    "matrix_transpose",
+    "matrix_power",
+    "matrix_pairwise",
+    "matrix_knn",
+    "matrix_reduce",
+    "matrix_normalize",
+    "matrix_map",
+    "vector_map",
+    "matrix_graph",
+    "matrix_chain",
+    "matrix_file_multiplication",
+    "packed_matvec",
+    "packed_multiplication",
+    "packed_solve",
+    "matrix_implicit",
+    "matrix_batch",
+    "quant_matvec",
+    "quant_multiplication",
+    "half_matvec",
+    "half_multiplication",
+    "matrix_gram",
+    "matrix_expm",
+    "matrix_polynomial",
+    "matrix_solve",
+    "mod_multiplication",
+    "mod_power",
+    "matrix_kron",
+    "matrix_block",
+    "kron_matvec",
+};
+
+/**
+ * @brief Monoton saat (ns)
+ */
+static unsigned long long profile_now(void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER now;
+
+    if (freq.QuadPart == 0)
+    {
+        QueryPerformanceFrequency(&freq);
+    }
+    QueryPerformanceCounter(&now);
+
+    return (unsigned long long)((double)now.QuadPart * 1e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (unsigned long long)ts.tv_sec * 1000000000ull + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+#ifdef __linux__
+
+/**
+ * @brief Çağıran thread için sayaç grubunu açar; lider döngü sayacıdır ve
+ * grup tek read() ile okunur. Desteklenmeyen olaylar atlanır.
+ */
+static void profile_hw_open(profile_slot *slot)
+{
+    static const struct
+    {
+        uint32_t type;
+        uint64_t config;
+
+    } events[PROFILE_HW_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+
+    int leader = -1;
+
+    for (int e = 0; e < PROFILE_HW_COUNT; e++)
+    {
+        struct perf_event_attr attr;
+
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = events[e].type;
+        attr.config = events[e].config;
+        attr.disabled = leader == -1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0UL);
+
+        if (e == PROFILE_HW_CYCLES)
+        {
+            if (fd < 0)
+            {
+                return;
+            }
+
+            leader = fd;
+        }
+
+        slot->hw_fd[e] = fd < 0 ? -1 : fd;
+    }
+
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+static void profile_hw_close(profile_slot *slot)
+{
+    for (int e = 0; e < PROFILE_HW_COUNT; e++)
+    {
+        if (slot->hw_fd[e] >= 0)
+        {
+            close(slot->hw_fd[e]);
+        }
+
+        slot->hw_fd[e] = -1;
+    }
+}
+
+/**
+ * @brief Çağıran thread'in kendi grubunu kilitsiz okur ve o anki kuşağı döndürür.
+ * Kuşak değiştiyse grup önce kapatılıp gerekiyorsa yeniden açılır. Grup
+ * çoklama nedeniyle sürenin yalnızca bir kısmında sayıldıysa değerler
+ * time_enabled / time_running oranıyla ölçeklenir.
+ */
+static unsigned long profile_hw_read(profile_slot *slot, unsigned long long out[PROFILE_HW_COUNT])
+{
+    unsigned long generation = atomic_load(&profile_hw_generation);
+
+    memset(out, 0, PROFILE_HW_COUNT * sizeof(unsigned long long));
+
+    if (slot->hw_open_generation != generation)
+    {
+        profile_hw_close(slot);
+
+        if (profile_hw_is_enabled)
+        {
+            profile_hw_open(slot);
+        }
+
+        slot->hw_open_generation = generation;
+    }
+
+    // nr, time_enabled, time_running ve liderden başlayarak açılış sırasıyla değerler
+    uint64_t buf[3 + PROFILE_HW_COUNT];
+
+    if (slot->hw_fd[PROFILE_HW_CYCLES] < 0 ||
+        read(slot->hw_fd[PROFILE_HW_CYCLES], buf, sizeof(buf)) < (ssize_t)(3 * sizeof(uint64_t)))
+    {
+        return generation;
+    }
+
+    double scale = buf[2] > 0 && buf[2] < buf[1] ? (double)buf[1] / (double)buf[2] : 1.0;
+    uint64_t k = 0;
+
+    for (int e = 0; e < PROFILE_HW_COUNT && k < buf[0]; e++)
+    {
+        if (slot->hw_fd[e] >= 0)
+        {
+            out[e] = (unsigned long long)((double)buf[3 + k++] * scale);
+        }
+    }
+
+    return generation;
+}
+
+#endif
+
+/**
+ * @brief Thread'in kendi sayaçları ile başlattığı işlerde işçilerin eklediklerinin toplamı.
+ */
+static unsigned long profile_hw_sample(profile_slot *slot, unsigned long long sum[PROFILE_HW_COUNT])
+{
+#ifdef __linux__
+    unsigned long generation = profile_hw_read(slot, sum);
+#else
+    unsigned long generation = 0;
+
+    memset(sum, 0, PROFILE_HW_COUNT * sizeof(unsigned long long));
+#endif
+
+    for (int e = 0; e < PROFILE_HW_COUNT; e++)
+    {
+        sum[e] += atomic_load_explicit(&slot->hw_extra[e], memory_order_relaxed);
+    }
+
+    return generation;
+}
+
+static void profile_merge(profile_counter *dst, const profile_counter *src)
+{
+    if (src->calls == 0)
+    {
+        dst->bytes_allocated += src->bytes_allocated;
+        return;
+    }
+
+    if (dst->calls == 0 || src->min_ns < dst->min_ns)
+    {
+        dst->min_ns = src->min_ns;
+    }
+    if (src->max_ns > dst->max_ns)
+    {
+        dst->max_ns = src->max_ns;
+    }
+
+    dst->calls += src->calls;
+    dst->total_ns += src->total_ns;
+    dst->flops += src->flops;
+    dst->bytes_allocated += src->bytes_allocated;
+    dst->bytes_moved += src->bytes_moved;
+
+    for (int e = 0; e < PROFILE_HW_COUNT; e++)
+    {
+        dst->hw[e] += src->hw[e];
+    }
+}
+
+/**
+ * @brief Sahibin ops yazımını açar; sıfırlama istenmişse önce sayaçları sıfırlar.
+ */
+static void profile_write_begin(profile_slot *slot)
+{
+    unsigned int seq = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+
+    atomic_store_explicit(&slot->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    unsigned long epoch = atomic_load_explicit(&profile_epoch, memory_order_relaxed);
+
+    if (slot->epoch != epoch)
+    {
+        memset(slot->ops, 0, sizeof(slot->ops));
+        slot->epoch = epoch;
+    }
+}
+
+static void profile_write_end(profile_slot *slot)
+{
+    unsigned int seq = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+
+    atomic_store_explicit(&slot->seq, seq + 1, memory_order_release);
+}
+
+/**
+ * @brief Thread sonlanırken sayaç grubunu kapatır, sayaçlarını profile_retired'a
+ * ekler ve slotu listeden çıkarıp siler.
+ */
+static void profile_thread_exit(void *arg)
+{
+    profile_slot *slot = (profile_slot *)arg;
+
+#ifdef __linux__
+    profile_hw_close(slot);
+#endif
+
+    pthread_mutex_lock(&profile_lock);
+
+    unsigned long epoch = atomic_load(&profile_epoch);
+
+    if (profile_retired_epoch != epoch)
+    {
+        memset(profile_retired, 0, sizeof(profile_retired));
+        profile_retired_epoch = epoch;
+    }
+
+    if (slot->epoch == epoch)
+    {
+        for (int op = 0; op < PROFILE_OP_COUNT; op++)
+        {
+            profile_merge(&profile_retired[op], &slot->ops[op]);
+        }
+    }
+
+    for (profile_slot **link = &profile_slots; *link != NULL; link = &(*link)->next)
+    {
+        if (*link == slot)
+        {
+            *link = slot->next;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&profile_lock);
+
+    profile_local = NULL;
+    free(slot);
+}
+
+static void profile_key_create(void)
+{
+    pthread_key_create(&profile_key, profile_thread_exit);
+}
+
+/**
+ * @brief Çağıran thread'in sayaç alanı. İlk kullanımda oluşturulup listeye eklenir;
+ * thread sonlanınca profile_thread_exit ile silinir.
+ */
+static profile_slot *profile_get_slot(void)
+{
+    if (profile_local != NULL)
+    {
+        return profile_local;
+    }
+
+    profile_slot *slot = (profile_slot *)calloc(1, sizeof(profile_slot));
+
+    if (slot == NULL)
+    {
+        return NULL;
+    }
+
+    for (int e = 0; e < PROFILE_HW_COUNT; e++)
+    {
+        slot->hw_fd[e] = -1;
+    }
+
+    slot->epoch = atomic_load(&profile_epoch);
+
+    pthread_mutex_lock(&profile_lock);
+    slot->next = profile_slots;
+    profile_slots = slot;
+    pthread_mutex_unlock(&profile_lock);
+
+    pthread_once(&profile_key_once, profile_key_create);
+    pthread_setspecific(profile_key, slot);
+
+    profile_local = slot;
+
+    return slot;
+}
+
+void profile_enable(bool enable)
+{
+    profile_is_enabled = enable;
+}
+
+bool profile_enabled(void)
+{
+    return profile_is_enabled;
+}
+
+bool profile_enable_hardware(bool enable)
+{
+#ifdef __linux__
+    profile_slot *self = profile_get_slot();
+    unsigned long long probe[PROFILE_HW_COUNT];
+    bool ok = false;
+
+    // Diğer thread'ler gruplarını kuşak değişikliğini gördükleri ilk okumada kendileri açar/kapatır
+    pthread_mutex_lock(&profile_lock);
+
+    profile_hw_is_enabled = enable;
+    atomic_fetch_add(&profile_hw_generation, 1);
+
+    if (enable && self != NULL)
+    {
+        profile_hw_read(self, probe);
+        ok = self->hw_fd[PROFILE_HW_CYCLES] >= 0;
+    }
+
+    // Çağıran thread ölçülemiyorsa hiçbir thread ölçülmez
+    if (enable && !ok)
+    {
+        profile_hw_is_enabled = false;
+        atomic_fetch_add(&profile_hw_generation, 1);
+
+        if (self != NULL)
+        {
+            profile_hw_read(self, probe);
+        }
+    }
+
+    pthread_mutex_unlock(&profile_lock);
+
+    return ok;
+#else
+    (void)enable;
+    return false;
+#endif
+}
+
+bool profile_hardware_enabled(void)
+{
+    return profile_hw_is_enabled;
+}
+
+const char *profile_hw_name(profile_hw_event event)
+{
+    if (event < 0 || event >= PROFILE_HW_COUNT)
+    {
+        return "unknown";
+    }
+
+    return profile_hw_names[event];
+}
+
+void *profile_hw_owner(void)
+{
+    return profile_is_enabled && profile_hw_is_enabled ? (void *)profile_local : NULL;
+}
+
+profile_hw_task profile_hw_task_begin(void *owner)
+{
+    profile_hw_task task;
+
+    memset(&task, 0, sizeof(task));
+
+#ifdef __linux__
+    if (owner == NULL || !profile_hw_is_enabled)
+    {
+        return task;
+    }
+
+    profile_slot *slot = profile_get_slot();
+
+    // Sahibin kendi thread'inde yapılan iş zaten kendi grubunda sayılır
+    if (slot == NULL || slot == owner)
+    {
+        return task;
+    }
+
+    task.owner = owner;
+    task.generation = profile_hw_read(slot, task.start);
+#else
+    (void)owner;
+#endif
+
+    return task;
+}
+
+void profile_hw_task_end(profile_hw_task *task)
+{
+#ifdef __linux__
+    unsigned long long now[PROFILE_HW_COUNT];
+    profile_slot *owner = (profile_slot *)task->owner;
+
+    if (owner == NULL || profile_hw_read(profile_local, now) != task->generation)
+    {
+        return;
+    }
+
+    // Sahip işin bitmesini beklediğinden slotu bu sırada silinmez
+    for (int e = 0; e < PROFILE_HW_COUNT; e++)
+    {
+        atomic_fetch_add_explicit(&owner->hw_extra[e], now[e] - task->start[e], memory_order_relaxed);
+    }
+#else
+    (void)task;
+#endif
+}
+
+void profile_reset(void)
+{
+    // Sayaçlar yazan thread'lerle yarışmamak için burada silinmez
+    atomic_fetch_add(&profile_epoch, 1);
+}
+
+/**
+ * @brief Slotun tutarlı bir kopyası; sıfırlanmış sayılıyorsa false.
+ */
+static bool profile_read_slot(profile_slot *slot, profile_counter ops[PROFILE_OP_COUNT])
+{
+    for (;;)
+    {
+        unsigned int before = atomic_load_explicit(&slot->seq, memory_order_acquire);
+
+        if (before & 1)
+        {
+            sched_yield();
+            continue;
+        }
+
+        memcpy(ops, (const void *)slot->ops, sizeof(slot->ops));
+        unsigned long epoch = slot->epoch;
+
+        atomic_thread_fence(memory_order_acquire);
+
+        if (atomic_load_explicit(&slot->seq, memory_order_relaxed) == before)
+        {
+            return epoch == atomic_load(&profile_epoch);
+        }
+    }
+}
+
+void profile_take_snapshot(profile_snapshot *snap)
+{
+    profile_counter ops[PROFILE_OP_COUNT];
+
+    memset(snap, 0, sizeof(profile_snapshot));
+
+    pthread_mutex_lock(&profile_lock);
+
+    if (profile_retired_epoch == atomic_load(&profile_epoch))
+    {
+        for (int op = 0; op < PROFILE_OP_COUNT; op++)
+        {
+            profile_merge(&snap->ops[op], &profile_retired[op]);
+        }
+    }
+
+    for (profile_slot *slot = profile_slots; slot != NULL; slot = slot->next)
+    {
+        if (!profile_read_slot(slot, ops))
+        {
+            continue;
+        }
+
+        for (int op = 0; op < PROFILE_OP_COUNT; op++)
+        {
+            profile_merge(&snap->ops[op], &ops[op]);
+        }
+    }
+
+    pthread_mutex_unlock(&profile_lock);
+}
+
+const char *profile_op_name(profile_op op)
+{
+    if (op < 0 || op >= PROFILE_OP_COUNT)
+    {
+        return "unknown";
+    }
+
+    return profile_names[op];
+}
+
+void profile_dump_text(const profile_snapshot *snap, FILE *out)
+{
+    profile_snapshot local;
+
+    if (snap == NULL)
+    {
+        profile_take_snapshot(&local);
+        snap = &local;
+    }
+
+    fprintf(out, "%-24s %10s %12s %10s %10s %10s %10s %14s %14s\n",
+            "operation", "calls", "total(ms)", "avg(us)", "min(us)", "max(us)",
+            "GFLOP/s", "alloc(B)", "moved(B)");
+
+    for (int op = 0; op < PROFILE_OP_COUNT; op++)
+    {
+        const profile_counter *c = &snap->ops[op];
+
+        if (c->calls == 0 && c->bytes_allocated == 0)
+        {
+            continue;
+        }
+
+        double gflops = c->total_ns > 0 ? (double)c->flops / (double)c->total_ns : 0.0;
+        double avg_us = c->calls > 0 ? (double)c->total_ns / (double)c->calls / 1e3 : 0.0;
+
+        fprintf(out, "%-24s %10llu %12.3f %10.3f %10.3f %10.3f %10.3f %14llu %14llu\n",
+                profile_names[op], c->calls, (double)c->total_ns / 1e6, avg_us,
+                (double)c->min_ns / 1e3, (double)c->max_ns / 1e3, gflops,
+                c->bytes_allocated, c->bytes_moved);
+    }
+
+    bool hardware = false;
+
+    for (int op = 0; op < PROFILE_OP_COUNT; op++)
+    {
+        hardware = hardware || snap->ops[op].hw[PROFILE_HW_CYCLES] > 0;
+    }
+
+    if (!hardware)
+    {
+        return;
+    }
+
+    // IPC düşük ve ıskalar/flop yüksekse çekirdek bellek sınırlıdır
+    fprintf(out, "\n%-24s %14s %14s %8s %10s %12s %12s %14s\n",
+            "operation", "cycles", "instructions", "IPC", "flop/cycle",
+            "L1D miss/fl", "LLC miss/fl", "branch miss");
+
+    for (int op = 0; op < PROFILE_OP_COUNT; op++)
+    {
+        const profile_counter *c = &snap->ops[op];
+        const unsigned long long *hw = c->hw;
+
+        if (hw[PROFILE_HW_CYCLES] == 0)
+        {
+            continue;
+        }
+
+        double cycles = (double)hw[PROFILE_HW_CYCLES];
+        double flops = c->flops > 0 ? (double)c->flops : 1.0;
+
+        fprintf(out, "%-24s %14llu %14llu %8.3f %10.3f %12.4f %12.4f %14llu\n",
+                profile_names[op], hw[PROFILE_HW_CYCLES], hw[PROFILE_HW_INSTRUCTIONS],
+                (double)hw[PROFILE_HW_INSTRUCTIONS] / cycles, (double)c->flops / cycles,
+                c->flops > 0 ? (double)hw[PROFILE_HW_L1D_MISSES] / flops : 0.0,
+                c->flops > 0 ? (double)hw[PROFILE_HW_LLC_MISSES] / flops : 0.0,
+                hw[PROFILE_HW_BRANCH_MISSES]);
+    }
+}
+
+void profile_dump_json(const profile_snapshot *snap, FILE *out)
+{
+    profile_snapshot local;
+    bool first = true;
+
+    if (snap == NULL)
+    {
+        profile_take_snapshot(&local);
+        snap = &local;
+    }
+
+    fprintf(out, "{\"operations\":[");
+
+    for (int op = 0; op < PROFILE_OP_COUNT; op++)
+    {
+        const profile_counter *c = &snap->ops[op];
+
+        if (c->calls == 0 && c->bytes_allocated == 0)
+        {
+            continue;
+        }
+
+        fprintf(out, "%s{\"name\":\"%s\",\"calls\":%llu,\"total_ns\":%llu,\"min_ns\":%llu,"
+                     "\"max_ns\":%llu,\"flops\":%llu,\"bytes_allocated\":%llu,\"bytes_moved\":%llu",
+                first ? "" : ",", profile_names[op], c->calls, c->total_ns, c->min_ns,
+                c->max_ns, c->flops, c->bytes_allocated, c->bytes_moved);
+
+        if (c->hw[PROFILE_HW_CYCLES] > 0)
+        {
+            for (int e = 0; e < PROFILE_HW_COUNT; e++)
+            {
+                fprintf(out, ",\"%s\":%llu", profile_hw_names[e], c->hw[e]);
+            }
+        }
+
+        fprintf(out, "}");
+
+        first = false;
+    }
+
+    fprintf(out, "]}\n");
+}
+
+unsigned long long profile_begin(profile_op op)
+{
+    if (!profile_is_enabled)
+    {
+        return 0;
+    }
+
+    profile_slot *slot = profile_get_slot();
+
+    if (slot == NULL)
+    {
+        return 0;
+    }
+
+    if (slot->depth < PROFILE_MAX_DEPTH)
+    {
+        slot->stack[slot->depth] = op;
+        slot->hw_generation[slot->depth] = 0;
+
+        if (profile_hw_is_enabled)
+        {
+            slot->hw_generation[slot->depth] = profile_hw_sample(slot, slot->hw_start[slot->depth]);
+        }
+    }
+    slot->depth++;
+
+    unsigned long long now = profile_now();
+
+    /* 0 değeri "ölçülmüyor" anlamına gelir */
+    return now == 0 ? 1 : now;
+}
+
+void profile_end(profile_op op, unsigned long long start,
+                 unsigned long long flops, unsigned long long bytes_moved)
+{
+    if (start == 0)
+    {
+        return;
+    }
+
+    unsigned long long elapsed = profile_now() - start;
+    profile_slot *slot = profile_local;
+
+    if (slot == NULL)
+    {
+        return;
+    }
+
+    if (slot->depth > 0)
+    {
+        slot->depth--;
+    }
+
+    unsigned long long now_hw[PROFILE_HW_COUNT] = {0};
+
+    // Sayaçlar arada kapatılıp açıldıysa (kuşak değişti) fark anlamsızdır
+    if (slot->depth < PROFILE_MAX_DEPTH && slot->hw_generation[slot->depth] != 0)
+    {
+        unsigned long generation = profile_hw_sample(slot, now_hw);
+
+        for (int e = 0; e < PROFILE_HW_COUNT; e++)
+        {
+            now_hw[e] = generation == slot->hw_generation[slot->depth] ? now_hw[e] - slot->hw_start[slot->depth][e] : 0;
+        }
+    }
+
+    profile_write_begin(slot);
+
+    profile_counter *c = &slot->ops[op];
+
+    for (int e = 0; e < PROFILE_HW_COUNT; e++)
+    {
+        c->hw[e] += now_hw[e];
+    }
+
+    if (c->calls == 0 || elapsed < c->min_ns)
+    {
+        c->min_ns = elapsed;
+    }
+    if (elapsed > c->max_ns)
+    {
+        c->max_ns = elapsed;
+    }
+
+    c->calls++;
+    c->total_ns += elapsed;
+    c->flops += flops;
+    c->bytes_moved += bytes_moved;
+
+    profile_write_end(slot);
+}
+
+void profile_add_allocation(unsigned long long bytes)
+{
+    profile_slot *slot = profile_local;
+
+    if (!profile_is_enabled || slot == NULL)
+    {
+        return;
+    }
+
+    unsigned int depth = slot->depth < PROFILE_MAX_DEPTH ? slot->depth : PROFILE_MAX_DEPTH;
+
+    profile_write_begin(slot);
+
+    for (unsigned int i = 0; i < depth; i++)
+    {
+        slot->ops[slot->stack[i]].bytes_allocated += bytes;
+    }
+
+    profile_write_end(slot);
+}
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include <stdio.h>
+
+#include "cmath.h"
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+/**
+ * @brief Ölçülen işlem türleri.
+ *
+ * Her bir işlem için ayrı sayaç tutulur. Süreler kapsayıcıdır;
+ * __multiplication_matrix içinde yapılan transpoze ve bellek tahsisi
+ * hem kendi satırında hem de çarpma satırında görünür.
+ */
+typedef enum
+{
+    PROFILE_ALLOCATION,
+
+    PROFILE_VECTOR_CONSTRUCT,
+    PROFILE_VECTOR_SCALAR,
+    PROFILE_VECTOR_NORM,
+    PROFILE_VECTOR_DOT,
+    PROFILE_VECTOR_CROSS,
+    PROFILE_VECTOR_ADD,
+    PROFILE_VECTOR_SUBSTRACT,
+    PROFILE_VECTOR_DIVIDE,
+    PROFILE_VECTOR_POWER,
+    PROFILE_VECTOR_NORMALIZE,
+    PROFILE_VECTOR_DISTANCE,
+
+    PROFILE_MATRIX_CREATE,
+    PROFILE_MATRIX_COPY,
+    PROFILE_MATRIX_FREE,
+    PROFILE_MATRIX_SUM,
+    PROFILE_MATRIX_SUBSTRACT,
+    PROFILE_MATRIX_DIVIDE,
+    PROFILE_MATRIX_SCALAR,
+    PROFILE_MATRIX_MULTIPLICATION,
+    PROFILE_MATRIX_TRANSPOSE,
+    PROFILE_MATRIX_POWER,
+    PROFILE_MATRIX_PAIRWISE,
+    PROFILE_MATRIX_KNN,
+    PROFILE_MATRIX_REDUCE,
+    PROFILE_MATRIX_NORMALIZE,
+    PROFILE_MATRIX_MAP,
+    PROFILE_VECTOR_MAP,
+    PROFILE_MATRIX_GRAPH,
+    PROFILE_MATRIX_CHAIN,
+    PROFILE_MATRIX_FILE_MULTIPLICATION,
+    PROFILE_PACKED_MATVEC,
+    PROFILE_PACKED_MULTIPLICATION,
+    PROFILE_PACKED_SOLVE,
+    PROFILE_MATRIX_IMPLICIT,
+    PROFILE_MATRIX_BATCH,
+    PROFILE_QUANT_MATVEC,
+    PROFILE_QUANT_MULTIPLICATION,
+    PROFILE_HALF_MATVEC,
+    PROFILE_HALF_MULTIPLICATION,
+    PROFILE_MATRIX_GRAM,
+    PROFILE_MATRIX_EXPM,
+    PROFILE_MATRIX_POLYNOMIAL,
+    PROFILE_MATRIX_SOLVE,
+    PROFILE_MOD_MULTIPLICATION,
+    PROFILE_MOD_POWER,
+    PROFILE_MATRIX_KRON,
+    PROFILE_MATRIX_BLOCK,
+    PROFILE_KRON_MATVEC,
+
+    PROFILE_OP_COUNT
+
+} profile_op;
+
+/**
+ * @brief Donanım sayaçları (Linux perf_event_open).
+ *
+ * PROFILE_HW_CYCLES        : çekirdek saat döngüleri
+ * PROFILE_HW_INSTRUCTIONS  : tamamlanan komutlar
+ * PROFILE_HW_L1D_MISSES    : L1 veri önbelleği okuma ıskaları
+ * PROFILE_HW_LLC_MISSES    : son seviye önbellek ıskaları
+ * PROFILE_HW_BRANCH_MISSES : yanlış tahmin edilen dallanmalar
+ */
+typedef enum
+{
+    PROFILE_HW_CYCLES,
+    PROFILE_HW_INSTRUCTIONS,
+    PROFILE_HW_L1D_MISSES,
+    PROFILE_HW_LLC_MISSES,
+    PROFILE_HW_BRANCH_MISSES,
+
+    PROFILE_HW_COUNT
+
+} profile_hw_event;
+
+/**
+ * @brief Bir işlem türü için biriken sayaçlar.
+ *
+ * min_ns ve max_ns yalnızca calls > 0 ise anlamlıdır.
+ */
+typedef struct
+{
+    unsigned long long calls;
+    unsigned long long total_ns;
+    unsigned long long min_ns;
+    unsigned long long max_ns;
+
+    /* Kayan noktalı işlem sayısı */
+    unsigned long long flops;
+
+    /* İşlem süresince tahsis edilen ve okunup yazılan bayt miktarı */
+    unsigned long long bytes_allocated;
+    unsigned long long bytes_moved;
+
+    /* Donanım sayaçları; profile_enable_hardware kapalıysa veya desteklenmiyorsa 0 */
+    unsigned long long hw[PROFILE_HW_COUNT];
+
+} profile_counter;
+
+/**
+ * @brief Tüm thread'lerin sayaçlarının birleştirilmiş hali.
+ *
+ */
+typedef struct
+{
+    profile_counter ops[PROFILE_OP_COUNT];
+
+} profile_snapshot;
+
+/**
+ * @brief Ölçümü çalışma zamanında açar veya kapatır.
+ *
+ * Kütüphane CMATRIX_PROFILE tanımı ile derlenmediyse ölçüm
+ * noktaları hiç derlenmez ve bu fonksiyonun etkisi olmaz.
+ *
+ * @param enable
+ */
+void profile_enable(bool enable);
+
+/**
+ * @brief Ölçümün açık olup olmadığını döndürür.
+ *
+ * @return bool
+ */
+bool profile_enabled(void);
+
+/**
+ * @brief Ölçüm noktalarında donanım sayaçlarını da okur (yalnızca Linux).
+ *
+ * Her thread ilk ölçüm noktasında kendi perf_event grubunu açar ve yalnızca
+ * onu kilitsiz okur; ölçüm noktası başına bir read() eklenir. parallel_for ve
+ * parallel_run ile havuz işçilerine dağıtılan işlerin sayaçları işi başlatan
+ * thread'in ölçümüne eklenir, böylece farklı thread'lerin aynı anda çağırdığı
+ * işlemler birbirine karışmaz. Olaylar çoklandıysa (ör. sayaç sayısından
+ * fazla olay) değerler sayılan sürenin oranıyla ölçeklenmiş tahminlerdir.
+ * Kapatıldığında her thread grubunu bir sonraki ölçüm noktasında veya
+ * sonlanırken kapatır.
+ *
+ * Çekirdek, /proc/sys/kernel/perf_event_paranoid veya sanal makine
+ * sayaçlara izin vermiyorsa false döner ve sayaçlar 0 kalır. Desteklenmeyen
+ * tek tek olaylar (ör. sanal makinede LLC) 0 olarak görünür.
+ *
+ * @param enable
+ * @return bool En az döngü sayacı açılabildiyse true
+ */
+bool profile_enable_hardware(bool enable);
+
+bool profile_hardware_enabled(void);
+
+const char *profile_hw_name(profile_hw_event event);
+
+/**
+ * @brief Havuz işçisinin bir işte saydığı donanım olaylarını işi başlatan
+ * thread'e (sahip) aktarmak için.
+ *
+ * İşi başlatan thread sahibi PROFILE_HW_OWNER ile alır; işçi işi
+ * PROFILE_TASK_BEGIN / PROFILE_TASK_END arasında çalıştırır ve kendi
+ * grubundaki farkı sahibin sayaçlarına ekler. Sahip iş bitene kadar
+ * beklemelidir.
+ */
+typedef struct
+{
+    void *owner;
+    unsigned long generation;
+    unsigned long long start[PROFILE_HW_COUNT];
+
+} profile_hw_task;
+
+/**
+ * @brief Çağıran thread'in sahip değeri; donanım sayaçları kapalıysa NULL.
+ */
+void *profile_hw_owner(void);
+
+profile_hw_task profile_hw_task_begin(void *owner);
+void profile_hw_task_end(profile_hw_task *task);
+
+/**
+ * @brief Tüm thread'lerin (sonlanmış olanlar dahil) sayaçlarını sıfırlar.
+ *
+ * Ölçüm sürerken de çağrılabilir: sayaçlar yalnızca sıfırlanmış sayılır,
+ * her thread kendi sayaçlarını bir sonraki yazışında siler.
+ */
+void profile_reset(void);
+
+/**
+ * @brief Thread'lere ait sayaçları okuyup tek bir anlık görüntüde birleştirir.
+ *
+ * Ölçüm sürerken de çağrılabilir; her thread'in sayaçları yarım kalmış bir
+ * güncelleme içermeyen tutarlı bir kopyadan okunur.
+ *
+ * @param snap Sonucun yazılacağı yapı
+ */
+void profile_take_snapshot(profile_snapshot *snap);
+
+/**
+ * @brief İşlem türünün okunabilir adı.
+ *
+ * @param op
+ * @return const char*
+ */
+const char *profile_op_name(profile_op op);
+
+/**
+ * @brief Anlık görüntüyü tablo olarak yazdırır.
+ *
+ * @param snap NULL ise o anki değerler okunur
+ * @param out
+ */
+void profile_dump_text(const profile_snapshot *snap, FILE *out);
+
+/**
+ * @brief Anlık görüntüyü JSON olarak yazdırır.
+ *
+ * @param snap NULL ise o anki değerler okunur
+ * @param out
+ */
+void profile_dump_json(const profile_snapshot *snap, FILE *out);
+
+/**
+ * @brief Ölçüm noktasının başlangıcı. Ölçüm kapalıysa 0 döner.
+ *
+ * @param op
+ * @return unsigned long long Başlangıç zamanı (ns)
+ */
+unsigned long long profile_begin(profile_op op);
+
+/**
+ * @brief Ölçüm noktasının sonu.
+ *
+ * @param op
+ * @param start profile_begin dönüş değeri
+ * @param flops
+ * @param bytes_moved
+ */
+void profile_end(profile_op op, unsigned long long start,
+                 unsigned long long flops, unsigned long long bytes_moved);
+
+/**
+ * @brief Tahsis edilen baytları o anda açık olan tüm ölçüm noktalarına ekler.
+ *
+ * @param bytes
+ */
+void profile_add_allocation(unsigned long long bytes);
+
+/**
+ * Kütüphane içindeki ölçüm noktaları.
+ *
+ * CMATRIX_PROFILE tanımlı değilse tamamen boş makrolardır.
+ * PROFILE_BEGIN ile açılan her nokta, fonksiyonun her dönüş yolunda
+ * PROFILE_END ile kapatılmalıdır.
+ */
+#ifdef CMATRIX_PROFILE
+#define PROFILE_BEGIN(op) unsigned long long __profile_start_##op = profile_begin(op)
+#define PROFILE_END(op, flops, moved) \
+    profile_end(op, __profile_start_##op, (unsigned long long)(flops), (unsigned long long)(moved))
+#define PROFILE_ALLOC(bytes) profile_add_allocation((unsigned long long)(bytes))
+#define PROFILE_HW_OWNER() profile_hw_owner()
+#define PROFILE_TASK_BEGIN(owner) profile_hw_task __profile_task = profile_hw_task_begin(owner)
+#define PROFILE_TASK_END() profile_hw_task_end(&__profile_task)
+#else
+#define PROFILE_BEGIN(op) ((void)0)
+#define PROFILE_END(op, flops, moved) ((void)0)
+#define PROFILE_ALLOC(bytes) ((void)0)
+#define PROFILE_HW_OWNER() NULL
+#define PROFILE_TASK_BEGIN(owner) ((void)0)
+#define PROFILE_TASK_END() ((void)0)
+#endif
+
+#endif
\ No newline at end of file
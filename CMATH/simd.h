@@ -0,0 +1,305 @@
+#if defined(__AVX512F__) || defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "cmath.h"
+
+#ifndef SIMD_H
+#define SIMD_H
+
+/**
+ * Derleyicinin hedeflediği en geniş vektör birimi için temel işlemler.
+ *
+ * SIMD_WIDTH bir yazmacın tuttuğu float sayısıdır. Hedefte SIMD yoksa 1'dir
+ * ve aşağıdaki yardımcı fonksiyonlar düz döngü olarak derlenir.
+ *
+ * simd_lt_mask(a, b) : a < b olan şeritlerin bit maskesi (bit i = şerit i).
+ * simd_eq_mask(a, b) : a == b olan şeritlerin bit maskesi.
+ * simd_hmin / simd_hmax : yazmaçtaki en küçük / en büyük değer.
+ * simd_select_nz(c, a, b) : c != 0 olan şeritlerde a, diğerlerinde b.
+ * simd_select_lt(a, b, x, y) : a < b olan şeritlerde x, diğerlerinde y.
+ */
+#if defined(__AVX512F__)
+
+#define SIMD_WIDTH 16
+typedef __m512 simd_f;
+#define simd_load(p) _mm512_load_ps(p)
+#define simd_loadu(p) _mm512_loadu_ps(p)
+#define simd_store(p, v) _mm512_store_ps((p), (v))
+#define simd_storeu(p, v) _mm512_storeu_ps((p), (v))
+#define simd_set1(x) _mm512_set1_ps(x)
+#define simd_zero() _mm512_setzero_ps()
+#define simd_addv(a, b) _mm512_add_ps((a), (b))
+#define simd_subv(a, b) _mm512_sub_ps((a), (b))
+#define simd_mulv(a, b) _mm512_mul_ps((a), (b))
+#define simd_divv(a, b) _mm512_div_ps((a), (b))
+#define simd_minv(a, b) _mm512_min_ps((a), (b))
+#define simd_maxv(a, b) _mm512_max_ps((a), (b))
+#define simd_sqrtv(a) _mm512_sqrt_ps(a)
+#define simd_select_nz(c, a, b) _mm512_mask_blend_ps(_mm512_cmp_ps_mask((c), _mm512_setzero_ps(), _CMP_NEQ_UQ), (b), (a))
+#define simd_fmaddv(a, b, c) _mm512_fmadd_ps((a), (b), (c))
+#define simd_hsum(v) _mm512_reduce_add_ps(v)
+#define simd_absv(a) _mm512_abs_ps(a)
+#define simd_hmin(v) _mm512_reduce_min_ps(v)
+#define simd_hmax(v) _mm512_reduce_max_ps(v)
+#define simd_lt_mask(a, b) ((unsigned int)_mm512_cmp_ps_mask((a), (b), _CMP_LT_OQ))
+#define simd_eq_mask(a, b) ((unsigned int)_mm512_cmp_ps_mask((a), (b), _CMP_EQ_OQ))
+#define simd_select_lt(a, b, x, y) _mm512_mask_blend_ps(_mm512_cmp_ps_mask((a), (b), _CMP_LT_OQ), (y), (x))
+
+#elif defined(__AVX__)
+
+#define SIMD_WIDTH 8
+typedef __m256 simd_f;
+#define simd_load(p) _mm256_load_ps(p)
+#define simd_loadu(p) _mm256_loadu_ps(p)
+#define simd_store(p, v) _mm256_store_ps((p), (v))
+#define simd_storeu(p, v) _mm256_storeu_ps((p), (v))
+#define simd_set1(x) _mm256_set1_ps(x)
+#define simd_zero() _mm256_setzero_ps()
+#define simd_addv(a, b) _mm256_add_ps((a), (b))
+#define simd_subv(a, b) _mm256_sub_ps((a), (b))
+#define simd_mulv(a, b) _mm256_mul_ps((a), (b))
+#define simd_divv(a, b) _mm256_div_ps((a), (b))
+#define simd_minv(a, b) _mm256_min_ps((a), (b))
+#define simd_maxv(a, b) _mm256_max_ps((a), (b))
+#define simd_sqrtv(a) _mm256_sqrt_ps(a)
+#define simd_select_nz(c, a, b) _mm256_blendv_ps((a), (b), _mm256_cmp_ps((c), _mm256_setzero_ps(), _CMP_EQ_OQ))
+#define simd_absv(a) _mm256_andnot_ps(_mm256_set1_ps(-0.0f), (a))
+#define simd_lt_mask(a, b) ((unsigned int)_mm256_movemask_ps(_mm256_cmp_ps((a), (b), _CMP_LT_OQ)))
+#define simd_eq_mask(a, b) ((unsigned int)_mm256_movemask_ps(_mm256_cmp_ps((a), (b), _CMP_EQ_OQ)))
+#define simd_select_lt(a, b, x, y) _mm256_blendv_ps((y), (x), _mm256_cmp_ps((a), (b), _CMP_LT_OQ))
+#ifdef __FMA__
+#define simd_fmaddv(a, b, c) _mm256_fmadd_ps((a), (b), (c))
+#else
+#define simd_fmaddv(a, b, c) _mm256_add_ps(_mm256_mul_ps((a), (b)), (c))
+#endif
+
+static inline float simd_hsum(__m256 v)
+{
+    __m128 lo = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    lo = _mm_add_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_add_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+    return _mm_cvtss_f32(lo);
+}
+
+static inline float simd_hmin(__m256 v)
+{
+    __m128 lo = _mm_min_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    lo = _mm_min_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_min_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+    return _mm_cvtss_f32(lo);
+}
+
+static inline float simd_hmax(__m256 v)
+{
+    __m128 lo = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    lo = _mm_max_ps(lo, _mm_movehl_ps(lo, lo));
+    lo = _mm_max_ss(lo, _mm_shuffle_ps(lo, lo, 1));
+    return _mm_cvtss_f32(lo);
+}
+
+#elif defined(__SSE2__)
+
+#define SIMD_WIDTH 4
+typedef __m128 simd_f;
+#define simd_load(p) _mm_load_ps(p)
+#define simd_loadu(p) _mm_loadu_ps(p)
+#define simd_store(p, v) _mm_store_ps((p), (v))
+#define simd_storeu(p, v) _mm_storeu_ps((p), (v))
+#define simd_set1(x) _mm_set1_ps(x)
+#define simd_zero() _mm_setzero_ps()
+#define simd_addv(a, b) _mm_add_ps((a), (b))
+#define simd_subv(a, b) _mm_sub_ps((a), (b))
+#define simd_mulv(a, b) _mm_mul_ps((a), (b))
+#define simd_divv(a, b) _mm_div_ps((a), (b))
+#define simd_minv(a, b) _mm_min_ps((a), (b))
+#define simd_maxv(a, b) _mm_max_ps((a), (b))
+#define simd_sqrtv(a) _mm_sqrt_ps(a)
+#define simd_fmaddv(a, b, c) _mm_add_ps(_mm_mul_ps((a), (b)), (c))
+#define simd_absv(a) _mm_andnot_ps(_mm_set1_ps(-0.0f), (a))
+#define simd_lt_mask(a, b) ((unsigned int)_mm_movemask_ps(_mm_cmplt_ps((a), (b))))
+#define simd_eq_mask(a, b) ((unsigned int)_mm_movemask_ps(_mm_cmpeq_ps((a), (b))))
+
+static inline float simd_hsum(__m128 v)
+{
+    v = _mm_add_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_add_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+static inline __m128 simd_select_nz(__m128 c, __m128 a, __m128 b)
+{
+    __m128 zero = _mm_cmpeq_ps(c, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(zero, b), _mm_andnot_ps(zero, a));
+}
+
+static inline __m128 simd_select_lt(__m128 a, __m128 b, __m128 x, __m128 y)
+{
+    __m128 lt = _mm_cmplt_ps(a, b);
+    return _mm_or_ps(_mm_and_ps(lt, x), _mm_andnot_ps(lt, y));
+}
+
+static inline float simd_hmin(__m128 v)
+{
+    v = _mm_min_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_min_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+static inline float simd_hmax(__m128 v)
+{
+    v = _mm_max_ps(v, _mm_movehl_ps(v, v));
+    v = _mm_max_ss(v, _mm_shuffle_ps(v, v, 1));
+    return _mm_cvtss_f32(v);
+}
+
+#else
+
+#define SIMD_WIDTH 1
+
+#endif
+
+/**
+ * Yardımcı fonksiyonların iki kopyası üretilir:
+ *  simd_xxx   : hizalanmamış yükleme (her adres için geçerli)
+ *  simd_xxx_a : hizalı yükleme, tüm işaretçiler SIMD_WIDTH * 4 bayta hizalı olmalı
+ *               (MATRIX_ALIGNED bayraklı matrix satırları ve vektör tamponları)
+ */
+#if SIMD_WIDTH > 1
+
+#define SIMD_DEFINE_KERNELS(SUFFIX, LOAD, STORE)                                              \
+    static inline float simd_dot##SUFFIX(const float *a, const float *b, unsigned int n)      \
+    {                                                                                         \
+        simd_f s0 = simd_zero(), s1 = simd_zero(), s2 = simd_zero(), s3 = simd_zero();        \
+        unsigned int i = 0;                                                                   \
+        for (; i + 4 * SIMD_WIDTH <= n; i += 4 * SIMD_WIDTH)                                  \
+        {                                                                                     \
+            s0 = simd_fmaddv(LOAD(a + i), LOAD(b + i), s0);                                   \
+            s1 = simd_fmaddv(LOAD(a + i + SIMD_WIDTH), LOAD(b + i + SIMD_WIDTH), s1);         \
+            s2 = simd_fmaddv(LOAD(a + i + 2 * SIMD_WIDTH), LOAD(b + i + 2 * SIMD_WIDTH), s2); \
+            s3 = simd_fmaddv(LOAD(a + i + 3 * SIMD_WIDTH), LOAD(b + i + 3 * SIMD_WIDTH), s3); \
+        }                                                                                     \
+        for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH)                                          \
+        {                                                                                     \
+            s0 = simd_fmaddv(LOAD(a + i), LOAD(b + i), s0);                                   \
+        }                                                                                     \
+        float r = simd_hsum(simd_addv(simd_addv(s0, s1), simd_addv(s2, s3)));                 \
+        for (; i < n; i++)                                                                    \
+        {                                                                                     \
+            r += a[i] * b[i];                                                                 \
+        }                                                                                     \
+        return r;                                                                             \
+    }                                                                                         \
+                                                                                              \
+    static inline void simd_add##SUFFIX(float *d, const float *a, const float *b, unsigned int n) \
+    {                                                                                         \
+        unsigned int i = 0;                                                                   \
+        for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH)                                          \
+        {                                                                                     \
+            STORE(d + i, simd_addv(LOAD(a + i), LOAD(b + i)));                                \
+        }                                                                                     \
+        for (; i < n; i++)                                                                    \
+        {                                                                                     \
+            d[i] = a[i] + b[i];                                                               \
+        }                                                                                     \
+    }                                                                                         \
+                                                                                              \
+    static inline void simd_sub##SUFFIX(float *d, const float *a, const float *b, unsigned int n) \
+    {                                                                                         \
+        unsigned int i = 0;                                                                   \
+        for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH)                                          \
+        {                                                                                     \
+            STORE(d + i, simd_subv(LOAD(a + i), LOAD(b + i)));                                \
+        }                                                                                     \
+        for (; i < n; i++)                                                                    \
+        {                                                                                     \
+            d[i] = a[i] - b[i];                                                               \
+        }                                                                                     \
+    }                                                                                         \
+                                                                                              \
+    static inline void simd_scale##SUFFIX(float *d, const float *a, float s, unsigned int n)  \
+    {                                                                                         \
+        simd_f vs = simd_set1(s);                                                             \
+        unsigned int i = 0;                                                                   \
+        for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH)                                          \
+        {                                                                                     \
+            STORE(d + i, simd_mulv(LOAD(a + i), vs));                                         \
+        }                                                                                     \
+        for (; i < n; i++)                                                                    \
+        {                                                                                     \
+            d[i] = a[i] * s;                                                                  \
+        }                                                                                     \
+    }                                                                                         \
+                                                                                              \
+    static inline void simd_axpy##SUFFIX(float *d, const float *a, float s, unsigned int n)   \
+    {                                                                                         \
+        simd_f vs = simd_set1(s);                                                             \
+        unsigned int i = 0;                                                                   \
+        for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH)                                          \
+        {                                                                                     \
+            STORE(d + i, simd_fmaddv(LOAD(a + i), vs, LOAD(d + i)));                          \
+        }                                                                                     \
+        for (; i < n; i++)                                                                    \
+        {                                                                                     \
+            d[i] += a[i] * s;                                                                 \
+        }                                                                                     \
+    }
+
+SIMD_DEFINE_KERNELS(, simd_loadu, simd_storeu)
+SIMD_DEFINE_KERNELS(_a, simd_load, simd_store)
+
+#else
+
+static inline float simd_dot(const float *a, const float *b, unsigned int n)
+{
+    float r = 0.0f;
+    for (unsigned int i = 0; i < n; i++)
+    {
+        r += a[i] * b[i];
+    }
+    return r;
+}
+
+static inline void simd_add(float *d, const float *a, const float *b, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; i++)
+    {
+        d[i] = a[i] + b[i];
+    }
+}
+
+static inline void simd_sub(float *d, const float *a, const float *b, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; i++)
+    {
+        d[i] = a[i] - b[i];
+    }
+}
+
+static inline void simd_scale(float *d, const float *a, float s, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; i++)
+    {
+        d[i] = a[i] * s;
+    }
+}
+
+static inline void simd_axpy(float *d, const float *a, float s, unsigned int n)
+{
+    for (unsigned int i = 0; i < n; i++)
+    {
+        d[i] += a[i] * s;
+    }
+}
+
+#define simd_dot_a simd_dot
+#define simd_add_a simd_add
+#define simd_sub_a simd_sub
+#define simd_scale_a simd_scale
+#define simd_axpy_a simd_axpy
+
+#endif
+
+#endif
\ No newline at end of file
@@ -1,23 +1,119 @@
 #include "vec.h"
+#include "memory.h"
+#include "profile.h"
+#include "simd.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 
-const vec VEC_UNDEFINED = {0, NULL};
+const vec VEC_UNDEFINED = {0, NULL, NULL};
+
+/**
+ * adopt_vector ile alınan tamponun sahibi. free_vector bu tamponları
+ * memory_free_aligned yerine release fonksiyonuyla bırakır.
+ */
+struct vec_owner
+{
+    buffer_release_fn release;
+    void *ctx;
+};
+
+/**
+ * Ödünç alınan (release NULL) tamponların ortak sahibi; tahsis edilmez
+ * ve free_vector bu tamponlara dokunmaz.
+ */
+static vec_owner vec_borrowed = {NULL, NULL};
 
 /**
  * Bellekte gereken dim değişkeni adedinde
  * float değer saklayacak yeri ayarlamak için kullanılıyor
  *
- * malloc : stdlib.h kütüphanesinden dinamik bellek yönetimi fonksiyonu
+ * memory_alloc_aligned : memory.h üzerinden (takip edilebilen) dinamik bellek yönetimi.
+ * Tampon MEMORY_ALIGNMENT (64) bayta hizalıdır.
  */
-vec allocate_vector_mem(unsigned int dim)
+vec allocate_vector_mem_at(unsigned int dim, const char *func, const char *file, int line)
 {
 
+    PROFILE_BEGIN(PROFILE_ALLOCATION);
+
     vec ret;
 
     ret.dim = dim;
-    ret.elements = malloc(dim * sizeof(float));
+    ret.elements = memory_alloc_aligned(dim * sizeof(float), MEMORY_ALIGNMENT, func, file, line);
+    ret.owner = NULL;
+
+    PROFILE_END(PROFILE_ALLOCATION, 0, 0);
+
+    return ret;
+}
+
+/**
+ * Vektörün elemanlarını bellekten serbest bırakır.
+ */
+void free_vector(vec *v)
+{
+    if (v->owner == NULL)
+    {
+        memory_free_aligned(v->elements);
+    }
+    else if (v->owner->release != NULL)
+    {
+        v->owner->release(v->elements, v->owner->ctx);
+        memory_free(v->owner);
+    }
+
+    v->elements = NULL;
+    v->dim = 0;
+    v->owner = NULL;
+}
+
+/**
+ * Çağıranın dizisini kopyalamadan vektör olarak kullanır.
+ */
+vec adopt_vector(float *data, unsigned int dim, buffer_release_fn release, void *ctx)
+{
+    if (data == NULL)
+    {
+        return VEC_UNDEFINED;
+    }
+
+    vec ret = {dim, data, &vec_borrowed};
+
+    if (release == NULL)
+    {
+        return ret;
+    }
+
+    ret.owner = (vec_owner *)MEMORY_ALLOC(sizeof(vec_owner));
+
+    if (ret.owner == NULL)
+    {
+        return VEC_UNDEFINED;
+    }
+
+    ret.owner->release = release;
+    ret.owner->ctx = ctx;
+
+    return ret;
+}
+
+/**
+ * data dizisinden yeni vektör.
+ */
+vec vector_from_array(const float *data, unsigned int dim)
+{
+    if (data == NULL)
+    {
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_VECTOR_CONSTRUCT);
+
+    vec ret = allocate_vector_mem(dim);
+
+    memcpy(ret.elements, data, dim * sizeof(float));
+
+    PROFILE_END(PROFILE_VECTOR_CONSTRUCT, 0, 2ull * dim * sizeof(float));
 
     return ret;
 }
@@ -28,6 +124,8 @@ vec allocate_vector_mem(unsigned int dim)
 vec construct_default_vector(unsigned int dim, float val)
 {
 
+    PROFILE_BEGIN(PROFILE_VECTOR_CONSTRUCT);
+
     vec ret = allocate_vector_mem(dim);
 
     for (unsigned int i = 0; i < dim; i++)
@@ -35,6 +133,8 @@ vec construct_default_vector(unsigned int dim, float val)
         ret.elements[i] = val;
     }
 
+    PROFILE_END(PROFILE_VECTOR_CONSTRUCT, 0, dim * sizeof(float));
+
     return ret;
 }
 
@@ -53,6 +153,8 @@ vec construct_empty_vector(unsigned int dim)
 vec new_vector(unsigned int dim, ...)
 {
 
+    PROFILE_BEGIN(PROFILE_VECTOR_CONSTRUCT);
+
     vec ret = allocate_vector_mem(dim);
 
     va_list list;
@@ -65,6 +167,8 @@ vec new_vector(unsigned int dim, ...)
 
     va_end(list);
 
+    PROFILE_END(PROFILE_VECTOR_CONSTRUCT, 0, dim * sizeof(float));
+
     return ret;
 }
 
@@ -148,11 +252,15 @@ bool vector_equals_compare(vec v1, vec v2)
  */
 vec scalar_multiplication(vec v1, float scalar)
 {
+    PROFILE_BEGIN(PROFILE_VECTOR_SCALAR);
+
     for (unsigned int i = 0; i < v1.dim; i++)
     {
         v1.elements[i] = scalar * v1.elements[i];
     }
 
+    PROFILE_END(PROFILE_VECTOR_SCALAR, v1.dim, 2 * v1.dim * sizeof(float));
+
     return v1;
 }
 
@@ -170,10 +278,11 @@ float norm_of_vector(vec v1)
         return 0.0f;
     }
 
-    for (unsigned i = 0; i < v1.dim; i++)
-    {
-        square_sums += v1.elements[i] * v1.elements[i];
-    }
+    PROFILE_BEGIN(PROFILE_VECTOR_NORM);
+
+    square_sums = simd_dot(v1.elements, v1.elements, v1.dim);
+
+    PROFILE_END(PROFILE_VECTOR_NORM, 2 * v1.dim, v1.dim * sizeof(float));
 
     if (square_sums < 0)
     {
@@ -198,10 +307,11 @@ float norm_of_vector_ptr(vec *v1)
         return 0.0f;
     }
 
-    for (unsigned i = 0; i < v1->dim; i++)
-    {
-        square_sums += v1->elements[i] * v1->elements[i];
-    }
+    PROFILE_BEGIN(PROFILE_VECTOR_NORM);
+
+    square_sums = simd_dot(v1->elements, v1->elements, v1->dim);
+
+    PROFILE_END(PROFILE_VECTOR_NORM, 2 * v1->dim, v1->dim * sizeof(float));
 
     if (square_sums < 0)
     {
@@ -225,10 +335,11 @@ float dot_product_of_vector(vec v1, vec v2)
         return 0.0f;
     }
 
-    for (unsigned int i = 0; i < v1.dim; i++)
-    {
-        dot_result += v1.elements[i] * v2.elements[i];
-    }
+    PROFILE_BEGIN(PROFILE_VECTOR_DOT);
+
+    dot_result = simd_dot(v1.elements, v2.elements, v1.dim);
+
+    PROFILE_END(PROFILE_VECTOR_DOT, 2 * v1.dim, 2 * v1.dim * sizeof(float));
 
     return dot_result;
 }
@@ -238,18 +349,22 @@ float dot_product_of_vector(vec v1, vec v2)
  */
 vec cross_product_of_vector(vec v1, vec v2)
 {
-    vec cross_product_result = construct_default_vector(3, 1.0f);
-
     if (v1.dim != 3 && v2.dim != 3)
     {
         printf("\n* Dimention error\n");
         return VEC_UNDEFINED;
     }
 
+    vec cross_product_result = allocate_vector_mem(3);
+
+    PROFILE_BEGIN(PROFILE_VECTOR_CROSS);
+
     cross_product_result.elements[0] = v1.elements[1] * v2.elements[2] - v1.elements[2] * v2.elements[1];
     cross_product_result.elements[1] = v1.elements[2] * v2.elements[0] - v1.elements[0] * v2.elements[2];
     cross_product_result.elements[2] = v1.elements[0] * v2.elements[1] - v1.elements[1] * v2.elements[0];
 
+    PROFILE_END(PROFILE_VECTOR_CROSS, 9, 9 * sizeof(float));
+
     printf("Cross product: (%.2fi, %.2fj, %.2fk)\n", cross_product_result.elements[0],
            cross_product_result.elements[1], cross_product_result.elements[2]);
 
@@ -262,19 +377,23 @@ vec cross_product_of_vector(vec v1, vec v2)
  */
 vec add_vector(vec v1, vec v2)
 {
-    vec ret = construct_default_vector(v1.dim, 0.0f);
-
     if (v1.dim != v2.dim)
     {
         printf("\n* Dimention error\n");
         return VEC_UNDEFINED;
     }
 
+    vec ret = allocate_vector_mem(v1.dim);
+
+    PROFILE_BEGIN(PROFILE_VECTOR_ADD);
+
     for (unsigned int i = 0; i < v1.dim; i++)
     {
         ret.elements[i] = v1.elements[i] + v2.elements[i];
     }
 
+    PROFILE_END(PROFILE_VECTOR_ADD, v1.dim, 3 * v1.dim * sizeof(float));
+
     return ret;
 }
 
@@ -291,11 +410,15 @@ bool add_vector_ptr(vec *v1, vec v2)
         return false;
     }
 
+    PROFILE_BEGIN(PROFILE_VECTOR_ADD);
+
     for (unsigned int i = 0; i < v2.dim; i++)
     {
         v1->elements[i] += v2.elements[i];
     }
 
+    PROFILE_END(PROFILE_VECTOR_ADD, v2.dim, 3 * v2.dim * sizeof(float));
+
     return true;
 }
 
@@ -304,19 +427,23 @@ bool add_vector_ptr(vec *v1, vec v2)
  */
 vec substract_vector(vec v1, vec v2)
 {
-    vec ret = construct_default_vector(v1.dim, 0.0f);
-
     if (v1.dim != v2.dim)
     {
         printf("\n* Dimention error\n");
         return VEC_UNDEFINED;
     }
 
+    vec ret = allocate_vector_mem(v1.dim);
+
+    PROFILE_BEGIN(PROFILE_VECTOR_SUBSTRACT);
+
     for (unsigned int i = 0; i < v1.dim; i++)
     {
         ret.elements[i] = v1.elements[i] - v2.elements[i];
     }
 
+    PROFILE_END(PROFILE_VECTOR_SUBSTRACT, v1.dim, 3 * v1.dim * sizeof(float));
+
     return ret;
 }
 
@@ -332,11 +459,15 @@ bool substract_vector_ptr(vec *v1, vec v2)
         return false;
     }
 
+    PROFILE_BEGIN(PROFILE_VECTOR_SUBSTRACT);
+
     for (unsigned int i = 0; i < v2.dim; i++)
     {
         v1->elements[i] -= v2.elements[i];
     }
 
+    PROFILE_END(PROFILE_VECTOR_SUBSTRACT, v2.dim, 3 * v2.dim * sizeof(float));
+
     return true;
 }
 
@@ -345,25 +476,30 @@ bool substract_vector_ptr(vec *v1, vec v2)
  */
 vec dvide_element_vector(vec v1, vec v2)
 {
-
-    vec ret = construct_default_vector(v1.dim, 0.0f);
-
     if (v1.dim != v2.dim)
     {
         printf("\n* Dimention error\n");
         return VEC_UNDEFINED;
     }
 
+    vec ret = allocate_vector_mem(v1.dim);
+
+    PROFILE_BEGIN(PROFILE_VECTOR_DIVIDE);
+
     for (unsigned int i = 0; i < v1.dim; i++)
     {
         if (v2.elements[i] == 0.0f)
         {
             printf("\n* Zero Division Problem\n");
+            free_vector(&ret);
+            PROFILE_END(PROFILE_VECTOR_DIVIDE, i, 3 * i * sizeof(float));
             return VEC_UNDEFINED;
         }
         ret.elements[i] = v1.elements[i] / v2.elements[i];
     }
 
+    PROFILE_END(PROFILE_VECTOR_DIVIDE, v1.dim, 3 * v1.dim * sizeof(float));
+
     return ret;
 }
 
@@ -378,11 +514,14 @@ bool dvide_element_vector_ptr(vec *v1, vec v2)
         return false;
     }
 
+    PROFILE_BEGIN(PROFILE_VECTOR_DIVIDE);
+
     for (unsigned int i = 0; i < v2.dim; i++)
     {
         if (v2.elements[i] == 0.0f)
         {
             printf("\n* Zero Division Problem\n");
+            PROFILE_END(PROFILE_VECTOR_DIVIDE, i, 3 * i * sizeof(float));
             return false;
         }
         /**
@@ -391,6 +530,8 @@ bool dvide_element_vector_ptr(vec *v1, vec v2)
         v1->elements[i] /= v2.elements[i];
     }
 
+    PROFILE_END(PROFILE_VECTOR_DIVIDE, v2.dim, 3 * v2.dim * sizeof(float));
+
     return true;
 }
 
@@ -425,10 +566,14 @@ void power_of_vector(vec *v1, float pow)
         printf("Negative power error.");
     }
 
+    PROFILE_BEGIN(PROFILE_VECTOR_POWER);
+
     for (unsigned int i = 0; i < v1->dim; i++)
     {
         v1->elements[i] = powf(v1->elements[i], pow);
     }
+
+    PROFILE_END(PROFILE_VECTOR_POWER, v1->dim, 2 * v1->dim * sizeof(float));
 }
 
 /**
@@ -437,7 +582,9 @@ void power_of_vector(vec *v1, float pow)
 vec normalized_vector(vec v1)
 {
 
-    vec ret_vec = new_vector(v1.dim);
+    PROFILE_BEGIN(PROFILE_VECTOR_NORMALIZE);
+
+    vec ret_vec = allocate_vector_mem(v1.dim);
     float norm_of_the_vector = norm_of_vector(v1);
 
     for (unsigned int i = 0; i < v1.dim; i++)
@@ -445,6 +592,8 @@ vec normalized_vector(vec v1)
         ret_vec.elements[i] = v1.elements[i] / norm_of_the_vector;
     }
 
+    PROFILE_END(PROFILE_VECTOR_NORMALIZE, v1.dim, 2 * v1.dim * sizeof(float));
+
     return ret_vec;
 }
 
@@ -461,10 +610,14 @@ void normalize_vector(vec *v1)
         printf("\n* Calculate Error norm cannot be negative or zero\n");
         return;
     }
+    PROFILE_BEGIN(PROFILE_VECTOR_NORMALIZE);
+
     for (unsigned int i = 0; i < v1->dim; i++)
     {
         v1->elements[i] = v1->elements[i] / norm_of_the_vector;
     }
+
+    PROFILE_END(PROFILE_VECTOR_NORMALIZE, v1->dim, 2 * v1->dim * sizeof(float));
 }
 
 /**
@@ -473,13 +626,20 @@ void normalize_vector(vec *v1)
 float distance_vector(vec v1, vec v2)
 {
 
-    vec ret_vec = substract_vector(v1, v2);
-
     if (v1.dim != v2.dim)
     {
         printf("\n* Dimention Error\n");
         return 0.0f;
     }
 
-    return norm_of_vector(ret_vec);
+    PROFILE_BEGIN(PROFILE_VECTOR_DISTANCE);
+
+    vec ret_vec = substract_vector(v1, v2);
+    float distance = norm_of_vector(ret_vec);
+
+    free_vector(&ret_vec);
+
+    PROFILE_END(PROFILE_VECTOR_DISTANCE, 3 * v1.dim, 3 * v1.dim * sizeof(float));
+
+    return distance;
 }
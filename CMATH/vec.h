@@ -6,6 +6,11 @@
 #ifndef VEC_H
 #define VEC_H
 
+/**
+ * adopt_vector ile alınan tamponun sahibi (vec.c içinde tanımlı).
+ */
+typedef struct vec_owner vec_owner;
+
 /**
  * Vektör yapısını içeren struct yapısıdır.
  *
@@ -18,12 +23,52 @@ typedef struct
     unsigned int dim;
     float *elements;
 
+    /* adopt_vector ile alındıysa tamponun sahibi; kütüphanenin tamponlarında NULL */
+    vec_owner *owner;
+
 } vec;
 
 /**
  * Vektör için dim boyutunda bellekten yer ayırır.
+ *
+ * Doğrudan değil allocate_vector_mem makrosu ile çağrılır;
+ * func, file ve line bellek takibinde tahsis yeri olarak görünür.
+ */
+vec allocate_vector_mem_at(unsigned int dim, const char *func, const char *file, int line);
+
+#define allocate_vector_mem(dim) allocate_vector_mem_at((dim), __func__, __FILE__, __LINE__)
+
+/**
+ * Vektörün elemanlarını bellekten serbest bırakır.
+ * copy_vector ile elde edilen kopyalar aynı belleği paylaşır,
+ * bunlardan yalnızca biri serbest bırakılmalıdır.
+ *
+ * allocate_vector_mem hizalı ve takip edilen bellek döndürdüğünden
+ * elements free() ile bırakılamaz; her zaman free_vector kullanılmalıdır.
+ */
+void free_vector(vec *v);
+
+/**
+ * Devralınan veya ödünç alınan tamponlar için serbest bırakma fonksiyonu.
+ * ctx çağrıya olduğu gibi geçirilir.
+ */
+typedef void (*buffer_release_fn)(float *data, void *ctx);
+
+/**
+ * Çağıranın float dizisini kopyalamadan vektör olarak kullanır.
+ *
+ * free_vector diziyi kendisi serbest bırakmaz; release NULL değilse
+ * release(data, ctx) çağrılır, NULL ise dizi çağıranda kalır.
+ * Sahiplik dönen vektörün owner alanında taşınır; release NULL ise hiç
+ * bellek ayrılmaz. copy_vector kopyalarında olduğu gibi yalnızca bir kez
+ * bırakılmalıdır.
+ */
+vec adopt_vector(float *data, unsigned int dim, buffer_release_fn release, void *ctx);
+
+/**
+ * data dizisindeki dim elemanı yeni bir vektöre tek memcpy ile kopyalar.
  */
-vec allocate_vector_mem(unsigned int dim);
+vec vector_from_array(const float *data, unsigned int dim);
 
 /**
  *
@@ -0,0 +1,486 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+//
+//      VASYNC.C
+//  Matrix işlemlerinin arka planda
+//  çalıştırılması ve future'lar
+//
+#include "vasync.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+
+typedef enum
+{
+    ASYNC_MULTIPLICATION,
+    ASYNC_SUM,
+    ASYNC_SUBSTRACT,
+    ASYNC_SCALAR,
+    ASYNC_TRANSPOSE,
+    ASYNC_POWER,
+    ASYNC_USER,
+    ASYNC_THEN
+
+} async_kind;
+
+struct matrix_future
+{
+    pthread_mutex_t lock;
+    pthread_cond_t done;
+    bool finished;
+
+    /* Kullanıcı, kuyruk ve bağlı olduğu future'ın listesi referans tutar */
+    atomic_uint refs;
+
+    async_kind kind;
+    matrix a;
+    matrix b;
+    float scalar;
+    unsigned int pow;
+    async_fn fn;
+    future_then_fn then;
+    void *ctx;
+
+    matrix result;
+
+    /* Bu future bitince kuyruğa girecek __future_then adımları */
+    matrix_future *dependents;
+
+    /* Kuyrukta veya bağımlı listesinde bir sonraki */
+    matrix_future *next;
+};
+
+static pthread_mutex_t async_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t async_wake = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t async_idle = PTHREAD_COND_INITIALIZER;
+
+static matrix_future *async_head = NULL;
+static matrix_future *async_tail = NULL;
+
+/* Kuyruktan alınmış ama henüz bitmemiş işler */
+static unsigned int async_running = 0;
+
+/* __async_set_executors ile istenen yürütücü sayısı; 0 ise varsayılan */
+static unsigned int async_requested = 0;
+
+/* Yürütücüler başlatılırken async_capacity kadar yer ayrılır */
+static pthread_t *async_threads = NULL;
+static unsigned int async_capacity = 0;
+static unsigned int async_started = 0;
+static bool async_stop = false;
+
+/**
+ * @brief CMATRIX_ASYNC_EXECUTORS veya parallel_threads().
+ */
+static unsigned int async_default_executors(void)
+{
+    const char *env = getenv("CMATRIX_ASYNC_EXECUTORS");
+
+    if (env != NULL && atoi(env) > 0)
+    {
+        return (unsigned int)atoi(env);
+    }
+
+    return parallel_threads();
+}
+
+void __async_set_executors(unsigned int executors)
+{
+    pthread_mutex_lock(&async_lock);
+    async_requested = executors;
+    pthread_mutex_unlock(&async_lock);
+}
+
+unsigned int __async_executors(void)
+{
+    pthread_mutex_lock(&async_lock);
+
+    unsigned int executors = async_threads != NULL ? async_capacity
+                             : async_requested > 0 ? async_requested
+                                                   : async_default_executors();
+
+    pthread_mutex_unlock(&async_lock);
+
+    return executors;
+}
+
+static matrix_future *future_new(async_kind kind)
+{
+    matrix_future *f = (matrix_future *)MEMORY_ALLOC(sizeof(matrix_future));
+
+    __allocation_err(f, "Async future");
+
+    pthread_mutex_init(&f->lock, NULL);
+    pthread_cond_init(&f->done, NULL);
+    f->finished = false;
+
+    // Kullanıcı ve kuyruk
+    atomic_init(&f->refs, 2);
+
+    f->kind = kind;
+    f->a = MATRIX_UNDEFINED;
+    f->b = MATRIX_UNDEFINED;
+    f->scalar = 0.0f;
+    f->pow = 0;
+    f->fn = NULL;
+    f->then = NULL;
+    f->ctx = NULL;
+    f->result = MATRIX_UNDEFINED;
+    f->dependents = NULL;
+    f->next = NULL;
+
+    return f;
+}
+
+static void future_release(matrix_future *f)
+{
+    if (atomic_fetch_sub(&f->refs, 1) != 1)
+    {
+        return;
+    }
+
+    __free_matrix(&f->a);
+    __free_matrix(&f->b);
+    __free_matrix(&f->result);
+
+    pthread_mutex_destroy(&f->lock);
+    pthread_cond_destroy(&f->done);
+
+    memory_free(f);
+}
+
+static matrix async_execute(matrix_future *f)
+{
+    switch (f->kind)
+    {
+    case ASYNC_MULTIPLICATION:
+        return __multiplication_matrix(f->a, f->b);
+    case ASYNC_SUM:
+        return __sum_matrix(f->a, f->b);
+    case ASYNC_SUBSTRACT:
+        return __substract_matrix(f->a, f->b);
+    case ASYNC_SCALAR:
+        return __scalar_multiplication(f->a, f->scalar);
+    case ASYNC_TRANSPOSE:
+        return __transpose_matrix(f->a);
+    case ASYNC_POWER:
+        return __power_matrix(f->a, f->pow);
+    case ASYNC_USER:
+        return f->fn(f->ctx);
+    case ASYNC_THEN:
+    default:
+        // Önceki adım başarısız olduysa zincir burada da başarısız olur
+        return f->a.vrows != NULL ? f->then(f->a, f->ctx) : MATRIX_UNDEFINED;
+    }
+}
+
+static void async_enqueue(matrix_future *f);
+
+/**
+ * @brief Sonucu yayınlar, bekleyenleri uyandırır ve bağlı adımları kuyruğa ekler.
+ */
+static void async_complete(matrix_future *f, matrix result)
+{
+    pthread_mutex_lock(&f->lock);
+
+    f->result = result;
+    f->finished = true;
+
+    matrix_future *deps = f->dependents;
+    f->dependents = NULL;
+
+    // Sonuç kilit altında paylaşılır; __share_matrix aynı tutamaç
+    // üzerinde eşzamanlı çağrılmamalıdır
+    for (matrix_future *d = deps; d != NULL; d = d->next)
+    {
+        d->a = __share_matrix(&f->result);
+    }
+
+    pthread_cond_broadcast(&f->done);
+    pthread_mutex_unlock(&f->lock);
+
+    while (deps != NULL)
+    {
+        matrix_future *next = deps->next;
+
+        deps->next = NULL;
+        async_enqueue(deps);
+        deps = next;
+    }
+}
+
+static void *async_executor_main(void *arg)
+{
+    (void)arg;
+
+    pthread_mutex_lock(&async_lock);
+
+    for (;;)
+    {
+        while (async_head == NULL && !async_stop)
+        {
+            pthread_cond_wait(&async_wake, &async_lock);
+        }
+
+        if (async_head == NULL)
+        {
+            break;
+        }
+
+        matrix_future *f = async_head;
+        async_head = f->next;
+        async_tail = async_head != NULL ? async_tail : NULL;
+        f->next = NULL;
+        async_running++;
+
+        pthread_mutex_unlock(&async_lock);
+
+        matrix result = async_execute(f);
+
+        // Girdiler artık gerekmez, paylaşılan depolama erkenden bırakılır
+        __free_matrix(&f->a);
+        __free_matrix(&f->b);
+        f->a = MATRIX_UNDEFINED;
+        f->b = MATRIX_UNDEFINED;
+
+        async_complete(f, result);
+        future_release(f);
+
+        pthread_mutex_lock(&async_lock);
+
+        if (--async_running == 0 && async_head == NULL)
+        {
+            pthread_cond_broadcast(&async_idle);
+        }
+    }
+
+    pthread_mutex_unlock(&async_lock);
+
+    return NULL;
+}
+
+static void async_enqueue(matrix_future *f)
+{
+    pthread_mutex_lock(&async_lock);
+
+    // Yürütücüler ilk gönderimde başlatılır; sayı durdurulana kadar sabittir
+    if (async_threads == NULL && !async_stop)
+    {
+        async_capacity = async_requested > 0 ? async_requested : async_default_executors();
+        async_threads = (pthread_t *)MEMORY_ALLOC(async_capacity * sizeof(pthread_t));
+        async_capacity = async_threads != NULL ? async_capacity : 0;
+    }
+
+    while (async_started < async_capacity && !async_stop)
+    {
+        if (pthread_create(&async_threads[async_started], NULL, async_executor_main, NULL) != 0)
+        {
+            break;
+        }
+        async_started++;
+    }
+
+    if (async_started == 0)
+    {
+        // Thread açılamıyorsa iş çağıran thread'de çalışır
+        pthread_mutex_unlock(&async_lock);
+
+        matrix result = async_execute(f);
+        async_complete(f, result);
+        future_release(f);
+        return;
+    }
+
+    if (async_tail != NULL)
+    {
+        async_tail->next = f;
+    }
+    else
+    {
+        async_head = f;
+    }
+    async_tail = f;
+
+    pthread_cond_signal(&async_wake);
+    pthread_mutex_unlock(&async_lock);
+}
+
+static matrix_future *async_binary(async_kind kind, matrix *matx1, matrix *matx2)
+{
+    matrix_future *f = future_new(kind);
+
+    f->a = __share_matrix(matx1);
+    f->b = __share_matrix(matx2);
+
+    async_enqueue(f);
+
+    return f;
+}
+
+matrix_future *__async_multiplication(matrix *matx1, matrix *matx2)
+{
+    return async_binary(ASYNC_MULTIPLICATION, matx1, matx2);
+}
+
+matrix_future *__async_sum(matrix *matx1, matrix *matx2)
+{
+    return async_binary(ASYNC_SUM, matx1, matx2);
+}
+
+matrix_future *__async_substract(matrix *matx1, matrix *matx2)
+{
+    return async_binary(ASYNC_SUBSTRACT, matx1, matx2);
+}
+
+matrix_future *__async_scalar_multiplication(matrix *matx, float scalar)
+{
+    matrix_future *f = future_new(ASYNC_SCALAR);
+
+    f->a = __share_matrix(matx);
+    f->scalar = scalar;
+
+    async_enqueue(f);
+
+    return f;
+}
+
+matrix_future *__async_transpose(matrix *matx)
+{
+    matrix_future *f = future_new(ASYNC_TRANSPOSE);
+
+    f->a = __share_matrix(matx);
+
+    async_enqueue(f);
+
+    return f;
+}
+
+matrix_future *__async_power(matrix *matx, unsigned int pow)
+{
+    matrix_future *f = future_new(ASYNC_POWER);
+
+    f->a = __share_matrix(matx);
+    f->pow = pow;
+
+    async_enqueue(f);
+
+    return f;
+}
+
+matrix_future *__async_submit(async_fn fn, void *ctx)
+{
+    if (fn == NULL)
+    {
+        printf("\n\nAsync submit requires a function\n\n");
+        return NULL;
+    }
+
+    matrix_future *f = future_new(ASYNC_USER);
+
+    f->fn = fn;
+    f->ctx = ctx;
+
+    async_enqueue(f);
+
+    return f;
+}
+
+matrix_future *__future_then(matrix_future *future, future_then_fn fn, void *ctx)
+{
+    if (future == NULL || fn == NULL)
+    {
+        printf("\n\nFuture then requires a future and a function\n\n");
+        return NULL;
+    }
+
+    matrix_future *f = future_new(ASYNC_THEN);
+
+    f->then = fn;
+    f->ctx = ctx;
+
+    pthread_mutex_lock(&future->lock);
+
+    if (!future->finished)
+    {
+        // Kuyruk referansı, önceki adım bitene kadar listede bekler
+        f->next = future->dependents;
+        future->dependents = f;
+
+        pthread_mutex_unlock(&future->lock);
+        return f;
+    }
+
+    f->a = __share_matrix(&future->result);
+
+    pthread_mutex_unlock(&future->lock);
+
+    async_enqueue(f);
+
+    return f;
+}
+
+bool __future_ready(matrix_future *future)
+{
+    pthread_mutex_lock(&future->lock);
+
+    bool ready = future->finished;
+
+    pthread_mutex_unlock(&future->lock);
+
+    return ready;
+}
+
+matrix __future_wait(matrix_future *future)
+{
+    pthread_mutex_lock(&future->lock);
+
+    while (!future->finished)
+    {
+        pthread_cond_wait(&future->done, &future->lock);
+    }
+
+    matrix ret_matrix = __share_matrix(&future->result);
+
+    pthread_mutex_unlock(&future->lock);
+
+    return ret_matrix;
+}
+
+void __future_free(matrix_future *future)
+{
+    if (future != NULL)
+    {
+        future_release(future);
+    }
+}
+
+void __async_shutdown(void)
+{
+    pthread_mutex_lock(&async_lock);
+
+    while (async_head != NULL || async_running > 0)
+    {
+        pthread_cond_wait(&async_idle, &async_lock);
+    }
+
+    async_stop = true;
+    pthread_cond_broadcast(&async_wake);
+
+    unsigned int started = async_started;
+
+    pthread_mutex_unlock(&async_lock);
+
+    for (unsigned int i = 0; i < started; i++)
+    {
+        pthread_join(async_threads[i], NULL);
+    }
+
+    pthread_mutex_lock(&async_lock);
+    memory_free(async_threads);
+    async_threads = NULL;
+    async_capacity = 0;
+    async_started = 0;
+    async_stop = false;
+    pthread_mutex_unlock(&async_lock);
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "vmatrix.h"
+
+#ifndef VASYNC_H
+#define VASYNC_H
+
+/**
+ * @brief Arka planda hesaplanan bir matrix sonucunun tutamacı.
+ *
+ * __async_* fonksiyonları işlemi arka plandaki yürütücü thread'lere
+ * gönderir ve hemen döner. Birbirinden bağımsız işlemler aynı anda
+ * çalışabilir. Her future __future_free ile bırakılmalıdır.
+ */
+typedef struct matrix_future matrix_future;
+
+/**
+ * @brief Arka planda çalıştırılacak kullanıcı işlemi.
+ */
+typedef matrix (*async_fn)(void *ctx);
+
+/**
+ * @brief Önceki sonucu alıp yeni bir matrix üreten zincir adımı.
+ * input yalnızca çağrı süresince geçerlidir; saklanacaksa __share_matrix
+ * veya __copy_matrix kullanılmalıdır.
+ */
+typedef matrix (*future_then_fn)(matrix input, void *ctx);
+
+/**
+ * @brief Girdiler gönderim anında __share_matrix ile anlık görüntü olarak
+ * alınır (kopyalanmaz). Çağıran, işlem sürerken kendi tutamacını
+ * _ptr fonksiyonlarıyla değiştirebilir veya serbest bırakabilir;
+ * değişiklik yazma sırasında kopya alınmasına yol açar.
+ */
+matrix_future *__async_multiplication(matrix *matx1, matrix *matx2);
+matrix_future *__async_sum(matrix *matx1, matrix *matx2);
+matrix_future *__async_substract(matrix *matx1, matrix *matx2);
+matrix_future *__async_scalar_multiplication(matrix *matx, float scalar);
+matrix_future *__async_transpose(matrix *matx);
+matrix_future *__async_power(matrix *matx, unsigned int pow);
+
+/**
+ * @brief Kullanıcı işlemini arka planda çalıştırır. fn'in döndürdüğü
+ * matrix future'ın sonucu olur. ctx, future tamamlanana kadar geçerli olmalıdır.
+ *
+ * @param fn
+ * @param ctx
+ * @return matrix_future*
+ */
+matrix_future *__async_submit(async_fn fn, void *ctx);
+
+/**
+ * @brief future tamamlanınca sonucunu fn'e veren yeni bir future döndürür.
+ * future başarısız olursa (sonuç MATRIX_UNDEFINED) fn çağrılmaz ve yeni
+ * future da başarısız olur. future ayrıca __future_free ile bırakılabilir.
+ *
+ * @param future
+ * @param fn
+ * @param ctx
+ * @return matrix_future*
+ */
+matrix_future *__future_then(matrix_future *future, future_then_fn fn, void *ctx);
+
+/**
+ * @brief Beklemeden sonucun hazır olup olmadığını döndürür.
+ *
+ * @param future
+ * @return bool
+ */
+bool __future_ready(matrix_future *future);
+
+/**
+ * @brief Sonuç hazır olana kadar bekler.
+ *
+ * Dönen matrix sonucu paylaşan bir tutamaçtır ve __free_matrix ile
+ * bırakılmalıdır. İşlem başarısızsa MATRIX_UNDEFINED döner.
+ *
+ * @param future
+ * @return matrix
+ */
+matrix __future_wait(matrix_future *future);
+
+/**
+ * @brief Future'ı bırakır. İşlem sürüyorsa arka planda tamamlanır,
+ * sonucu kimse kullanmıyorsa serbest bırakılır.
+ *
+ * @param future
+ */
+void __future_free(matrix_future *future);
+
+/**
+ * @brief Arka plan yürütücü thread sayısını belirler.
+ *
+ * 0 verilirse CMATRIX_ASYNC_EXECUTORS ortam değişkeni, o da yoksa
+ * parallel_threads() kullanılır. Yürütücüler ilk gönderimde başlatılır ve
+ * sayıları __async_shutdown'a kadar değişmez; yeni değer bir sonraki
+ * başlatmada geçerli olur. Ağır işlemler içeride thread havuzunu da kullanır,
+ * havuz meşgulken seri çalışırlar.
+ *
+ * @param executors
+ */
+void __async_set_executors(unsigned int executors);
+
+/**
+ * @brief Çalışan ya da bir sonraki gönderimde başlatılacak yürütücü sayısı.
+ *
+ * @return unsigned int
+ */
+unsigned int __async_executors(void);
+
+/**
+ * @brief Kuyruktaki tüm işlerin bitmesini bekler ve yürütücü thread'leri
+ * durdurur. Sonraki bir gönderim yürütücüleri yeniden başlatır.
+ */
+void __async_shutdown(void);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,422 @@
+#include <stdlib.h>
+#include <string.h>
+
+//
+//      VBATCH.C
+//  Aynı boyutlu çok sayıda küçük
+//  matrixin toplu çarpımı
+//
+#include "vbatch.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği çarpma-toplam sayısı.
+ */
+#define BATCH_CHUNK 32768
+
+const matrix_batch BATCH_UNDEFINED = {0, 0, 0, 0, 0, NULL, false};
+
+matrix_batch __allocate_batch(MX count, MX row, MX col)
+{
+    matrix_batch b = {count, row, col, col, (size_t)row * col, NULL, true};
+    size_t size = (size_t)count * b.stride;
+
+    b.data = (float *)MEMORY_ALLOC_ALIGNED((size > 0 ? size : 1) * sizeof(float));
+
+    __allocation_err(b.data, "Matrix batch");
+
+    memset(b.data, 0, size * sizeof(float));
+
+    return b;
+}
+
+matrix_batch __batch_from_buffer(float *data, MX count, MX row, MX col, MX ld, size_t stride)
+{
+    if (ld == 0)
+    {
+        ld = col;
+    }
+
+    if (data == NULL || ld < col || (stride != 0 && stride < (size_t)(row > 0 ? row - 1 : 0) * ld + col))
+    {
+        printf("\n\nDimention Error batch from buffer function\n\n");
+        return BATCH_UNDEFINED;
+    }
+
+    matrix_batch b = {count, row, col, ld, stride, data, false};
+
+    return b;
+}
+
+void __free_batch(matrix_batch *batch)
+{
+    if (batch->owned && batch->data != NULL)
+    {
+        memory_free_aligned(batch->data);
+    }
+
+    *batch = BATCH_UNDEFINED;
+}
+
+matrix __batch_matrix(matrix_batch batch, MX index)
+{
+    if (batch.data == NULL || index >= batch.count)
+    {
+        printf("\n\nDimention Error batch matrix function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    return __matrix_from_buffer(batch.data + (size_t)index * batch.stride, batch.row, batch.col, batch.ld);
+}
+
+/**
+ * @brief Tek bir matrixin çarpımı: C = A . B.
+ *
+ * 4 satır birlikte işlenir; B'nin her SIMD_WIDTH'lik parçası bir kez
+ * yüklenip 4 satırın birikecine eklenir. Ara tampon veya transpoze yoktur.
+ */
+static void batch_kernel_rows(const float *A, MX lda, const float *B, MX ldb, float *C, MX ldc,
+                              MX m, MX k, MX n)
+{
+    for (MX i = 0; i < m; i += 4)
+    {
+        MX r = m - i < 4 ? m - i : 4;
+        const float *a0 = A + (size_t)i * lda;
+        const float *a1 = r > 1 ? a0 + lda : a0;
+        const float *a2 = r > 2 ? a0 + 2 * (size_t)lda : a0;
+        const float *a3 = r > 3 ? a0 + 3 * (size_t)lda : a0;
+        float *c0 = C + (size_t)i * ldc;
+        MX j = 0;
+
+#if SIMD_WIDTH > 1
+        for (; j + SIMD_WIDTH <= n; j += SIMD_WIDTH)
+        {
+            simd_f s0 = simd_zero(), s1 = simd_zero(), s2 = simd_zero(), s3 = simd_zero();
+
+            for (MX t = 0; t < k; t++)
+            {
+                simd_f vb = simd_loadu(B + (size_t)t * ldb + j);
+
+                s0 = simd_fmaddv(simd_set1(a0[t]), vb, s0);
+                s1 = simd_fmaddv(simd_set1(a1[t]), vb, s1);
+                s2 = simd_fmaddv(simd_set1(a2[t]), vb, s2);
+                s3 = simd_fmaddv(simd_set1(a3[t]), vb, s3);
+            }
+
+            simd_storeu(c0 + j, s0);
+            if (r > 1)
+                simd_storeu(c0 + ldc + j, s1);
+            if (r > 2)
+                simd_storeu(c0 + 2 * (size_t)ldc + j, s2);
+            if (r > 3)
+                simd_storeu(c0 + 3 * (size_t)ldc + j, s3);
+        }
+#endif
+
+        for (; j < n; j++)
+        {
+            float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
+
+            for (MX t = 0; t < k; t++)
+            {
+                float b = B[(size_t)t * ldb + j];
+
+                s0 += a0[t] * b;
+                s1 += a1[t] * b;
+                s2 += a2[t] * b;
+                s3 += a3[t] * b;
+            }
+
+            c0[j] = s0;
+            if (r > 1)
+                c0[ldc + j] = s1;
+            if (r > 2)
+                c0[2 * (size_t)ldc + j] = s2;
+            if (r > 3)
+                c0[3 * (size_t)ldc + j] = s3;
+        }
+    }
+}
+
+#if SIMD_WIDTH > 1
+
+/**
+ * @brief SIMD_WIDTH matrixlik bir grubu (first..first+lanes-1) ara tamponda
+ * birleştirir: elemanın şerit l'deki değeri first + l. matrixe aittir.
+ * Eksik şeritler sıfırla doldurulur.
+ */
+static void batch_interleave(float *dst, const float *src, size_t stride, MX ld, MX row, MX col,
+                             MX first, MX lanes)
+{
+    for (MX l = 0; l < SIMD_WIDTH; l++)
+    {
+        if (l >= lanes)
+        {
+            for (size_t e = 0; e < (size_t)row * col; e++)
+            {
+                dst[e * SIMD_WIDTH + l] = 0.0f;
+            }
+            continue;
+        }
+
+        const float *s = src + (size_t)(first + l) * stride;
+
+        for (MX i = 0; i < row; i++)
+        {
+            for (MX j = 0; j < col; j++)
+            {
+                dst[((size_t)i * col + j) * SIMD_WIDTH + l] = s[(size_t)i * ld + j];
+            }
+        }
+    }
+}
+
+/**
+ * @brief SIMD_WIDTH küçük matrixin çarpımı birlikte: her fmadd her şeritte
+ * farklı bir matrix için aynı (i, t, j) terimini ekler. Sütun sayısı
+ * SIMD_WIDTH'ten küçük olduğunda satır çekirdeği şeritleri boş bırakırdı.
+ *
+ * scratch hizalı ve (m k + k n + m n) SIMD_WIDTH float büyüklüğündedir.
+ */
+static void batch_kernel_interleaved(matrix_batch A, matrix_batch B, matrix_batch C,
+                                     MX first, float *scratch)
+{
+    MX m = A.row, k = A.col, n = B.col;
+    MX lanes = C.count - first < SIMD_WIDTH ? C.count - first : SIMD_WIDTH;
+    float *ai = scratch;
+    float *bi = ai + (size_t)m * k * SIMD_WIDTH;
+    float *ci = bi + (size_t)k * n * SIMD_WIDTH;
+
+    batch_interleave(ai, A.data, A.count == 1 ? 0 : A.stride, A.ld, m, k, first, lanes);
+    batch_interleave(bi, B.data, B.count == 1 ? 0 : B.stride, B.ld, k, n, first, lanes);
+
+    for (MX i = 0; i < m; i++)
+    {
+        const float *arow = ai + (size_t)i * k * SIMD_WIDTH;
+        float *crow = ci + (size_t)i * n * SIMD_WIDTH;
+        MX j = 0;
+
+        for (; j + 4 <= n; j += 4)
+        {
+            simd_f s0 = simd_zero(), s1 = simd_zero(), s2 = simd_zero(), s3 = simd_zero();
+
+            for (MX t = 0; t < k; t++)
+            {
+                simd_f va = simd_load(arow + (size_t)t * SIMD_WIDTH);
+                const float *b = bi + ((size_t)t * n + j) * SIMD_WIDTH;
+
+                s0 = simd_fmaddv(va, simd_load(b), s0);
+                s1 = simd_fmaddv(va, simd_load(b + SIMD_WIDTH), s1);
+                s2 = simd_fmaddv(va, simd_load(b + 2 * SIMD_WIDTH), s2);
+                s3 = simd_fmaddv(va, simd_load(b + 3 * SIMD_WIDTH), s3);
+            }
+
+            simd_store(crow + (size_t)j * SIMD_WIDTH, s0);
+            simd_store(crow + (size_t)(j + 1) * SIMD_WIDTH, s1);
+            simd_store(crow + (size_t)(j + 2) * SIMD_WIDTH, s2);
+            simd_store(crow + (size_t)(j + 3) * SIMD_WIDTH, s3);
+        }
+
+        for (; j < n; j++)
+        {
+            simd_f s = simd_zero();
+
+            for (MX t = 0; t < k; t++)
+            {
+                s = simd_fmaddv(simd_load(arow + (size_t)t * SIMD_WIDTH),
+                                simd_load(bi + ((size_t)t * n + j) * SIMD_WIDTH), s);
+            }
+
+            simd_store(crow + (size_t)j * SIMD_WIDTH, s);
+        }
+    }
+
+    for (MX l = 0; l < lanes; l++)
+    {
+        float *d = C.data + (size_t)(first + l) * C.stride;
+
+        for (MX i = 0; i < m; i++)
+        {
+            for (MX j = 0; j < n; j++)
+            {
+                d[(size_t)i * C.ld + j] = ci[((size_t)i * n + j) * SIMD_WIDTH + l];
+            }
+        }
+    }
+}
+
+#endif
+
+/**
+ * @brief Küçük matrixler şeritlere dağıtılabilecek kadar dar mı.
+ */
+static bool batch_interleaved(batch_group g)
+{
+#if SIMD_WIDTH > 1
+    return g.B.col < SIMD_WIDTH && g.C.count > 1;
+#else
+    (void)g;
+    return false;
+#endif
+}
+
+/**
+ * @brief Grubun iş birimi sayısı: şeritli çekirdekte SIMD_WIDTH, diğerinde 1 matrix.
+ */
+static unsigned long batch_units(batch_group g)
+{
+    return batch_interleaved(g) ? (g.C.count + SIMD_WIDTH - 1) / SIMD_WIDTH : g.C.count;
+}
+
+/**
+ * @brief Okunan ve yazılan bayt sayısı; tek matrixli (count = 1) taraflar bir kez sayılır.
+ */
+static inline unsigned long long batch_moved(const batch_group *groups, MX count)
+{
+    unsigned long long moved = 0;
+
+    for (MX g = 0; g < count; g++)
+    {
+        moved += (unsigned long long)groups[g].A.count * groups[g].A.row * groups[g].A.col +
+                 (unsigned long long)groups[g].B.count * groups[g].B.row * groups[g].B.col +
+                 (unsigned long long)groups[g].C.count * groups[g].C.row * groups[g].C.col;
+    }
+
+    return moved * sizeof(float);
+}
+
+typedef struct
+{
+    batch_group *groups;
+    MX count;
+
+    /* groups[g]'nin ilk iş biriminin genel indeksi; count + 1 eleman */
+    unsigned long *offset;
+
+    float *scratch;
+    size_t scratch_size;
+
+} batch_ctx;
+
+static void batch_run(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    batch_ctx *c = (batch_ctx *)arg;
+    MX g = 0;
+
+    while (c->offset[g + 1] <= begin)
+    {
+        g++;
+    }
+
+    for (unsigned long u = begin; u < end; u++)
+    {
+        while (c->offset[g + 1] <= u)
+        {
+            g++;
+        }
+
+        batch_group grp = c->groups[g];
+        MX index = (MX)(u - c->offset[g]);
+
+#if SIMD_WIDTH > 1
+        if (batch_interleaved(grp))
+        {
+            batch_kernel_interleaved(grp.A, grp.B, grp.C, index * SIMD_WIDTH,
+                                     c->scratch + (size_t)worker * c->scratch_size);
+            continue;
+        }
+#else
+        (void)worker;
+#endif
+
+        batch_kernel_rows(grp.A.data + (grp.A.count == 1 ? 0 : (size_t)index * grp.A.stride), grp.A.ld,
+                          grp.B.data + (grp.B.count == 1 ? 0 : (size_t)index * grp.B.stride), grp.B.ld,
+                          grp.C.data + (size_t)index * grp.C.stride, grp.C.ld,
+                          grp.A.row, grp.A.col, grp.B.col);
+    }
+}
+
+bool __batch_multiplication_grouped(batch_group *groups, MX count)
+{
+    for (MX g = 0; g < count; g++)
+    {
+        batch_group grp = groups[g];
+
+        if (grp.A.col != grp.B.row || grp.C.row != grp.A.row || grp.C.col != grp.B.col ||
+            (grp.A.count != grp.C.count && grp.A.count != 1) ||
+            (grp.B.count != grp.C.count && grp.B.count != 1) ||
+            (grp.C.count > 1 && grp.C.stride == 0) ||
+            (grp.C.count > 0 && (grp.A.data == NULL || grp.B.data == NULL || grp.C.data == NULL)))
+        {
+            printf("\n\nDimention Error batch multiplication function\n\n");
+            return false;
+        }
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_BATCH);
+
+    batch_ctx ctx = {groups, count, NULL, NULL, 0};
+    unsigned long long flops = 0;
+    size_t scratch = 0;
+
+    ctx.offset = (unsigned long *)MEMORY_ALLOC(((size_t)count + 1) * sizeof(unsigned long));
+
+    __allocation_err(ctx.offset, "Batch offsets");
+
+    ctx.offset[0] = 0;
+
+    for (MX g = 0; g < count; g++)
+    {
+        batch_group grp = groups[g];
+
+        ctx.offset[g + 1] = ctx.offset[g] + batch_units(grp);
+        flops += (unsigned long long)grp.C.count * grp.A.row * grp.A.col * grp.B.col;
+
+        if (batch_interleaved(grp))
+        {
+            size_t need = ((size_t)grp.A.row * grp.A.col + (size_t)grp.B.row * grp.B.col +
+                           (size_t)grp.C.row * grp.C.col) * SIMD_WIDTH;
+
+            scratch = need > scratch ? need : scratch;
+        }
+    }
+
+    unsigned long units = ctx.offset[count];
+
+    if (units > 0)
+    {
+        if (scratch > 0)
+        {
+            ctx.scratch_size = scratch;
+            ctx.scratch = (float *)MEMORY_ALLOC_ALIGNED((size_t)parallel_threads() * scratch * sizeof(float));
+
+            __allocation_err(ctx.scratch, "Batch scratch");
+        }
+
+        unsigned long long unit_work = flops / units + 1;
+
+        parallel_for(0, units, unit_work >= BATCH_CHUNK ? 1 : (unsigned long)(BATCH_CHUNK / unit_work),
+                     batch_run, &ctx);
+
+        if (ctx.scratch != NULL)
+        {
+            memory_free_aligned(ctx.scratch);
+        }
+    }
+
+    memory_free(ctx.offset);
+
+    PROFILE_END(PROFILE_MATRIX_BATCH, 2ull * flops, batch_moved(groups, count));
+
+    return true;
+}
+
+bool __batch_multiplication(matrix_batch A, matrix_batch B, matrix_batch *C)
+{
+    batch_group g = {A, B, *C};
+
+    return __batch_multiplication_grouped(&g, 1);
+}
\ No newline at end of file
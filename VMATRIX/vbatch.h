@@ -0,0 +1,106 @@
+#include <stddef.h>
+
+#include "vmatrix.h"
+
+#ifndef VBATCH_H
+#define VBATCH_H
+
+/**
+ * @brief Aynı boyutlu matrixlerin tek parça tampondaki dizisi.
+ *
+ * index. matrixin (i, j) elemanı data[index * stride + i * ld + j] adresindedir.
+ * Küçük matrixler için her çarpımda tahsis ve transpoze yapılmaz.
+ */
+typedef struct
+{
+    MX count;
+    MX row;
+    MX col;
+
+    /* Satır adımı ve ardışık iki matrix arası adım (float cinsinden) */
+    MX ld;
+    size_t stride;
+
+    float *data;
+
+    /* __allocate_batch ile ayrıldıysa true; __batch_from_buffer görünümlerinde false */
+    bool owned;
+
+} matrix_batch;
+
+extern const matrix_batch BATCH_UNDEFINED;
+
+/**
+ * @brief count adet row x col matrix için sıfırlanmış, dolgusuz tampon.
+ *
+ * @param count
+ * @param row
+ * @param col
+ * @return matrix_batch
+ */
+matrix_batch __allocate_batch(MX count, MX row, MX col);
+
+/**
+ * @brief Çağıranın tamponunu kopyalamadan batch olarak kullanır.
+ *
+ * stride = 0 tek bir matrixin tüm batch için tekrar kullanılmasını sağlar
+ * (ör. tüm A'lar aynı B ile çarpılırken).
+ *
+ * @param data
+ * @param count
+ * @param row
+ * @param col
+ * @param ld Satır adımı; 0 ise col
+ * @param stride Matrixler arası adım; ld * row'dan küçükse yalnızca 0 olabilir
+ * @return matrix_batch
+ */
+matrix_batch __batch_from_buffer(float *data, MX count, MX row, MX col, MX ld, size_t stride);
+
+void __free_batch(matrix_batch *batch);
+
+/**
+ * @brief index. matrixin kopyalanmamış görünümü (__free_matrix ile bırakılır).
+ *
+ * @param batch
+ * @param index
+ * @return matrix
+ */
+matrix __batch_matrix(matrix_batch batch, MX index);
+
+/**
+ * @brief C[b] = A[b] . B[b], b = 0..C->count-1.
+ *
+ * A veya B'nin count değeri 1 ise o matrix tüm batch için kullanılır.
+ * Küçük matrixler (sütun sayısı SIMD genişliğinden az) SIMD şeritlerine
+ * birer matrix düşecek şekilde birlikte işlenir; diğerlerinde her matrix
+ * 4 satırlık yazmaç blokları ile çarpılır. Matrixler thread'lere dağıtılır.
+ *
+ * @param A
+ * @param B
+ * @param C Önceden ayrılmış
+ * @return bool Boyutlar uymuyorsa false
+ */
+bool __batch_multiplication(matrix_batch A, matrix_batch B, matrix_batch *C);
+
+/**
+ * @brief Farklı boyutlu batch'lerin çarpımındaki bir grup.
+ */
+typedef struct
+{
+    matrix_batch A;
+    matrix_batch B;
+    matrix_batch C;
+
+} batch_group;
+
+/**
+ * @brief Tüm grupları tek bir paralel iş olarak hesaplar; küçük gruplar
+ * thread'leri boşta bırakmaz.
+ *
+ * @param groups
+ * @param count
+ * @return bool Herhangi bir grubun boyutları uymuyorsa false (hiçbiri hesaplanmaz)
+ */
+bool __batch_multiplication_grouped(batch_group *groups, MX count);
+
+#endif
\ No newline at end of file
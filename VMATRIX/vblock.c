@@ -0,0 +1,307 @@
+#include <stdlib.h>
+#include <string.h>
+
+//
+//      VBLOCK.C
+//  Kronecker çarpımı, blok matrix birleştirme
+//  ve oluşturulmayan Kronecker işleci
+//
+#include "vblock.h"
+#include "vkernel.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği kopyalanan eleman sayısı.
+ */
+#define BLOCK_CHUNK 65536
+
+typedef struct
+{
+    const matrix *A;
+    const matrix *B;
+    matrix *C;
+
+} kron_ctx;
+
+static void kron_rows(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    kron_ctx *c = (kron_ctx *)arg;
+    const MX br = c->B->row, bc = c->B->col;
+    (void)worker;
+
+    for (MX r = (MX)begin; r < (MX)end; r++)
+    {
+        const float *a = c->A->vrows[r / br]->elements;
+        const float *b = c->B->vrows[r % br]->elements;
+        float *dst = c->C->vrows[r]->elements;
+
+        for (MX j = 0; j < c->A->col; j++)
+        {
+            simd_scale(dst + (size_t)j * bc, b, a[j], bc);
+        }
+    }
+}
+
+matrix __kron_matrix(matrix A, matrix B)
+{
+    if (A.vrows == NULL || B.vrows == NULL)
+    {
+        printf("\n\nDimention Error kron function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_KRON);
+
+    matrix C = __allocate_row_vectors(A.row * B.row, A.col * B.col);
+    kron_ctx ctx = {&A, &B, &C};
+
+    parallel_for(0, C.row, C.col >= BLOCK_CHUNK ? 1 : BLOCK_CHUNK / (C.col + 1), kron_rows, &ctx);
+
+    PROFILE_END(PROFILE_MATRIX_KRON, (unsigned long long)C.row * C.col,
+                ((unsigned long long)C.row * C.col + (unsigned long long)A.row * A.col + (unsigned long long)B.row * B.col) * sizeof(float));
+
+    return C;
+}
+
+typedef struct
+{
+    const matrix *blocks;
+    MX block_rows;
+    MX block_cols;
+
+    /* Blok satır / sütun başlangıçları, block_rows + 1 ve block_cols + 1 eleman */
+    const MX *row_off;
+    const MX *col_off;
+
+    matrix *C;
+
+} block_ctx;
+
+static void block_rows_copy(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    block_ctx *c = (block_ctx *)arg;
+    MX bi = 0;
+    (void)worker;
+
+    for (MX r = (MX)begin; r < (MX)end; r++)
+    {
+        // Satırın düştüğü blok satırı (boş blok satırları atlanır)
+        while (c->row_off[bi + 1] <= r)
+        {
+            bi++;
+        }
+
+        const matrix *src = c->blocks + (size_t)bi * c->block_cols;
+        const MX local = r - c->row_off[bi];
+        float *dst = c->C->vrows[r]->elements;
+
+        for (MX bj = 0; bj < c->block_cols; bj++)
+        {
+            const MX width = c->col_off[bj + 1] - c->col_off[bj];
+
+            if (src[bj].flags & MATRIX_ZERO_BLOCK)
+            {
+                memset(dst + c->col_off[bj], 0, width * sizeof(float));
+            }
+            else
+            {
+                memcpy(dst + c->col_off[bj], src[bj].vrows[local]->elements, width * sizeof(float));
+            }
+        }
+    }
+}
+
+matrix __block_matrix(const matrix *blocks, MX block_rows, MX block_cols)
+{
+    if (blocks == NULL || block_rows == 0 || block_cols == 0)
+    {
+        printf("\n\nDimention Error block function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    MX *row_off = (MX *)MEMORY_ALLOC((block_rows + block_cols + 2) * sizeof(MX));
+    MX *col_off = row_off + block_rows + 1;
+    bool *seen_col = (bool *)MEMORY_ALLOC(block_cols * sizeof(bool));
+
+    __allocation_err(row_off, "Block offsets");
+    __allocation_err(seen_col, "Block offsets");
+
+    memset(seen_col, 0, block_cols * sizeof(bool));
+    row_off[0] = 0;
+    col_off[0] = 0;
+
+    // Boyutlar bir kez toplanır; her blok kendi satır ve sütunuyla uyuşmalıdır
+    for (MX bi = 0; bi < block_rows; bi++)
+    {
+        bool seen_row = false;
+        MX height = 0;
+
+        for (MX bj = 0; bj < block_cols; bj++)
+        {
+            const matrix *b = blocks + (size_t)bi * block_cols + bj;
+            const bool zero = (b->flags & MATRIX_ZERO_BLOCK) != 0;
+
+            // Hata dönen bir işlemin sonucu sessizce sıfıra dönüşmez
+            if (b->vrows == NULL && !zero)
+            {
+                printf("\n\nBlock (%u, %u) is UNDEFINED\n\n", bi, bj);
+                memory_free(seen_col);
+                memory_free(row_off);
+                return MATRIX_UNDEFINED;
+            }
+
+            // Sıfır bloğun 0 verilen boyutları diğer bloklardan alınır
+            const bool has_row = !zero || b->row > 0;
+            const bool has_col = !zero || b->col > 0;
+
+            if ((has_row && seen_row && b->row != height) || (has_col && seen_col[bj] && b->col != col_off[bj + 1]))
+            {
+                printf("\n\nDimention Error block function\n\n");
+                memory_free(seen_col);
+                memory_free(row_off);
+                return MATRIX_UNDEFINED;
+            }
+
+            if (has_row)
+            {
+                seen_row = true;
+                height = b->row;
+            }
+            if (has_col)
+            {
+                seen_col[bj] = true;
+                col_off[bj + 1] = b->col;
+            }
+        }
+
+        if (!seen_row)
+        {
+            printf("\n\nDimention Error block function\n\n");
+            memory_free(seen_col);
+            memory_free(row_off);
+            return MATRIX_UNDEFINED;
+        }
+
+        row_off[bi + 1] = row_off[bi] + height;
+    }
+
+    for (MX bj = 0; bj < block_cols; bj++)
+    {
+        if (!seen_col[bj])
+        {
+            printf("\n\nDimention Error block function\n\n");
+            memory_free(seen_col);
+            memory_free(row_off);
+            return MATRIX_UNDEFINED;
+        }
+
+        col_off[bj + 1] += col_off[bj];
+    }
+
+    memory_free(seen_col);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_BLOCK);
+
+    matrix C = __allocate_row_vectors(row_off[block_rows], col_off[block_cols]);
+    block_ctx ctx = {blocks, block_rows, block_cols, row_off, col_off, &C};
+
+    parallel_for(0, C.row, C.col >= BLOCK_CHUNK ? 1 : BLOCK_CHUNK / (C.col + 1), block_rows_copy, &ctx);
+
+    memory_free(row_off);
+
+    PROFILE_END(PROFILE_MATRIX_BLOCK, 0, 2ull * C.row * C.col * sizeof(float));
+
+    return C;
+}
+
+matrix __zero_block(MX row, MX col)
+{
+    matrix zero = MATRIX_UNDEFINED;
+
+    zero.row = row;
+    zero.col = col;
+    zero.flags = MATRIX_ZERO_BLOCK;
+
+    return zero;
+}
+
+matrix __hstack_matrix(const matrix *parts, MX count)
+{
+    return __block_matrix(parts, 1, count);
+}
+
+matrix __vstack_matrix(const matrix *parts, MX count)
+{
+    return __block_matrix(parts, count, 1);
+}
+
+kron_operator __kron_operator(matrix A, matrix B)
+{
+    kron_operator K = {A, B, A.row * B.row, A.col * B.col};
+
+    return K;
+}
+
+vec __kron_matvec(kron_operator K, vec x)
+{
+    if (x.dim != K.col || K.A.vrows == NULL || K.B.vrows == NULL)
+    {
+        printf("\n\nDimention Error kron matvec function\n\n");
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_KRON_MATVEC);
+
+    const MX ar = K.A.row, ac = K.A.col, br = K.B.row, bc = K.B.col;
+    vec y = allocate_vector_mem(K.row);
+
+    if (K.row == 0 || K.col == 0)
+    {
+        if (K.row > 0)
+        {
+            memset(y.elements, 0, K.row * sizeof(float));
+        }
+
+        PROFILE_END(PROFILE_KRON_MATVEC, 0, 0);
+        return y;
+    }
+
+    // x = vec(X), X: ac x bc ve y = vec(A X B^T), Y: ar x br
+    matrix X = __matrix_from_buffer(x.elements, ac, bc, 0);
+    matrix Y = __matrix_from_buffer(y.elements, ar, br, 0);
+
+    unsigned long long right = (unsigned long long)ac * br * (bc + ar);
+    unsigned long long left = (unsigned long long)ar * bc * (ac + br);
+
+    if (right <= left)
+    {
+        // T^T = B X^T (br x ac), Y = A T
+        matrix Tt = __allocate_row_vectors(br, ac);
+
+        __dot_rows_matrix(K.B, X, &Tt);
+        __dot_rows_matrix(K.A, Tt, &Y);
+        __free_matrix(&Tt);
+    }
+    else
+    {
+        // S = A X (ar x bc), Y = S B^T
+        matrix Xt = __transpose_matrix(X);
+        matrix S = __allocate_row_vectors(ar, bc);
+
+        __dot_rows_matrix(K.A, Xt, &S);
+        __dot_rows_matrix(S, K.B, &Y);
+        __free_matrix(&S);
+        __free_matrix(&Xt);
+    }
+
+    __free_matrix(&X);
+    __free_matrix(&Y);
+
+    PROFILE_END(PROFILE_KRON_MATVEC, 2ull * (right <= left ? right : left),
+                ((unsigned long long)ar * ac + (unsigned long long)br * bc + K.row + K.col) * sizeof(float));
+
+    return y;
+}
\ No newline at end of file
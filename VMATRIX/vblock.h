@@ -0,0 +1,87 @@
+#include "vmatrix.h"
+#include "../CMATH/vec.h"
+
+#ifndef VBLOCK_H
+#define VBLOCK_H
+
+/**
+ * @brief Kronecker çarpımı A (x) B, (A.row B.row) x (A.col B.col).
+ *
+ * Sonuç tek seferde ayrılır; (i, k) satırı A[i][j] B_k parçalarının
+ * SIMD ile ölçeklenip yan yana yazılmasıyla doldurulur.
+ *
+ * @param A
+ * @param B
+ * @return matrix
+ */
+matrix __kron_matrix(matrix A, matrix B);
+
+/**
+ * @brief Blok matrix [[B_00, B_01, ...], [B_10, ...], ...].
+ *
+ * blocks satır sıralı block_rows x block_cols dizidir. Aynı blok satırındaki
+ * blokların satır sayıları, aynı blok sütunundakilerin sütun sayıları eşit
+ * olmalıdır. Sıfır bloklar __zero_block ile verilir. Boyut bir kez hesaplanır,
+ * sonuç bir kez ayrılır ve her kaynak satırı tek memcpy ile kopyalanır.
+ *
+ * @param blocks
+ * @param block_rows
+ * @param block_cols
+ * @return matrix Bir blok MATRIX_UNDEFINED ise (ör. önceki bir işlem hata
+ * verdiyse) veya boyutlar uyuşmuyorsa MATRIX_UNDEFINED
+ */
+matrix __block_matrix(const matrix *blocks, MX block_rows, MX block_cols);
+
+/**
+ * @brief __block_matrix için row x col sıfır blok; bellek ayırmaz ve
+ * serbest bırakılması gerekmez.
+ *
+ * row veya col 0 ise o boyut aynı blok satırındaki / sütunundaki diğer
+ * bloklardan alınır.
+ *
+ * @param row
+ * @param col
+ * @return matrix
+ */
+matrix __zero_block(MX row, MX col);
+
+/**
+ * @brief Yan yana [A_0, A_1, ...] ve alt alta [A_0; A_1; ...] birleştirme.
+ *
+ * @param parts
+ * @param count
+ * @return matrix
+ */
+matrix __hstack_matrix(const matrix *parts, MX count);
+matrix __vstack_matrix(const matrix *parts, MX count);
+
+/**
+ * @brief A (x) B'yi oluşturmadan kullanan işleç; A ve B kopyalanmaz,
+ * işleç kullanıldığı sürece geçerli kalmalıdır.
+ */
+typedef struct
+{
+    matrix A;
+    matrix B;
+    MX row;
+    MX col;
+
+} kron_operator;
+
+kron_operator __kron_operator(matrix A, matrix B);
+
+/**
+ * @brief y = (A (x) B) x.
+ *
+ * x satır sıralı A.col x B.col bir X olarak görülür ve y = vec(A X B^T)
+ * iki çarpımla hesaplanır: O(A.row A.col B.row + ...) işlem ve
+ * O(A.col B.row) ek bellek; (A.row B.row) x (A.col B.col) matrix hiç
+ * oluşturulmaz. Çarpım sırası daha ucuz olana göre seçilir.
+ *
+ * @param K
+ * @param x K.col boyutlu
+ * @return vec K.row boyutlu
+ */
+vec __kron_matvec(kron_operator K, vec x);
+
+#endif
\ No newline at end of file
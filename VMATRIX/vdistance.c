@@ -0,0 +1,246 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//
+//      VDISTANCE.C
+//  Satır kümeleri arasındaki uzaklık
+//     ve benzerlik matrixleri
+//
+#include "vdistance.h"
+#include "vkernel.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief İç çarpımları hesaplanıp hemen dönüştürülen X satırı sayısı.
+ * Bu satırların sonuçları dönüştürme sırasında hala önbellekte olur.
+ */
+#define PAIRWISE_TILE 64
+
+/**
+ * @brief Ölçü bir benzerlik ise true döner.
+ *
+ * @param metric
+ * @return bool
+ */
+bool __pairwise_is_similarity(pairwise_metric metric)
+{
+    return metric == PAIRWISE_COSINE_SIMILARITY || metric == PAIRWISE_DOT;
+}
+
+/**
+ * @brief Tek bir satırın kare normu.
+ */
+static float row_norm_squared(const matrix *matx, MX i)
+{
+    const float *row = matx->vrows[i]->elements;
+
+    return (matx->flags & MATRIX_ALIGNED) ? simd_dot_a(row, row, matx->col)
+                                          : simd_dot(row, row, matx->col);
+}
+
+/**
+ * @brief Her satırın kare normunu hesaplar.
+ *
+ * @param matx
+ * @return vec
+ */
+vec __row_norms_squared(matrix matx)
+{
+    vec norms = allocate_vector_mem(matx.row);
+
+    for (MX i = 0; i < matx.row; i++)
+    {
+        norms.elements[i] = row_norm_squared(&matx, i);
+    }
+
+    return norms;
+}
+
+/**
+ * @brief Kosinüs için normların tersleri (norm 0 ise 0).
+ */
+static float *inverse_norms(vec norms_squared, MX begin, MX end)
+{
+    float *inv = (float *)MEMORY_ALLOC((end - begin) * sizeof(float));
+
+    __allocation_err(inv, "Inverse norms");
+
+    for (MX i = begin; i < end; i++)
+    {
+        float n = norms_squared.elements[i];
+        inv[i - begin] = n > 0.0f ? 1.0f / sqrtf(n) : 0.0f;
+    }
+
+    return inv;
+}
+
+typedef struct
+{
+    const matrix *X;
+    const matrix *Y;
+    MX x_begin;
+    MX x_end;
+
+    /* X'in tüm satırlarının kare normları; NULL ise satır işlenirken hesaplanır */
+    const float *x_norms;
+    const float *y_norms;
+    const float *inv_y;
+
+    pairwise_metric metric;
+    matrix *out;
+
+} pairwise_ctx;
+
+/**
+ * @brief [begin, end) numaralı PAIRWISE_TILE satırlık X parçaları.
+ */
+static void pairwise_tiles(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    pairwise_ctx *c = (pairwise_ctx *)arg;
+    const pairwise_metric metric = c->metric;
+    const MX n = c->Y->row;
+    (void)worker;
+
+    for (unsigned long t = begin; t < end; t++)
+    {
+        MX tile = c->x_begin + (MX)t * PAIRWISE_TILE;
+        MX tile_end = c->x_end - tile > PAIRWISE_TILE ? tile + PAIRWISE_TILE : c->x_end;
+
+        // Önce x.y değerleri sonuç satırlarına yazılır
+        __dot_rows_block(*c->X, tile, tile_end, *c->Y, 0, n,
+                         c->out->vrows[tile - c->x_begin]->elements, c->out->ld);
+
+        // Sonra aynı satırlar önbellekteyken ölçüye dönüştürülür
+        for (MX i = tile; i < tile_end; i++)
+        {
+            float *row = c->out->vrows[i - c->x_begin]->elements;
+
+            if (metric == PAIRWISE_DOT)
+            {
+                continue;
+            }
+
+            const float xn = c->x_norms != NULL ? c->x_norms[i] : row_norm_squared(c->X, i);
+
+            switch (metric)
+            {
+            case PAIRWISE_EUCLIDEAN:
+            case PAIRWISE_SQEUCLIDEAN:
+            {
+                const float *yn = c->y_norms;
+
+                for (MX j = 0; j < n; j++)
+                {
+                    // Yuvarlama hatası küçük negatif değerler üretebilir
+                    float d = xn + yn[j] - 2.0f * row[j];
+                    row[j] = d > 0.0f ? d : 0.0f;
+                }
+
+                if (metric == PAIRWISE_EUCLIDEAN)
+                {
+                    for (MX j = 0; j < n; j++)
+                    {
+                        row[j] = sqrtf(row[j]);
+                    }
+                }
+                break;
+            }
+            case PAIRWISE_COSINE:
+            case PAIRWISE_COSINE_SIMILARITY:
+            {
+                const float xi = xn > 0.0f ? 1.0f / sqrtf(xn) : 0.0f;
+                const float *inv_y = c->inv_y;
+
+                for (MX j = 0; j < n; j++)
+                {
+                    float s = row[j] * xi * inv_y[j];
+                    row[j] = metric == PAIRWISE_COSINE ? 1.0f - s : s;
+                }
+                break;
+            }
+            case PAIRWISE_DOT:
+            default:
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief X'in [x_begin, x_end) satırları için uzaklıklar.
+ */
+bool __pairwise_distance_block(matrix X, MX x_begin, MX x_end, matrix Y,
+                               vec x_norms, vec y_norms, pairwise_metric metric, matrix *out)
+{
+    if (X.col != Y.col || x_begin > x_end || x_end > X.row)
+    {
+        printf("\n\nDimention Error pairwise distance function\n\n");
+        return false;
+    }
+
+    if (out->row != x_end - x_begin || out->col != Y.row || !(out->flags & MATRIX_CONTIGUOUS))
+    {
+        printf("\n\nPairwise distance output must be a %u x %u matrix\n\n", x_end - x_begin, Y.row);
+        return false;
+    }
+
+    __unshare_matrix(out);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_PAIRWISE);
+
+    const MX n = Y.row;
+    bool need_norms = metric != PAIRWISE_DOT;
+
+    // Verilmeyen Y normları burada, X normları yalnızca parçanın satırları için hesaplanır
+    vec own_y = VEC_UNDEFINED;
+
+    if (need_norms && y_norms.dim != Y.row)
+    {
+        own_y = __row_norms_squared(Y);
+        y_norms = own_y;
+    }
+
+    bool cosine = metric == PAIRWISE_COSINE || metric == PAIRWISE_COSINE_SIMILARITY;
+    float *inv_y = cosine ? inverse_norms(y_norms, 0, n) : NULL;
+
+    pairwise_ctx ctx = {&X, &Y, x_begin, x_end,
+                        need_norms && x_norms.dim == X.row ? x_norms.elements : NULL,
+                        y_norms.elements, inv_y, metric, out};
+
+    parallel_for(0, (x_end - x_begin + PAIRWISE_TILE - 1) / PAIRWISE_TILE, 1, pairwise_tiles, &ctx);
+
+    memory_free(inv_y);
+    free_vector(&own_y);
+
+    PROFILE_END(PROFILE_MATRIX_PAIRWISE, 2ull * (x_end - x_begin) * n * X.col,
+                ((unsigned long long)(x_end - x_begin) * X.col + (unsigned long long)n * X.col +
+                 (unsigned long long)(x_end - x_begin) * n) * sizeof(float));
+
+    return true;
+}
+
+/**
+ * @brief X ve Y satırları arasındaki uzaklık matrixi.
+ */
+matrix __pairwise_distance(matrix X, matrix Y, pairwise_metric metric)
+{
+    if (X.col != Y.col)
+    {
+        printf("\n\nDimention Error pairwise distance function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = __allocate_row_vectors(X.row, Y.row);
+
+    if (!__pairwise_distance_block(X, 0, X.row, Y, VEC_UNDEFINED, VEC_UNDEFINED, metric, &ret_matrix))
+    {
+        __free_matrix(&ret_matrix);
+        return MATRIX_UNDEFINED;
+    }
+
+    return ret_matrix;
+}
\ No newline at end of file
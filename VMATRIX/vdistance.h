@@ -0,0 +1,79 @@
+#include "vmatrix.h"
+#include "../CMATH/vec.h"
+
+#ifndef VDISTANCE_H
+#define VDISTANCE_H
+
+/**
+ * @brief İki satır kümesi arasında hesaplanacak ölçü.
+ *
+ * PAIRWISE_EUCLIDEAN         : ||x - y||
+ * PAIRWISE_SQEUCLIDEAN       : ||x - y||^2
+ * PAIRWISE_COSINE            : 1 - cos(x, y)   (uzaklık)
+ * PAIRWISE_COSINE_SIMILARITY : cos(x, y)       (benzerlik)
+ * PAIRWISE_DOT               : x . y           (benzerlik)
+ *
+ * Normu 0 olan satırlar için cos(x, y) = 0 kabul edilir.
+ */
+typedef enum
+{
+    PAIRWISE_EUCLIDEAN,
+    PAIRWISE_SQEUCLIDEAN,
+    PAIRWISE_COSINE,
+    PAIRWISE_COSINE_SIMILARITY,
+    PAIRWISE_DOT
+
+} pairwise_metric;
+
+/**
+ * @brief Ölçü bir benzerlik ise (büyük değer daha yakın) true döner.
+ *
+ * @param metric
+ * @return bool
+ */
+bool __pairwise_is_similarity(pairwise_metric metric);
+
+/**
+ * @brief Her satırın kare normunu (||x_i||^2) hesaplar.
+ *
+ * @param matx
+ * @return vec matx.row boyutlu vektör
+ */
+vec __row_norms_squared(matrix matx);
+
+/**
+ * @brief X (N x D) ve Y (M x D) satırları arasındaki N x M uzaklık matrixi.
+ *
+ * ||x - y||^2 = ||x||^2 + ||y||^2 - 2 x.y açılımı kullanılır; iç çarpımlar
+ * __multiplication_matrix ile aynı bloklu çekirdekte hesaplanır ve fark
+ * vektörü hiç oluşturulmaz.
+ *
+ * @param X
+ * @param Y
+ * @param metric
+ * @return matrix
+ */
+matrix __pairwise_distance(matrix X, matrix Y, pairwise_metric metric);
+
+/**
+ * @brief X'in [x_begin, x_end) satırları için uzaklıkları önceden ayrılmış out matrixine yazar.
+ *
+ * Sonuç matrixi belleğe sığmayacak kadar büyükse (1M x 10k gibi) X
+ * parça parça işlenir; normlar bir kez hesaplanıp her parçada tekrar kullanılır.
+ * x_norms verilmezse yalnızca [x_begin, x_end) satırlarınınki hesaplanır.
+ * Parçanın satırları 64 satırlık gruplar halinde parallel_for ile dağıtılır.
+ *
+ * @param X
+ * @param x_begin
+ * @param x_end
+ * @param Y
+ * @param x_norms __row_norms_squared(X) veya hesaplanması için VEC_UNDEFINED
+ * @param y_norms __row_norms_squared(Y) veya hesaplanması için VEC_UNDEFINED
+ * @param metric
+ * @param out (x_end - x_begin) x Y.row boyutunda, __allocate_row_vectors ile ayrılmış matrix
+ * @return bool Boyutlar uyuşmazsa false
+ */
+bool __pairwise_distance_block(matrix X, MX x_begin, MX x_end, matrix Y,
+                               vec x_norms, vec y_norms, pairwise_metric metric, matrix *out);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,452 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//
+//      VEXPM.C
+//  Matrix üsteli, matrix polinomları
+//  ve doğrusal sistem çözümü
+//
+#include "vexpm.h"
+#include "vkernel.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği çarpma-toplam sayısı.
+ */
+#define EXPM_CHUNK 32768
+
+/**
+ * @brief Geri yerine koymada bir görevin aldığı sağ taraf sütunu.
+ */
+#define SOLVE_COL_BLOCK 64
+
+/**
+ * @brief Tek duyarlıkta (u = 2^-24) 3, 5 ve 7. dereceden Padé yaklaşımlarının
+ * geri hatası u'nun altında kalan en büyük ||A||_1 (Higham, 2005).
+ */
+static const double expm_theta[3] = {4.258730016922831e-1, 1.880152677804762, 3.925724783138660};
+
+/**
+ * @brief Padé katsayıları b_0..b_m; tek indisli olanlar U'ya, çift indisli olanlar V'ye girer.
+ */
+static const float pade3[4] = {120.0f, 60.0f, 12.0f, 1.0f};
+static const float pade5[6] = {30240.0f, 15120.0f, 3360.0f, 420.0f, 30.0f, 1.0f};
+static const float pade7[8] = {17297280.0f, 8648640.0f, 1995840.0f, 277200.0f, 25200.0f, 1512.0f, 56.0f, 1.0f};
+
+typedef struct
+{
+    matrix *out;
+    const matrix *terms;
+    const float *coef;
+    MX count;
+    float diag;
+    bool accumulate;
+
+} combine_ctx;
+
+static void combine_rows(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    combine_ctx *c = (combine_ctx *)arg;
+    MX n = c->out->col;
+    (void)worker;
+
+    for (MX i = (MX)begin; i < (MX)end; i++)
+    {
+        float *o = c->out->vrows[i]->elements;
+        MX k = 0;
+
+        if (!c->accumulate)
+        {
+            if (c->count > 0)
+            {
+                simd_scale(o, c->terms[0].vrows[i]->elements, c->coef[0], n);
+                k = 1;
+            }
+            else
+            {
+                memset(o, 0, n * sizeof(float));
+            }
+        }
+
+        for (; k < c->count; k++)
+        {
+            simd_axpy(o, c->terms[k].vrows[i]->elements, c->coef[k], n);
+        }
+
+        o[i] += c->diag;
+    }
+}
+
+/**
+ * @brief out = sum_k coef[k] terms[k] + diag I (accumulate ise out'a eklenir).
+ * Ara matrix oluşturulmaz; her satır bir kez yazılır.
+ */
+static void matrix_combine(matrix *out, const matrix *terms, const float *coef, MX count, float diag, bool accumulate)
+{
+    combine_ctx ctx = {out, terms, coef, count, diag, accumulate};
+    unsigned long row_work = (unsigned long)out->col * (count + 1) + 1;
+
+    parallel_for(0, out->row, row_work >= EXPM_CHUNK ? 1 : EXPM_CHUNK / row_work, combine_rows, &ctx);
+}
+
+/**
+ * @brief R = R . R, tampon ayırmadan: R^T, Rt'ye yazılır ve çarpım tmp'ye alınıp takas edilir.
+ */
+static void matrix_square(matrix *R, matrix *Rt, matrix *tmp)
+{
+    __transpose_matrix_into(*R, Rt);
+    __dot_rows_matrix(*R, *Rt, tmp);
+
+    matrix swap = *R;
+    *R = *tmp;
+    *tmp = swap;
+}
+
+typedef struct
+{
+    matrix *LU;
+    matrix *X;
+    MX k;
+
+} solve_ctx;
+
+/**
+ * @brief Pivot satırı k'nın altındaki satırlardan çıkarılır (hem A hem de sağ taraf).
+ */
+static void solve_eliminate(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    solve_ctx *c = (solve_ctx *)arg;
+    MX k = c->k, n = c->LU->col, m = c->X->col;
+    const float *pivot = c->LU->vrows[k]->elements;
+    const float *x_pivot = c->X->vrows[k]->elements;
+    (void)worker;
+
+    for (MX i = (MX)begin; i < (MX)end; i++)
+    {
+        float *row = c->LU->vrows[i]->elements;
+        float l = row[k] / pivot[k];
+
+        if (l != 0.0f)
+        {
+            row[k] = 0.0f;
+            simd_axpy(row + k + 1, pivot + k + 1, -l, n - k - 1);
+            simd_axpy(c->X->vrows[i]->elements, x_pivot, -l, m);
+        }
+    }
+}
+
+/**
+ * @brief Üst üçgen U ile geri yerine koyma, sağ tarafın [begin, end) sütun blokları.
+ */
+static void solve_backward(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    solve_ctx *c = (solve_ctx *)arg;
+    MX n = c->LU->col;
+    MX c0 = (MX)begin * SOLVE_COL_BLOCK;
+    MX c1 = (MX)end * SOLVE_COL_BLOCK < c->X->col ? (MX)end * SOLVE_COL_BLOCK : c->X->col;
+    (void)worker;
+
+    for (MX i = n; i-- > 0;)
+    {
+        const float *u = c->LU->vrows[i]->elements;
+        float *x = c->X->vrows[i]->elements + c0;
+
+        for (MX j = i + 1; j < n; j++)
+        {
+            if (u[j] != 0.0f)
+            {
+                simd_axpy(x, c->X->vrows[j]->elements + c0, -u[j], c1 - c0);
+            }
+        }
+
+        simd_scale(x, x, 1.0f / u[i], c1 - c0);
+    }
+}
+
+matrix __solve_matrix(matrix A, matrix B)
+{
+    if (A.row != A.col || B.row != A.row)
+    {
+        printf("\n\nDimention Error solve function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_SOLVE);
+
+    const MX n = A.row, m = B.col;
+    matrix LU = __copy_matrix(A);
+    matrix X = __copy_matrix(B);
+    solve_ctx ctx = {&LU, &X, 0};
+    float *swap = (float *)MEMORY_ALLOC(((n > m ? n : m) + 1) * sizeof(float));
+
+    __allocation_err(swap, "Solve pivot");
+
+    for (MX k = 0; k < n; k++)
+    {
+        // Kısmi pivot: k. sütunda mutlak değeri en büyük satır
+        MX p = k;
+        float best = fabsf(LU.vrows[k]->elements[k]);
+
+        for (MX i = k + 1; i < n; i++)
+        {
+            float v = fabsf(LU.vrows[i]->elements[k]);
+
+            if (v > best)
+            {
+                best = v;
+                p = i;
+            }
+        }
+
+        if (best == 0.0f || !isfinite(best))
+        {
+            memory_free(swap);
+            __free_matrix(&LU);
+            __free_matrix(&X);
+            PROFILE_END(PROFILE_MATRIX_SOLVE, 0, 0);
+            return MATRIX_UNDEFINED;
+        }
+
+        if (p != k)
+        {
+            memcpy(swap, LU.vrows[k]->elements, n * sizeof(float));
+            memcpy(LU.vrows[k]->elements, LU.vrows[p]->elements, n * sizeof(float));
+            memcpy(LU.vrows[p]->elements, swap, n * sizeof(float));
+
+            memcpy(swap, X.vrows[k]->elements, m * sizeof(float));
+            memcpy(X.vrows[k]->elements, X.vrows[p]->elements, m * sizeof(float));
+            memcpy(X.vrows[p]->elements, swap, m * sizeof(float));
+        }
+
+        unsigned long row_work = (unsigned long)(n - k) + m;
+
+        ctx.k = k;
+        parallel_for(k + 1, n, row_work >= EXPM_CHUNK ? 1 : EXPM_CHUNK / row_work, solve_eliminate, &ctx);
+    }
+
+    parallel_for(0, (m + SOLVE_COL_BLOCK - 1) / SOLVE_COL_BLOCK, 1, solve_backward, &ctx);
+
+    memory_free(swap);
+    __free_matrix(&LU);
+
+    PROFILE_END(PROFILE_MATRIX_SOLVE, 2ull * n * n * n / 3 + 2ull * n * n * m,
+                ((unsigned long long)n * n + 2ull * n * m) * sizeof(float));
+
+    return X;
+}
+
+matrix __polynomial_matrix(matrix A, const float *coeffs, MX count)
+{
+    if (A.row != A.col || count == 0 || coeffs == NULL)
+    {
+        printf("\n\nDimention Error polynomial function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_POLYNOMIAL);
+
+    const MX n = A.row;
+    matrix P = __allocate_row_vectors(n, n);
+
+    if (count == 1)
+    {
+        matrix_combine(&P, NULL, NULL, 0, coeffs[0], false);
+        PROFILE_END(PROFILE_MATRIX_POLYNOMIAL, 0, (unsigned long long)n * n * sizeof(float));
+        return P;
+    }
+
+    // s ~ sqrt(derece): A^1..A^s bir kez, sonra r = (count - 1) / s Horner adımı
+    MX s = (MX)ceil(sqrt((double)count));
+    s = s > count - 1 ? count - 1 : s;
+
+    MX r = (count - 1) / s;
+    matrix *powers = (matrix *)MEMORY_ALLOC((s + 1) * sizeof(matrix));
+
+    __allocation_err(powers, "Polynomial powers");
+
+    powers[1] = A;
+
+    for (MX p = 2; p <= s; p++)
+    {
+        powers[p] = __multiplication_matrix(powers[p - 1], A);
+    }
+
+    // En yüksek blok: c[r s] I + c[r s + 1] A + ... (count'u aşmayan terimler)
+    MX last = count - 1 - r * s;
+
+    matrix_combine(&P, powers + 1, coeffs + r * s + 1, last, coeffs[r * s], false);
+
+    if (r > 0)
+    {
+        matrix Ast = __transpose_matrix(powers[s]);
+        matrix T = __allocate_row_vectors(n, n);
+
+        for (MX j = r; j-- > 0;)
+        {
+            // P = P . A^s + c[j s] I + ... + c[j s + s - 1] A^(s - 1)
+            __dot_rows_matrix(P, Ast, &T);
+            matrix_combine(&T, powers + 1, coeffs + j * s + 1, s - 1, coeffs[j * s], true);
+
+            matrix swap = P;
+            P = T;
+            T = swap;
+        }
+
+        __free_matrix(&T);
+        __free_matrix(&Ast);
+    }
+
+    for (MX p = 2; p <= s; p++)
+    {
+        __free_matrix(&powers[p]);
+    }
+
+    memory_free(powers);
+
+    PROFILE_END(PROFILE_MATRIX_POLYNOMIAL, 2ull * (s - 1 + r) * n * n * n + 2ull * count * n * n,
+                (unsigned long long)(s + 2) * n * n * sizeof(float));
+
+    return P;
+}
+
+/**
+ * @brief ||A||_1: sütun mutlak toplamlarının en büyüğü.
+ */
+static double matrix_norm1(matrix A)
+{
+    double *sums = (double *)MEMORY_ALLOC((A.col > 0 ? A.col : 1) * sizeof(double));
+    double norm = 0.0;
+
+    __allocation_err(sums, "Matrix norm");
+
+    memset(sums, 0, A.col * sizeof(double));
+
+    for (MX i = 0; i < A.row; i++)
+    {
+        const float *row = A.vrows[i]->elements;
+
+        for (MX j = 0; j < A.col; j++)
+        {
+            sums[j] += fabsf(row[j]);
+        }
+    }
+
+    for (MX j = 0; j < A.col; j++)
+    {
+        norm = sums[j] > norm ? sums[j] : norm;
+    }
+
+    memory_free(sums);
+
+    return norm;
+}
+
+matrix __expm_scaled(matrix A, float t)
+{
+    if (A.row != A.col || A.row == 0)
+    {
+        printf("\n\nDimention Error expm function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_EXPM);
+
+    const MX n = A.row;
+    double norm = fabs((double)t) * matrix_norm1(A);
+
+    if (norm == 0.0)
+    {
+        PROFILE_END(PROFILE_MATRIX_EXPM, 0, (unsigned long long)n * n * sizeof(float));
+        return __identity_matrix(n, n);
+    }
+
+    // Padé derecesi ve ölçekleme: ||2^-s t A||_1 <= theta_7
+    const float *b = norm <= expm_theta[0] ? pade3 : (norm <= expm_theta[1] ? pade5 : pade7);
+    MX half = norm <= expm_theta[0] ? 1 : (norm <= expm_theta[1] ? 2 : 3);
+    int s = norm > expm_theta[2] ? (int)ceil(log2(norm / expm_theta[2])) : 0;
+
+    matrix X = __scalar_multiplication(A, ldexpf(t, -s));
+
+    // Çift kuvvetler A^2, A^4, A^6
+    matrix even[3];
+
+    even[0] = __multiplication_matrix(X, X);
+
+    for (MX k = 1; k < half; k++)
+    {
+        even[k] = __multiplication_matrix(even[k - 1], even[0]);
+    }
+
+    float odd_coef[3], even_coef[3];
+
+    for (MX k = 0; k < half; k++)
+    {
+        odd_coef[k] = b[2 * k + 3];
+        even_coef[k] = b[2 * k + 2];
+    }
+
+    // U = X (b_1 I + b_3 A^2 + ...), V = b_0 I + b_2 A^2 + ...
+    matrix W = __allocate_row_vectors(n, n);
+    matrix V = __allocate_row_vectors(n, n);
+
+    matrix_combine(&W, even, odd_coef, half, b[1], false);
+    matrix_combine(&V, even, even_coef, half, b[0], false);
+
+    matrix U = __multiplication_matrix(X, W);
+
+    // (V - U) R = (V + U)
+    for (MX i = 0; i < n; i++)
+    {
+        float *v = V.vrows[i]->elements;
+        float *u = U.vrows[i]->elements;
+
+        for (MX j = 0; j < n; j++)
+        {
+            float p = v[j] + u[j];
+
+            u[j] = v[j] - u[j];
+            v[j] = p;
+        }
+    }
+
+    matrix R = __solve_matrix(U, V);
+
+    __free_matrix(&X);
+    __free_matrix(&W);
+    __free_matrix(&U);
+    __free_matrix(&V);
+
+    for (MX k = 0; k < half; k++)
+    {
+        __free_matrix(&even[k]);
+    }
+
+    if (R.vrows != NULL && s > 0)
+    {
+        // Karesini alma: iki tampon ve bir transpoze tamponu yeniden kullanılır
+        matrix Rt = __allocate_row_vectors(n, n);
+        matrix T = __allocate_row_vectors(n, n);
+
+        for (int k = 0; k < s; k++)
+        {
+            matrix_square(&R, &Rt, &T);
+        }
+
+        __free_matrix(&Rt);
+        __free_matrix(&T);
+    }
+
+    PROFILE_END(PROFILE_MATRIX_EXPM, 2ull * (half + 1 + s) * n * n * n + 8ull * n * n * n / 3,
+                (unsigned long long)(half + 5) * n * n * sizeof(float));
+
+    return R;
+}
+
+matrix __expm(matrix A)
+{
+    return __expm_scaled(A, 1.0f);
+}
\ No newline at end of file
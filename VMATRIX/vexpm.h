@@ -0,0 +1,54 @@
+#include "vmatrix.h"
+
+#ifndef VEXPM_H
+#define VEXPM_H
+
+/**
+ * @brief A . X = B sistemini çözer (kısmi pivotlu Gauss eliminasyonu).
+ *
+ * A ve B değişmez; satır işlemleri kopyalar üzerinde SIMD ile yapılır.
+ *
+ * @param A n x n
+ * @param B n x m
+ * @return matrix X, A tekilse MATRIX_UNDEFINED
+ */
+matrix __solve_matrix(matrix A, matrix B);
+
+/**
+ * @brief c[0] I + c[1] A + ... + c[count - 1] A^(count - 1).
+ *
+ * Paterson-Stockmeyer: s ~ sqrt(count) için A^2..A^s bir kez hesaplanır,
+ * polinom A^s cinsinden Horner yöntemiyle değerlendirilir. Çarpım sayısı
+ * count - 2 yerine yaklaşık 2 sqrt(count) olur; Horner adımları iki tampon
+ * arasında gidip gelir.
+ *
+ * @param A Kare matrix
+ * @param coeffs
+ * @param count Katsayı sayısı (derece + 1)
+ * @return matrix
+ */
+matrix __polynomial_matrix(matrix A, const float *coeffs, MX count);
+
+/**
+ * @brief Matrix üsteli e^A.
+ *
+ * Ölçekle ve karesini al: ||A||_1 tek duyarlık için seçilen theta_m
+ * sınırına göre 3, 5 veya 7. dereceden Padé yaklaşımı kullanılır; sınır
+ * aşılırsa A 2^s ile bölünür ve sonucun s kez karesi alınır
+ * (Higham, 2005). Padé kesri tek bir doğrusal sistem çözümüyle bulunur.
+ *
+ * @param A Kare matrix
+ * @return matrix
+ */
+matrix __expm(matrix A);
+
+/**
+ * @brief e^(t A); t A ayrıca oluşturulmaz (ör. Markov zinciri geçişleri e^(tQ)).
+ *
+ * @param A Kare matrix
+ * @param t
+ * @return matrix
+ */
+matrix __expm_scaled(matrix A, float t);
+
+#endif
\ No newline at end of file
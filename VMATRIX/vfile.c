@@ -0,0 +1,673 @@
+#define _FILE_OFFSET_BITS 64
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <pthread.h>
+
+//
+//      VFILE.C
+//  Diskteki matrix dosyaları ve
+//   bellekten büyük çarpımlar
+//
+#include "vfile.h"
+#include "vkernel.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+#ifdef _WIN32
+#define file_seek _fseeki64
+#else
+#define file_seek fseeko
+#endif
+
+#define MATRIX_FILE_MAGIC 0x54414d56u /* "VMAT" */
+#define MATRIX_FILE_VERSION 1u
+#define MATRIX_FILE_HEADER 16
+
+/**
+ * @brief Parça kenarlarının yuvarlandığı kat ve en küçük değeri.
+ */
+#define FILE_TILE_ALIGN 16
+
+struct matrix_file
+{
+    FILE *fp;
+
+    /* Okuyucu ve yazıcı thread'ler aynı dosyayı kullanabilir */
+    pthread_mutex_t lock;
+
+    /* Bir sonraki okuma/yazmanın konumu; gereksiz seek yapılmaz */
+    long long pos;
+
+    bool writable;
+    bool last_write;
+
+    MX row;
+    MX col;
+};
+
+static matrix_file *file_new(FILE *fp, MX row, MX col, bool writable)
+{
+    matrix_file *f = (matrix_file *)MEMORY_ALLOC(sizeof(matrix_file));
+
+    __allocation_err(f, "Matrix file");
+
+    f->fp = fp;
+    pthread_mutex_init(&f->lock, NULL);
+    f->pos = -1;
+    f->writable = writable;
+    f->last_write = false;
+    f->row = row;
+    f->col = col;
+
+    return f;
+}
+
+matrix_file *__create_matrix_file(const char *path, MX row, MX col)
+{
+    FILE *fp = fopen(path, "w+b");
+
+    if (fp == NULL)
+    {
+        printf("\n\nCannot create matrix file %s\n\n", path);
+        return NULL;
+    }
+
+    uint32_t header[4] = {MATRIX_FILE_MAGIC, MATRIX_FILE_VERSION, row, col};
+    long long size = MATRIX_FILE_HEADER + (long long)row * col * (long long)sizeof(float);
+    bool ok = fwrite(header, sizeof(header), 1, fp) == 1;
+
+    // Dosya son bayt yazılarak tam boyuta getirilir; aradaki bölge sıfır okunur
+    if (ok && size > MATRIX_FILE_HEADER)
+    {
+        unsigned char zero = 0;
+        ok = file_seek(fp, size - 1, SEEK_SET) == 0 && fwrite(&zero, 1, 1, fp) == 1;
+    }
+
+    if (!ok || fflush(fp) != 0)
+    {
+        printf("\n\nCannot create matrix file %s\n\n", path);
+        fclose(fp);
+        return NULL;
+    }
+
+    return file_new(fp, row, col, true);
+}
+
+matrix_file *__open_matrix_file(const char *path, bool writable)
+{
+    FILE *fp = fopen(path, writable ? "r+b" : "rb");
+
+    if (fp == NULL)
+    {
+        printf("\n\nCannot open matrix file %s\n\n", path);
+        return NULL;
+    }
+
+    uint32_t header[4];
+
+    if (fread(header, sizeof(header), 1, fp) != 1 ||
+        header[0] != MATRIX_FILE_MAGIC || header[1] != MATRIX_FILE_VERSION)
+    {
+        printf("\n\n%s is not a matrix file\n\n", path);
+        fclose(fp);
+        return NULL;
+    }
+
+    return file_new(fp, header[2], header[3], writable);
+}
+
+void __close_matrix_file(matrix_file *file)
+{
+    if (file == NULL)
+    {
+        return;
+    }
+
+    fclose(file->fp);
+    pthread_mutex_destroy(&file->lock);
+    memory_free(file);
+}
+
+void __matrix_file_shape(const matrix_file *file, MX *row, MX *col)
+{
+    *row = file->row;
+    *col = file->col;
+}
+
+/**
+ * @brief Dosyada tile bölgesinin satırlarını okur veya yazar.
+ */
+static bool file_transfer(matrix_file *file, MX r0, MX c0, matrix *tile, bool write)
+{
+    if ((unsigned long long)r0 + tile->row > file->row || (unsigned long long)c0 + tile->col > file->col)
+    {
+        printf("\n\nDimention Error matrix file tile\n\n");
+        return false;
+    }
+
+    if (write && !file->writable)
+    {
+        printf("\n\nMatrix file is read only\n\n");
+        return false;
+    }
+
+    bool ok = true;
+
+    pthread_mutex_lock(&file->lock);
+
+    for (MX i = 0; i < tile->row && ok; i++)
+    {
+        long long offset = MATRIX_FILE_HEADER + ((long long)(r0 + i) * file->col + c0) * (long long)sizeof(float);
+
+        // Okuma ile yazma arasında geçişte stdio seek ister
+        if (offset != file->pos || write != file->last_write)
+        {
+            ok = file_seek(file->fp, offset, SEEK_SET) == 0;
+        }
+
+        if (ok)
+        {
+            float *row = tile->vrows[i]->elements;
+
+            ok = write ? fwrite(row, sizeof(float), tile->col, file->fp) == tile->col
+                       : fread(row, sizeof(float), tile->col, file->fp) == tile->col;
+        }
+
+        file->pos = ok ? offset + (long long)tile->col * (long long)sizeof(float) : -1;
+        file->last_write = write;
+    }
+
+    pthread_mutex_unlock(&file->lock);
+
+    if (!ok)
+    {
+        printf(write ? "\n\nMatrix file write failed\n\n" : "\n\nMatrix file read failed\n\n");
+    }
+
+    return ok;
+}
+
+bool __read_matrix_tile(matrix_file *file, MX r0, MX c0, matrix *tile)
+{
+    __unshare_matrix(tile);
+
+    return file_transfer(file, r0, c0, tile, false);
+}
+
+bool __write_matrix_tile(matrix_file *file, MX r0, MX c0, matrix tile)
+{
+    return file_transfer(file, r0, c0, &tile, true);
+}
+
+bool __save_matrix_file(matrix matx, const char *path)
+{
+    matrix_file *file = __create_matrix_file(path, matx.row, matx.col);
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    bool ok = __write_matrix_tile(file, 0, 0, matx) && fflush(file->fp) == 0;
+
+    __close_matrix_file(file);
+
+    return ok;
+}
+
+matrix __load_matrix_file(const char *path)
+{
+    matrix_file *file = __open_matrix_file(path, false);
+
+    if (file == NULL)
+    {
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = __allocate_row_vectors(file->row, file->col);
+
+    if (!__read_matrix_tile(file, 0, 0, &ret_matrix))
+    {
+        __free_matrix(&ret_matrix);
+        ret_matrix = MATRIX_UNDEFINED;
+    }
+
+    __close_matrix_file(file);
+
+    return ret_matrix;
+}
+
+/**
+ * @brief Tam boyutlu bir parça tamponunun sol üst row x col bölümü.
+ * Satırlar tamponu paylaşır; dolgu sıfır olmayabileceğinden MATRIX_PADDED kaldırılır.
+ */
+static matrix tile_view(matrix buffer, MX row, MX col)
+{
+    matrix view = buffer;
+
+    view.row = row;
+    view.col = col;
+    view.flags &= ~MATRIX_PADDED;
+
+    return view;
+}
+
+/**
+ * @brief Okuyucu, hesaplayan ve yazıcı thread'lerin paylaştığı çarpım durumu.
+ *
+ * Adım s, C parçası (ti, tj) için k parçası tk'dır; s = (ti * nj + tj) * nk + tk.
+ * A ve B^T parçaları ile C parçaları ikişer tamponla dönüşümlü kullanılır.
+ */
+typedef struct
+{
+    matrix_file *A;
+    matrix_file *B;
+    matrix_file *C;
+
+    MX tm, tn, tk;
+    MX ni, nj, nk;
+    unsigned long long steps;
+
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+
+    matrix a[2];
+    matrix bt[2];
+    bool loaded[2];
+
+    /* Okuyucunun B parçasını transpoze etmeden önce okuduğu tampon */
+    matrix stage;
+
+    matrix c[2];
+    bool pending[2];
+
+    /* k üzerinden toplamada ara sonuç */
+    matrix partial;
+
+    bool failed;
+
+} file_gemm;
+
+static void gemm_fail(file_gemm *g)
+{
+    pthread_mutex_lock(&g->lock);
+    g->failed = true;
+    pthread_cond_broadcast(&g->changed);
+    pthread_mutex_unlock(&g->lock);
+}
+
+static MX tile_extent(MX index, MX tile, MX total)
+{
+    return total - index * tile < tile ? total - index * tile : tile;
+}
+
+/**
+ * @brief Okuyucu: adımların A ve B^T parçalarını hesaplamanın bir adım önünden getirir.
+ */
+static void *gemm_reader(void *arg)
+{
+    file_gemm *g = (file_gemm *)arg;
+
+    for (unsigned long long s = 0; s < g->steps; s++)
+    {
+        int slot = (int)(s & 1);
+
+        pthread_mutex_lock(&g->lock);
+
+        while (g->loaded[slot] && !g->failed)
+        {
+            pthread_cond_wait(&g->changed, &g->lock);
+        }
+
+        bool failed = g->failed;
+
+        pthread_mutex_unlock(&g->lock);
+
+        if (failed)
+        {
+            break;
+        }
+
+        MX tk = (MX)(s % g->nk);
+        unsigned long long tile = s / g->nk;
+        MX ti = (MX)(tile / g->nj), tj = (MX)(tile % g->nj);
+
+        MX rows = tile_extent(ti, g->tm, g->A->row);
+        MX cols = tile_extent(tj, g->tn, g->B->col);
+        MX depth = tile_extent(tk, g->tk, g->A->col);
+
+        matrix a = tile_view(g->a[slot], rows, depth);
+        matrix stage = tile_view(g->stage, depth, cols);
+        matrix bt = tile_view(g->bt[slot], cols, depth);
+
+        bool ok = file_transfer(g->A, ti * g->tm, tk * g->tk, &a, false) &&
+                  file_transfer(g->B, tk * g->tk, tj * g->tn, &stage, false) &&
+                  __transpose_matrix_into(stage, &bt);
+
+        if (!ok)
+        {
+            gemm_fail(g);
+            break;
+        }
+
+        pthread_mutex_lock(&g->lock);
+        g->loaded[slot] = true;
+        pthread_cond_broadcast(&g->changed);
+        pthread_mutex_unlock(&g->lock);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Yazıcı: biten C parçalarını sırayla dosyaya yazar.
+ */
+static void *gemm_writer(void *arg)
+{
+    file_gemm *g = (file_gemm *)arg;
+    unsigned long long tiles = (unsigned long long)g->ni * g->nj;
+
+    for (unsigned long long t = 0; t < tiles; t++)
+    {
+        int slot = (int)(t & 1);
+
+        pthread_mutex_lock(&g->lock);
+
+        while (!g->pending[slot] && !g->failed)
+        {
+            pthread_cond_wait(&g->changed, &g->lock);
+        }
+
+        bool failed = g->failed;
+
+        pthread_mutex_unlock(&g->lock);
+
+        if (failed)
+        {
+            break;
+        }
+
+        MX ti = (MX)(t / g->nj), tj = (MX)(t % g->nj);
+        matrix c = tile_view(g->c[slot], tile_extent(ti, g->tm, g->C->row), tile_extent(tj, g->tn, g->C->col));
+
+        if (!file_transfer(g->C, ti * g->tm, tj * g->tn, &c, true))
+        {
+            gemm_fail(g);
+            break;
+        }
+
+        pthread_mutex_lock(&g->lock);
+        g->pending[slot] = false;
+        pthread_cond_broadcast(&g->changed);
+        pthread_mutex_unlock(&g->lock);
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Hesaplama: çağıran thread'de çalışır, her adımda C parçasına
+ * A . B^T^T ekler. Çarpma çekirdeği thread havuzunu kullanır.
+ */
+static void gemm_compute(file_gemm *g)
+{
+    unsigned long long tiles = (unsigned long long)g->ni * g->nj;
+    unsigned long long s = 0;
+
+    for (unsigned long long t = 0; t < tiles; t++)
+    {
+        int cslot = (int)(t & 1);
+
+        pthread_mutex_lock(&g->lock);
+
+        while (g->pending[cslot] && !g->failed)
+        {
+            pthread_cond_wait(&g->changed, &g->lock);
+        }
+
+        bool failed = g->failed;
+
+        pthread_mutex_unlock(&g->lock);
+
+        if (failed)
+        {
+            return;
+        }
+
+        MX ti = (MX)(t / g->nj), tj = (MX)(t % g->nj);
+        matrix c = tile_view(g->c[cslot], tile_extent(ti, g->tm, g->C->row), tile_extent(tj, g->tn, g->C->col));
+        matrix partial = tile_view(g->partial, c.row, c.col);
+
+        for (MX tk = 0; tk < g->nk; tk++, s++)
+        {
+            int slot = (int)(s & 1);
+
+            pthread_mutex_lock(&g->lock);
+
+            while (!g->loaded[slot] && !g->failed)
+            {
+                pthread_cond_wait(&g->changed, &g->lock);
+            }
+
+            failed = g->failed;
+
+            pthread_mutex_unlock(&g->lock);
+
+            if (failed)
+            {
+                return;
+            }
+
+            MX depth = tile_extent(tk, g->tk, g->A->col);
+            matrix a = tile_view(g->a[slot], c.row, depth);
+            matrix bt = tile_view(g->bt[slot], c.col, depth);
+
+            if (tk == 0)
+            {
+                __dot_rows_matrix(a, bt, &c);
+            }
+            else
+            {
+                __dot_rows_matrix(a, bt, &partial);
+
+                for (MX i = 0; i < c.row; i++)
+                {
+                    simd_add(c.vrows[i]->elements, c.vrows[i]->elements, partial.vrows[i]->elements, c.col);
+                }
+            }
+
+            pthread_mutex_lock(&g->lock);
+            g->loaded[slot] = false;
+            pthread_cond_broadcast(&g->changed);
+            pthread_mutex_unlock(&g->lock);
+        }
+
+        pthread_mutex_lock(&g->lock);
+        g->pending[cslot] = true;
+        pthread_cond_broadcast(&g->changed);
+        pthread_mutex_unlock(&g->lock);
+    }
+}
+
+/**
+ * @brief row x col bir parça tamponunun gerçek boyutu: satır adımı dolgusu
+ * ve satır başlıkları dahil (__allocate_row_vectors ile aynı yerleşim).
+ */
+static size_t gemm_tile_bytes(MX row, MX col)
+{
+    return (size_t)row * __leading_dimension(col) * sizeof(float) + (size_t)row * (sizeof(vec *) + sizeof(vec));
+}
+
+/**
+ * @brief Seçilen parçalarla ayrılacak tüm tamponlar.
+ */
+static size_t gemm_bytes(MX tm, MX tk, MX tn)
+{
+    return 2 * gemm_tile_bytes(tm, tk) + 2 * gemm_tile_bytes(tn, tk) + gemm_tile_bytes(tk, tn) +
+           3 * gemm_tile_bytes(tm, tn);
+}
+
+/**
+ * @brief Kenarı bir hizalama adımı küçültür; en küçük kenarda false.
+ */
+static bool gemm_shrink(MX *edge, MX min_edge)
+{
+    if (*edge <= min_edge)
+    {
+        return false;
+    }
+
+    MX smaller = (*edge - 1) / FILE_TILE_ALIGN * FILE_TILE_ALIGN;
+
+    *edge = smaller > min_edge ? smaller : min_edge;
+
+    return true;
+}
+
+/**
+ * @brief Parça boyutlarını bütçeye göre seçer.
+ *
+ * Bellekte 2 A (tm x tk), 2 B^T ve 1 B (tn x tk), 2 C ve 1 ara sonuç (tm x tn)
+ * tamponu bulunur; kare parçalarla bu 8 t^2 float eder. Kenarlardan biri
+ * matrixten küçük kalırsa artan bütçe k kenarına verilir. Tahmin sonra
+ * dolgu ve satır başlıkları ile birlikte ölçülür ve bütçeye inene kadar en
+ * büyük kenar küçültülür. En küçük parçalar bile sığmazsa false döner.
+ */
+static bool gemm_tiles(file_gemm *g, MX M, MX K, MX N, size_t memory_budget)
+{
+    double floats = (double)memory_budget / sizeof(float);
+    double t = floor(sqrt(floats / 8.0));
+
+    MX edge = t < FILE_TILE_ALIGN ? FILE_TILE_ALIGN : (t > 65536.0 ? 65536u : (MX)t / FILE_TILE_ALIGN * FILE_TILE_ALIGN);
+
+    g->tm = M < edge ? M : edge;
+    g->tn = N < edge ? N : edge;
+
+    double rest = (floats - 3.0 * g->tm * g->tn) / (2.0 * g->tm + 3.0 * g->tn);
+    MX depth = rest < FILE_TILE_ALIGN ? FILE_TILE_ALIGN : (rest > K ? K : (MX)rest / FILE_TILE_ALIGN * FILE_TILE_ALIGN);
+
+    g->tk = K < depth ? K : depth;
+
+    const MX min_m = M < FILE_TILE_ALIGN ? M : FILE_TILE_ALIGN;
+    const MX min_n = N < FILE_TILE_ALIGN ? N : FILE_TILE_ALIGN;
+    const MX min_k = K < FILE_TILE_ALIGN ? K : FILE_TILE_ALIGN;
+
+    while (gemm_bytes(g->tm, g->tk, g->tn) > memory_budget)
+    {
+        MX *largest = g->tk >= g->tm && g->tk >= g->tn ? &g->tk : (g->tm >= g->tn ? &g->tm : &g->tn);
+
+        // Önce en büyük kenar, o en küçükteyse diğerleri küçültülür
+        if (!gemm_shrink(largest, largest == &g->tk ? min_k : (largest == &g->tm ? min_m : min_n)) &&
+            !gemm_shrink(&g->tk, min_k) && !gemm_shrink(&g->tm, min_m) && !gemm_shrink(&g->tn, min_n))
+        {
+            return false;
+        }
+    }
+
+    g->ni = (M + g->tm - 1) / g->tm;
+    g->nj = (N + g->tn - 1) / g->tn;
+    g->nk = (K + g->tk - 1) / g->tk;
+    g->steps = (unsigned long long)g->ni * g->nj * g->nk;
+
+    return true;
+}
+
+bool __multiplication_matrix_file(matrix_file *A, matrix_file *B, matrix_file *C, size_t memory_budget)
+{
+    if (A->col != B->row || C->row != A->row || C->col != B->col)
+    {
+        printf("\n\nDimention Error matrix file multiplication\n\n");
+        return false;
+    }
+
+    if (C == A || C == B || !C->writable)
+    {
+        printf("\n\nMatrix file multiplication needs a separate writable output\n\n");
+        return false;
+    }
+
+    // Boş iç boyutta C sıfırdır; __create_matrix_file dosyayı sıfırla başlatır
+    if (C->row == 0 || C->col == 0 || A->col == 0)
+    {
+        return true;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_FILE_MULTIPLICATION);
+
+    file_gemm g;
+
+    if (!gemm_tiles(&g, A->row, A->col, B->col, memory_budget))
+    {
+        printf("\n\nMemory budget is too small for matrix file multiplication\n\n");
+        PROFILE_END(PROFILE_MATRIX_FILE_MULTIPLICATION, 0, 0);
+        return false;
+    }
+
+    g.A = A;
+    g.B = B;
+    g.C = C;
+    g.failed = false;
+
+    pthread_mutex_init(&g.lock, NULL);
+    pthread_cond_init(&g.changed, NULL);
+
+    for (int i = 0; i < 2; i++)
+    {
+        g.a[i] = __allocate_row_vectors(g.tm, g.tk);
+        g.bt[i] = __allocate_row_vectors(g.tn, g.tk);
+        g.c[i] = __allocate_row_vectors(g.tm, g.tn);
+        g.loaded[i] = false;
+        g.pending[i] = false;
+    }
+
+    g.stage = __allocate_row_vectors(g.tk, g.tn);
+    g.partial = __allocate_row_vectors(g.tm, g.tn);
+
+    pthread_t reader, writer;
+    bool threads = pthread_create(&reader, NULL, gemm_reader, &g) == 0;
+
+    if (threads && pthread_create(&writer, NULL, gemm_writer, &g) != 0)
+    {
+        gemm_fail(&g);
+        pthread_join(reader, NULL);
+        threads = false;
+    }
+
+    if (threads)
+    {
+        gemm_compute(&g);
+
+        pthread_join(reader, NULL);
+        pthread_join(writer, NULL);
+    }
+    else
+    {
+        printf("\n\nCannot start matrix file threads\n\n");
+        g.failed = true;
+    }
+
+    bool ok = !g.failed && fflush(C->fp) == 0;
+
+    for (int i = 0; i < 2; i++)
+    {
+        __free_matrix(&g.a[i]);
+        __free_matrix(&g.bt[i]);
+        __free_matrix(&g.c[i]);
+    }
+
+    __free_matrix(&g.stage);
+    __free_matrix(&g.partial);
+
+    pthread_cond_destroy(&g.changed);
+    pthread_mutex_destroy(&g.lock);
+
+    PROFILE_END(PROFILE_MATRIX_FILE_MULTIPLICATION, 2ull * A->row * A->col * B->col,
+                ((unsigned long long)A->row * A->col * g.nj + (unsigned long long)B->row * B->col * g.ni +
+                 (unsigned long long)C->row * C->col) * sizeof(float));
+
+    return ok;
+}
\ No newline at end of file
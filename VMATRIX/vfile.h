@@ -0,0 +1,96 @@
+#include <stddef.h>
+
+#include "vmatrix.h"
+
+#ifndef VFILE_H
+#define VFILE_H
+
+/**
+ * @brief Diskte tutulan matrix dosyası.
+ *
+ * Dosya 16 baytlık bir başlık ("VMAT", sürüm, satır, sütun) ve ardından
+ * satır satır, dolgusuz float elemanlardan oluşur. Belleğe sığmayan
+ * matrixler parça (tile) parça okunup yazılır.
+ */
+typedef struct matrix_file matrix_file;
+
+/**
+ * @brief row x col boyutlu yeni bir matrix dosyası oluşturur (varsa üzerine yazar).
+ * Elemanlar sıfır olarak başlar; dosya sistemi destekliyorsa yer ayrılmaz.
+ *
+ * @param path
+ * @param row
+ * @param col
+ * @return matrix_file* Hata durumunda NULL
+ */
+matrix_file *__create_matrix_file(const char *path, MX row, MX col);
+
+/**
+ * @brief Var olan bir matrix dosyasını açar.
+ *
+ * @param path
+ * @param writable true ise parçalar yazılabilir
+ * @return matrix_file* Hata durumunda NULL
+ */
+matrix_file *__open_matrix_file(const char *path, bool writable);
+
+void __close_matrix_file(matrix_file *file);
+
+/**
+ * @brief Dosyadaki matrixin boyutları.
+ *
+ * @param file
+ * @param row
+ * @param col
+ */
+void __matrix_file_shape(const matrix_file *file, MX *row, MX *col);
+
+/**
+ * @brief Dosyanın (r0, c0) konumundan başlayan tile->row x tile->col
+ * bölgesini tile'a okur.
+ *
+ * @param file
+ * @param r0
+ * @param c0
+ * @param tile
+ * @return bool Bölge dosyanın dışındaysa veya okuma başarısızsa false
+ */
+bool __read_matrix_tile(matrix_file *file, MX r0, MX c0, matrix *tile);
+
+/**
+ * @brief tile'ı dosyanın (r0, c0) konumuna yazar.
+ *
+ * @param file
+ * @param r0
+ * @param c0
+ * @param tile
+ * @return bool
+ */
+bool __write_matrix_tile(matrix_file *file, MX r0, MX c0, matrix tile);
+
+/**
+ * @brief Matrixin tamamını dosyaya yazar / dosyadan okur.
+ */
+bool __save_matrix_file(matrix matx, const char *path);
+matrix __load_matrix_file(const char *path);
+
+/**
+ * @brief Dosyalar üzerinde C = A . B.
+ *
+ * A, B ve C belleğe alınmaz; C parçaları A'nın satır ve B'nin sütun
+ * parçalarından memory_budget baytı aşmayacak şekilde hesaplanır. Bir
+ * okuyucu thread sonraki A ve B parçalarını hesaplama sürerken getirir,
+ * bir yazıcı thread biten C parçalarını arkada dosyaya yazar.
+ *
+ * @param A row x k
+ * @param B k x col
+ * @param C row x col, yazılabilir açılmış olmalıdır (__create_matrix_file)
+ * @param memory_budget Parça tamponlarının satır adımı dolgusu ve satır
+ * başlıkları dahil toplam boyutu (bayt); thread yığınları ve dosya
+ * tamponları sayılmaz
+ * @return bool Boyutlar uymuyorsa, en küçük (16 x 16) parçalar bile
+ * memory_budget'a sığmıyorsa veya okuma/yazma başarısızsa false
+ */
+bool __multiplication_matrix_file(matrix_file *A, matrix_file *B, matrix_file *C, size_t memory_budget);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,973 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+//
+//      VGRAPH.C
+//  Ertelenmiş işlem grafiği: ortak alt
+//  ifade eleme, eleman bazlı birleştirme,
+//  bellek tekrar kullanımı
+//
+#include "vgraph.h"
+#include "vkernel.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+
+/**
+ * @brief Birleştirilmiş eleman bazlı işlemlerde bir parçanın hedeflediği eleman sayısı.
+ */
+#define GRAPH_CHUNK 16384
+
+typedef enum
+{
+    GRAPH_INPUT,
+    GRAPH_TRANSPOSE,
+    GRAPH_DOT,
+    GRAPH_MAP,
+    GRAPH_ZIP
+
+} graph_op;
+
+/**
+ * @brief Grafikteki düğüm. Girdiler her zaman düğümden önce eklendiği
+ * için numara sırası aynı zamanda bir topolojik sıradır.
+ *
+ * GRAPH_DOT düğümü C = A . B^T hesaplar; çarpma A . transpose(B) olarak kaydedilir.
+ */
+typedef struct
+{
+    graph_op op;
+    graph_node in[2];
+    map_kernel map;
+    zip_kernel zip;
+
+    MX row;
+    MX col;
+
+    /* Girdilerde paylaşılan anlık görüntü, diğerlerinde hesaplanan değer */
+    matrix value;
+
+    /* Hesaplama sırasında kullanılan bilgiler */
+    bool reachable;
+    bool fused;
+    bool output;
+    unsigned int consumers;
+    graph_node consumer;
+    unsigned int level;
+    unsigned int last_use;
+
+} graph_entry;
+
+struct matrix_graph
+{
+    graph_entry *nodes;
+    MX count;
+    MX capacity;
+
+    /* Ortak alt ifade tablosu: açık adresleme, boş yuvalar GRAPH_UNDEFINED */
+    graph_node *table;
+    MX table_size;
+};
+
+static bool graph_valid(const matrix_graph *graph, graph_node n)
+{
+    return graph != NULL && n >= 0 && (MX)n < graph->count;
+}
+
+static bool graph_elementwise(const graph_entry *e)
+{
+    return e->op == GRAPH_MAP || e->op == GRAPH_ZIP;
+}
+
+static bool graph_same(const graph_entry *x, const graph_entry *y)
+{
+    if (x->op != y->op || x->in[0] != y->in[0] || x->in[1] != y->in[1])
+    {
+        return false;
+    }
+
+    switch (x->op)
+    {
+    case GRAPH_INPUT:
+        return x->value.data == y->value.data && x->value.vrows == y->value.vrows &&
+               x->row == y->row && x->col == y->col;
+    case GRAPH_MAP:
+        return x->map.op == y->map.op && x->map.a == y->map.a && x->map.b == y->map.b &&
+               x->map.fn == y->map.fn && x->map.ctx == y->map.ctx;
+    case GRAPH_ZIP:
+        return x->zip.op == y->zip.op && x->zip.a == y->zip.a && x->zip.b == y->zip.b &&
+               x->zip.fn == y->zip.fn && x->zip.ctx == y->zip.ctx;
+    default:
+        return true;
+    }
+}
+
+static uint64_t graph_mix(uint64_t h, uint64_t v)
+{
+    h ^= v + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+
+    return h;
+}
+
+/**
+ * @brief -0 ve +0 graph_same'de eşit olduğundan aynı değeri üretir.
+ */
+static uint64_t graph_float_bits(float f)
+{
+    uint32_t bits = 0;
+
+    if (f != 0.0f)
+    {
+        memcpy(&bits, &f, sizeof(bits));
+    }
+
+    return bits;
+}
+
+/**
+ * @brief graph_same ile eşit düğümler için aynı değer.
+ */
+static uint64_t graph_hash(const graph_entry *e)
+{
+    uint64_t h = graph_mix((uint64_t)e->op, (uint64_t)(uint32_t)e->in[0]);
+
+    h = graph_mix(h, (uint64_t)(uint32_t)e->in[1]);
+
+    switch (e->op)
+    {
+    case GRAPH_INPUT:
+        h = graph_mix(h, (uint64_t)(uintptr_t)e->value.data);
+        h = graph_mix(h, (uint64_t)(uintptr_t)e->value.vrows);
+        h = graph_mix(h, ((uint64_t)e->row << 32) | e->col);
+        break;
+    case GRAPH_MAP:
+        h = graph_mix(h, (uint64_t)e->map.op);
+        h = graph_mix(h, graph_float_bits(e->map.a) | graph_float_bits(e->map.b) << 32);
+        h = graph_mix(h, (uint64_t)(uintptr_t)e->map.fn);
+        h = graph_mix(h, (uint64_t)(uintptr_t)e->map.ctx);
+        break;
+    case GRAPH_ZIP:
+        h = graph_mix(h, (uint64_t)e->zip.op);
+        h = graph_mix(h, graph_float_bits(e->zip.a) | graph_float_bits(e->zip.b) << 32);
+        h = graph_mix(h, (uint64_t)(uintptr_t)e->zip.fn);
+        h = graph_mix(h, (uint64_t)(uintptr_t)e->zip.ctx);
+        break;
+    default:
+        break;
+    }
+
+    h ^= h >> 29;
+    h *= 0xBF58476D1CE4E5B9ull;
+    h ^= h >> 32;
+
+    return h;
+}
+
+/**
+ * @brief entry ile aynı düğümün numarası, yoksa GRAPH_UNDEFINED.
+ */
+static graph_node graph_find(const matrix_graph *graph, const graph_entry *entry)
+{
+    if (graph->table_size == 0)
+    {
+        return GRAPH_UNDEFINED;
+    }
+
+    const MX mask = graph->table_size - 1;
+
+    for (MX slot = (MX)graph_hash(entry) & mask;; slot = (slot + 1) & mask)
+    {
+        graph_node n = graph->table[slot];
+
+        if (n == GRAPH_UNDEFINED || graph_same(&graph->nodes[n], entry))
+        {
+            return n;
+        }
+    }
+}
+
+static void graph_table_insert(matrix_graph *graph, graph_node n)
+{
+    const MX mask = graph->table_size - 1;
+    MX slot = (MX)graph_hash(&graph->nodes[n]) & mask;
+
+    while (graph->table[slot] != GRAPH_UNDEFINED)
+    {
+        slot = (slot + 1) & mask;
+    }
+
+    graph->table[slot] = n;
+}
+
+/**
+ * @brief Tablo en fazla yarı dolu tutulur; büyürken tüm düğümler yeniden yerleştirilir.
+ */
+static void graph_table_reserve(matrix_graph *graph, MX count)
+{
+    if (2 * count <= graph->table_size)
+    {
+        return;
+    }
+
+    MX size = graph->table_size > 0 ? 2 * graph->table_size : 64;
+
+    while (2 * count > size)
+    {
+        size *= 2;
+    }
+
+    memory_free(graph->table);
+    graph->table = (graph_node *)MEMORY_ALLOC(size * sizeof(graph_node));
+
+    __allocation_err(graph->table, "Graph table");
+
+    for (MX i = 0; i < size; i++)
+    {
+        graph->table[i] = GRAPH_UNDEFINED;
+    }
+
+    graph->table_size = size;
+
+    for (MX i = 0; i < graph->count; i++)
+    {
+        graph_table_insert(graph, (graph_node)i);
+    }
+}
+
+/**
+ * @brief Aynı düğüm varsa onu, yoksa yeni düğümü döndürür.
+ */
+static graph_node graph_add(matrix_graph *graph, graph_entry entry)
+{
+    graph_node same = graph_find(graph, &entry);
+
+    if (same != GRAPH_UNDEFINED)
+    {
+        return same;
+    }
+
+    if (graph->count == graph->capacity)
+    {
+        MX capacity = graph->capacity > 0 ? 2 * graph->capacity : 16;
+        graph_entry *nodes = (graph_entry *)MEMORY_ALLOC(capacity * sizeof(graph_entry));
+
+        __allocation_err(nodes, "Graph nodes");
+
+        if (graph->count > 0)
+        {
+            memcpy(nodes, graph->nodes, graph->count * sizeof(graph_entry));
+        }
+
+        memory_free(graph->nodes);
+        graph->nodes = nodes;
+        graph->capacity = capacity;
+    }
+
+    graph_table_reserve(graph, graph->count + 1);
+
+    graph->nodes[graph->count] = entry;
+    graph_table_insert(graph, (graph_node)graph->count);
+
+    return (graph_node)graph->count++;
+}
+
+static graph_entry graph_entry_new(graph_op op, graph_node a, graph_node b, MX row, MX col)
+{
+    graph_entry e;
+
+    memset(&e, 0, sizeof(e));
+    e.op = op;
+    e.in[0] = a;
+    e.in[1] = b;
+    e.row = row;
+    e.col = col;
+    e.value = MATRIX_UNDEFINED;
+
+    return e;
+}
+
+matrix_graph *__graph_create(void)
+{
+    matrix_graph *graph = (matrix_graph *)MEMORY_ALLOC(sizeof(matrix_graph));
+
+    __allocation_err(graph, "Graph");
+
+    graph->nodes = NULL;
+    graph->count = 0;
+    graph->capacity = 0;
+    graph->table = NULL;
+    graph->table_size = 0;
+
+    return graph;
+}
+
+void __graph_free(matrix_graph *graph)
+{
+    if (graph == NULL)
+    {
+        return;
+    }
+
+    for (MX i = 0; i < graph->count; i++)
+    {
+        __free_matrix(&graph->nodes[i].value);
+    }
+
+    memory_free(graph->table);
+    memory_free(graph->nodes);
+    memory_free(graph);
+}
+
+graph_node __graph_input(matrix_graph *graph, matrix *matx)
+{
+    if (graph == NULL || matx->vrows == NULL)
+    {
+        printf("\n\nGraph input is UNDEFINED\n\n");
+        return GRAPH_UNDEFINED;
+    }
+
+    graph_entry e = graph_entry_new(GRAPH_INPUT, GRAPH_UNDEFINED, GRAPH_UNDEFINED, matx->row, matx->col);
+    e.value = *matx;
+
+    graph_node same = graph_find(graph, &e);
+
+    if (same != GRAPH_UNDEFINED)
+    {
+        return same;
+    }
+
+    // Grafik kendi tutamacını tutar; kullanıcının sonraki değişiklikleri kopyaya yazılır
+    e.value = __share_matrix(matx);
+
+    return graph_add(graph, e);
+}
+
+graph_node __graph_transpose(matrix_graph *graph, graph_node a)
+{
+    if (!graph_valid(graph, a))
+    {
+        return GRAPH_UNDEFINED;
+    }
+
+    const graph_entry *x = &graph->nodes[a];
+
+    // (A^T)^T = A
+    if (x->op == GRAPH_TRANSPOSE)
+    {
+        return x->in[0];
+    }
+
+    return graph_add(graph, graph_entry_new(GRAPH_TRANSPOSE, a, GRAPH_UNDEFINED, x->col, x->row));
+}
+
+graph_node __graph_multiplication(matrix_graph *graph, graph_node a, graph_node b)
+{
+    if (!graph_valid(graph, a) || !graph_valid(graph, b))
+    {
+        return GRAPH_UNDEFINED;
+    }
+
+    if (graph->nodes[a].col != graph->nodes[b].row)
+    {
+        printf("\n\nDimention Error graph multiplication\n\n");
+        return GRAPH_UNDEFINED;
+    }
+
+    MX row = graph->nodes[a].row, col = graph->nodes[b].col;
+    graph_node bt = __graph_transpose(graph, b);
+
+    return graph_add(graph, graph_entry_new(GRAPH_DOT, a, bt, row, col));
+}
+
+graph_node __graph_power(matrix_graph *graph, graph_node a, unsigned int pow)
+{
+    if (!graph_valid(graph, a))
+    {
+        return GRAPH_UNDEFINED;
+    }
+
+    if (pow == 0 || graph->nodes[a].row != graph->nodes[a].col)
+    {
+        printf("\n\nGraph power needs a square matrix and a positive power\n\n");
+        return GRAPH_UNDEFINED;
+    }
+
+    // Kare alarak üs alma; ara kareler ortak alt ifade olarak paylaşılır
+    graph_node result = GRAPH_UNDEFINED, base = a;
+
+    while (pow > 0)
+    {
+        if (pow & 1u)
+        {
+            result = result == GRAPH_UNDEFINED ? base : __graph_multiplication(graph, result, base);
+        }
+
+        pow >>= 1;
+
+        if (pow > 0)
+        {
+            base = __graph_multiplication(graph, base, base);
+        }
+    }
+
+    return result;
+}
+
+graph_node __graph_map(matrix_graph *graph, graph_node a, map_kernel kernel)
+{
+    if (!graph_valid(graph, a))
+    {
+        return GRAPH_UNDEFINED;
+    }
+
+    if (kernel.op == MAP_CUSTOM && kernel.fn == NULL)
+    {
+        printf("\n\nCustom elementwise map requires a function\n\n");
+        return GRAPH_UNDEFINED;
+    }
+
+    graph_entry e = graph_entry_new(GRAPH_MAP, a, GRAPH_UNDEFINED, graph->nodes[a].row, graph->nodes[a].col);
+    e.map = kernel;
+
+    return graph_add(graph, e);
+}
+
+graph_node __graph_zip(matrix_graph *graph, graph_node a, graph_node b, zip_kernel kernel)
+{
+    if (!graph_valid(graph, a) || !graph_valid(graph, b))
+    {
+        return GRAPH_UNDEFINED;
+    }
+
+    if (graph->nodes[a].row != graph->nodes[b].row || graph->nodes[a].col != graph->nodes[b].col)
+    {
+        printf("\n\nDimention Error graph elementwise operation\n\n");
+        return GRAPH_UNDEFINED;
+    }
+
+    if (kernel.op == ZIP_CUSTOM && kernel.fn == NULL)
+    {
+        printf("\n\nCustom elementwise map requires a function\n\n");
+        return GRAPH_UNDEFINED;
+    }
+
+    // Değişmeli işlemlerde girdi sırası sabitlenir: A + B ile B + A aynı düğümdür
+    bool commutative = kernel.op == ZIP_ADD || kernel.op == ZIP_MUL ||
+                       kernel.op == ZIP_MIN || kernel.op == ZIP_MAX;
+
+    if (commutative && b < a)
+    {
+        graph_node t = a;
+        a = b;
+        b = t;
+    }
+
+    graph_entry e = graph_entry_new(GRAPH_ZIP, a, b, graph->nodes[a].row, graph->nodes[a].col);
+    e.zip = kernel;
+
+    return graph_add(graph, e);
+}
+
+graph_node __graph_sum(matrix_graph *graph, graph_node a, graph_node b)
+{
+    return __graph_zip(graph, a, b, __zip_kernel(ZIP_ADD, 0.0f, 0.0f));
+}
+
+graph_node __graph_substract(matrix_graph *graph, graph_node a, graph_node b)
+{
+    return __graph_zip(graph, a, b, __zip_kernel(ZIP_SUB, 0.0f, 0.0f));
+}
+
+graph_node __graph_divide(matrix_graph *graph, graph_node a, graph_node b)
+{
+    return __graph_zip(graph, a, b, __zip_kernel(ZIP_DIV, 0.0f, 0.0f));
+}
+
+graph_node __graph_scalar_multiplication(matrix_graph *graph, graph_node a, float scalar)
+{
+    return __graph_map(graph, a, __map_kernel(MAP_AFFINE, scalar, 0.0f));
+}
+
+bool __graph_shape(const matrix_graph *graph, graph_node node, MX *row, MX *col)
+{
+    if (!graph_valid(graph, node))
+    {
+        return false;
+    }
+
+    *row = graph->nodes[node].row;
+    *col = graph->nodes[node].col;
+
+    return true;
+}
+
+//
+//  Hesaplama
+//
+
+/**
+ * @brief Birleştirilmiş bir ağacın hesaplanmış (yaprak) girdilerini dolaşır:
+ * en büyük yaprak seviyesini ve satır başına gereken ara tampon sayısını bulur,
+ * yaprakların son kullanım seviyesini günceller.
+ */
+static unsigned int graph_tree_scan(matrix_graph *graph, graph_node n, bool root,
+                                    unsigned int use_level, unsigned int *max_level)
+{
+    graph_entry *e = &graph->nodes[n];
+
+    if (!root && !e->fused)
+    {
+        if (e->level > *max_level)
+        {
+            *max_level = e->level;
+        }
+        if (use_level > e->last_use)
+        {
+            e->last_use = use_level;
+        }
+        return 0;
+    }
+
+    unsigned int depth = graph_tree_scan(graph, e->in[0], false, use_level, max_level);
+
+    if (e->op == GRAPH_ZIP)
+    {
+        // Sağ alt ağaç, sol sonucun tutulduğu tamponun ardındaki tamponları kullanır
+        unsigned int right = 1 + graph_tree_scan(graph, e->in[1], false, use_level, max_level);
+        depth = depth > right ? depth : right;
+    }
+
+    return depth;
+}
+
+/**
+ * @brief Birleştirilmiş ağacın bir satırını hesaplar. Sonuç out'a yazılır
+ * veya yaprak ise yaprağın satırı döner. scratch, sağ alt ağaçların
+ * kullandığı ardışık stride uzunluklu tamponlardır.
+ */
+static const float *graph_row(const matrix_graph *graph, graph_node n, bool root, MX i,
+                              float *out, float *scratch, size_t stride)
+{
+    const graph_entry *e = &graph->nodes[n];
+
+    if (!root && !e->fused)
+    {
+        return e->value.vrows[i]->elements;
+    }
+
+    const float *x = graph_row(graph, e->in[0], false, i, out, scratch, stride);
+
+    if (e->op == GRAPH_MAP)
+    {
+        __map_span(&e->map, out, x, e->col);
+        return out;
+    }
+
+    const float *y = graph_row(graph, e->in[1], false, i, scratch, scratch + stride, stride);
+
+    __zip_span(&e->zip, out, x, y, e->col);
+
+    return out;
+}
+
+typedef struct
+{
+    const matrix_graph *graph;
+    graph_node node;
+    float *scratch;
+    size_t stride;
+    unsigned int depth;
+
+} graph_fused_job;
+
+static void graph_fused_task(void *ctx, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    const graph_fused_job *job = (const graph_fused_job *)ctx;
+    const graph_entry *e = &job->graph->nodes[job->node];
+    float *scratch = job->scratch + (size_t)worker * (job->depth + 1) * job->stride;
+
+    for (unsigned long i = begin; i < end; i++)
+    {
+        graph_row(job->graph, job->node, true, (MX)i, e->value.vrows[i]->elements, scratch, job->stride);
+    }
+}
+
+/**
+ * @brief Hesaplanan bir düğümü (değer tamponu ayrılmış olarak) çalıştırır.
+ */
+static void graph_run_node(matrix_graph *graph, graph_node n)
+{
+    graph_entry *e = &graph->nodes[n];
+
+    switch (e->op)
+    {
+    case GRAPH_TRANSPOSE:
+        __transpose_matrix_into(graph->nodes[e->in[0]].value, &e->value);
+        break;
+    case GRAPH_DOT:
+        __dot_rows_matrix(graph->nodes[e->in[0]].value, graph->nodes[e->in[1]].value, &e->value);
+        break;
+    case GRAPH_MAP:
+    case GRAPH_ZIP:
+    {
+        unsigned int max_level = 0;
+        unsigned int depth = graph_tree_scan(graph, n, true, e->level, &max_level);
+        size_t stride = ((size_t)e->col + 15) & ~(size_t)15;
+        unsigned int threads = parallel_threads();
+
+        graph_fused_job job = {graph, n, NULL, stride, depth};
+        job.scratch = (float *)MEMORY_ALLOC_ALIGNED((size_t)threads * (depth + 1) * stride * sizeof(float));
+
+        __allocation_err(job.scratch, "Graph scratch");
+
+        unsigned long grain = e->col >= GRAPH_CHUNK ? 1 : GRAPH_CHUNK / (e->col > 0 ? e->col : 1);
+        parallel_for(0, e->row, grain, graph_fused_task, &job);
+
+        memory_free_aligned(job.scratch);
+        break;
+    }
+    case GRAPH_INPUT:
+    default:
+        break;
+    }
+}
+
+typedef struct
+{
+    matrix_graph *graph;
+    graph_node node;
+
+} graph_task;
+
+typedef struct
+{
+    graph_task *tasks;
+    MX count;
+
+} graph_level;
+
+static void graph_run_task(void *arg)
+{
+    graph_task *t = (graph_task *)arg;
+    graph_run_node(t->graph, t->node);
+}
+
+static void graph_run_level(void *arg)
+{
+    graph_level *level = (graph_level *)arg;
+    parallel_group group;
+
+    parallel_group_init(&group);
+
+    for (MX i = 1; i < level->count; i++)
+    {
+        parallel_spawn(&group, graph_run_task, &level->tasks[i]);
+    }
+
+    graph_run_task(&level->tasks[0]);
+
+    parallel_wait(&group);
+}
+
+/**
+ * @brief Serbest kalan ara tamponlar; aynı boyutlu yeni düğümler bunları alır.
+ */
+typedef struct
+{
+    matrix *items;
+    MX count;
+
+} graph_pool;
+
+static matrix graph_pool_take(graph_pool *pool, MX row, MX col)
+{
+    for (MX i = 0; i < pool->count; i++)
+    {
+        if (pool->items[i].row == row && pool->items[i].col == col)
+        {
+            matrix m = pool->items[i];
+            pool->items[i] = pool->items[--pool->count];
+            return m;
+        }
+    }
+
+    return __allocate_row_vectors(row, col);
+}
+
+/**
+ * @brief Hesaplanan düğümleri seviyelerine (last_use ise son kullanım
+ * seviyelerine) göre bir kez sıralar. Seviye l'nin düğümleri numara sırasıyla
+ * order[start[l], start[l + 1]) aralığındadır; start max_level + 2 elemanlıdır.
+ */
+static void graph_bucket(const matrix_graph *graph, bool last_use, unsigned int max_level,
+                         MX *start, graph_node *order)
+{
+    memset(start, 0, (max_level + 2) * sizeof(MX));
+
+    for (MX i = 0; i < graph->count; i++)
+    {
+        const graph_entry *e = &graph->nodes[i];
+
+        if (e->reachable && !e->fused && e->op != GRAPH_INPUT && !(last_use && e->output))
+        {
+            start[(last_use ? e->last_use : e->level) + 1]++;
+        }
+    }
+
+    for (unsigned int l = 0; l <= max_level; l++)
+    {
+        start[l + 1] += start[l];
+    }
+
+    for (MX i = 0; i < graph->count; i++)
+    {
+        const graph_entry *e = &graph->nodes[i];
+
+        if (e->reachable && !e->fused && e->op != GRAPH_INPUT && !(last_use && e->output))
+        {
+            order[start[last_use ? e->last_use : e->level]++] = (graph_node)i;
+        }
+    }
+
+    // Yerleştirme her başlangıcı bir sonrakine kaydırdı
+    for (unsigned int l = max_level + 1; l > 0; l--)
+    {
+        start[l] = start[l - 1];
+    }
+    start[0] = 0;
+}
+
+bool __graph_evaluate_many(matrix_graph *graph, const graph_node *outputs, MX count, matrix *results)
+{
+    for (MX i = 0; i < count; i++)
+    {
+        results[i] = MATRIX_UNDEFINED;
+
+        if (!graph_valid(graph, outputs[i]))
+        {
+            printf("\n\nGraph output is UNDEFINED\n\n");
+            return false;
+        }
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_GRAPH);
+
+    const MX n = graph->count;
+
+    for (MX i = 0; i < n; i++)
+    {
+        graph_entry *e = &graph->nodes[i];
+
+        e->reachable = false;
+        e->fused = false;
+        e->output = false;
+        e->consumers = 0;
+        e->consumer = GRAPH_UNDEFINED;
+        e->level = 0;
+        e->last_use = 0;
+    }
+
+    for (MX i = 0; i < count; i++)
+    {
+        graph->nodes[outputs[i]].reachable = true;
+        graph->nodes[outputs[i]].output = true;
+    }
+
+    // Çıktılardan geriye doğru gereken düğümler ve kullanıcı sayıları
+    for (MX i = n; i-- > 0;)
+    {
+        graph_entry *e = &graph->nodes[i];
+
+        if (!e->reachable || e->op == GRAPH_INPUT)
+        {
+            continue;
+        }
+
+        for (int k = 0; k < 2; k++)
+        {
+            if (e->in[k] != GRAPH_UNDEFINED)
+            {
+                graph_entry *in = &graph->nodes[e->in[k]];
+
+                in->reachable = true;
+                in->consumers++;
+                in->consumer = (graph_node)i;
+            }
+        }
+    }
+
+    // Tek kullanıcısı eleman bazlı olan eleman bazlı düğümler kullanıcısına katılır
+    for (MX i = 0; i < n; i++)
+    {
+        graph_entry *e = &graph->nodes[i];
+
+        e->fused = e->reachable && !e->output && graph_elementwise(e) && e->consumers == 1 &&
+                   graph_elementwise(&graph->nodes[e->consumer]);
+    }
+
+    // Seviyeler: bir düğüm, hesaplanan girdilerinin en büyük seviyesinden bir sonra çalışır
+    unsigned int max_level = 0;
+
+    for (MX i = 0; i < n; i++)
+    {
+        graph_entry *e = &graph->nodes[i];
+
+        if (!e->reachable || e->fused || e->op == GRAPH_INPUT)
+        {
+            continue;
+        }
+
+        unsigned int deps = 0;
+
+        if (graph_elementwise(e))
+        {
+            graph_tree_scan(graph, (graph_node)i, true, 0, &deps);
+        }
+        else
+        {
+            for (int k = 0; k < 2; k++)
+            {
+                if (e->in[k] != GRAPH_UNDEFINED && graph->nodes[e->in[k]].level > deps)
+                {
+                    deps = graph->nodes[e->in[k]].level;
+                }
+            }
+        }
+
+        e->level = deps + 1;
+        max_level = e->level > max_level ? e->level : max_level;
+    }
+
+    // Son kullanım seviyeleri; çıktılar hiç bırakılmaz
+    for (MX i = 0; i < n; i++)
+    {
+        graph_entry *e = &graph->nodes[i];
+
+        if (!e->reachable || e->fused || e->op == GRAPH_INPUT)
+        {
+            continue;
+        }
+
+        if (graph_elementwise(e))
+        {
+            unsigned int unused = 0;
+            graph_tree_scan(graph, (graph_node)i, true, e->level, &unused);
+        }
+        else
+        {
+            for (int k = 0; k < 2; k++)
+            {
+                if (e->in[k] == GRAPH_UNDEFINED)
+                {
+                    continue;
+                }
+
+                graph_entry *in = &graph->nodes[e->in[k]];
+                in->last_use = e->level > in->last_use ? e->level : in->last_use;
+            }
+        }
+    }
+
+    graph_pool pool = {NULL, 0};
+    graph_task *tasks = (graph_task *)MEMORY_ALLOC((n > 0 ? n : 1) * sizeof(graph_task));
+
+    pool.items = (matrix *)MEMORY_ALLOC((n > 0 ? n : 1) * sizeof(matrix));
+
+    __allocation_err(tasks, "Graph tasks");
+    __allocation_err(pool.items, "Graph pool");
+
+    // Her seviyede tüm düğümleri taramamak için kovalar bir kez kurulur
+    MX *run_start = (MX *)MEMORY_ALLOC(2 * (max_level + 2) * sizeof(MX));
+    graph_node *run_order = (graph_node *)MEMORY_ALLOC(2 * (n > 0 ? n : 1) * sizeof(graph_node));
+
+    __allocation_err(run_start, "Graph levels");
+    __allocation_err(run_order, "Graph levels");
+
+    MX *free_start = run_start + max_level + 2;
+    graph_node *free_order = run_order + n;
+
+    graph_bucket(graph, false, max_level, run_start, run_order);
+    graph_bucket(graph, true, max_level, free_start, free_order);
+
+    for (unsigned int level = 1; level <= max_level; level++)
+    {
+        MX level_count = 0;
+
+        for (MX k = run_start[level]; k < run_start[level + 1]; k++)
+        {
+            graph_entry *e = &graph->nodes[run_order[k]];
+
+            e->value = graph_pool_take(&pool, e->row, e->col);
+
+            tasks[level_count].graph = graph;
+            tasks[level_count].node = run_order[k];
+            level_count++;
+        }
+
+        // Aynı seviyedeki düğümler birbirinden bağımsızdır
+        graph_level lvl = {tasks, level_count};
+
+        if (level_count == 1)
+        {
+            graph_run_task(&tasks[0]);
+        }
+        else if (level_count > 1)
+        {
+            parallel_run(graph_run_level, &lvl);
+        }
+
+        // Bu seviyede son kez kullanılan ara sonuçların tamponları havuza döner
+        for (MX k = free_start[level]; k < free_start[level + 1]; k++)
+        {
+            graph_entry *e = &graph->nodes[free_order[k]];
+
+            pool.items[pool.count++] = e->value;
+            e->value = MATRIX_UNDEFINED;
+        }
+    }
+
+    memory_free(run_order);
+    memory_free(run_start);
+
+    for (MX i = 0; i < count; i++)
+    {
+        results[i] = __share_matrix(&graph->nodes[outputs[i]].value);
+    }
+
+    // Grafik hesaplanan değerleri tutmaz; sonuçlar artık çağıranındır
+    for (MX i = 0; i < n; i++)
+    {
+        graph_entry *e = &graph->nodes[i];
+
+        if (e->op != GRAPH_INPUT)
+        {
+            __free_matrix(&e->value);
+            e->value = MATRIX_UNDEFINED;
+        }
+    }
+
+    for (MX i = 0; i < pool.count; i++)
+    {
+        __free_matrix(&pool.items[i]);
+    }
+
+    memory_free(pool.items);
+    memory_free(tasks);
+
+    PROFILE_END(PROFILE_MATRIX_GRAPH, 0, 0);
+
+    return true;
+}
+
+matrix __graph_evaluate(matrix_graph *graph, graph_node output)
+{
+    matrix result;
+
+    if (!__graph_evaluate_many(graph, &output, 1, &result))
+    {
+        return MATRIX_UNDEFINED;
+    }
+
+    return result;
+}
\ No newline at end of file
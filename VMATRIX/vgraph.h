@@ -0,0 +1,94 @@
+#include "vmatrix.h"
+#include "vmap.h"
+
+#ifndef VGRAPH_H
+#define VGRAPH_H
+
+/**
+ * @brief Ertelenmiş matrix işlemleri grafiği.
+ *
+ * __graph_* fonksiyonları işlemi hemen çalıştırmaz, grafiğe bir düğüm
+ * ekler ve düğümün numarasını döndürür. Sonuçlar __graph_evaluate ile
+ * istendiğinde hesaplanır:
+ *
+ *  - Aynı işlem aynı girdilerle tekrar eklenirse var olan düğüm döner
+ *    (ortak alt ifade eleme). transpose(transpose(A)) doğrudan A'dır.
+ *  - Çarpma, A . (B^T)^T olarak kaydedilir; böylece B'nin transpozesi
+ *    diğer kullanımlarla paylaşılır ve A . B^T hiç transpoze almaz.
+ *  - Tek kullanıcısı olan eleman bazlı işlem zincirleri tek geçişte
+ *    birleştirilir, ara matrixleri oluşturulmaz.
+ *  - Ara sonuçların bellekleri son kullanımlarından sonra aynı boyutlu
+ *    diğer ara sonuçlar için tekrar kullanılır.
+ *  - Birbirine bağlı olmayan düğümler paralel çalışır.
+ *
+ * Özel (MAP_CUSTOM / ZIP_CUSTOM) fonksiyonların yan etkisiz olduğu varsayılır;
+ * aynı fonksiyon ve bağlamla iki kez eklenen işlem bir kez hesaplanır.
+ */
+typedef struct matrix_graph matrix_graph;
+
+/**
+ * @brief Düğüm numarası. Hatalı işlemler GRAPH_UNDEFINED döndürür ve
+ * bu değeri alan işlemler de GRAPH_UNDEFINED döndürür.
+ */
+typedef int graph_node;
+
+#define GRAPH_UNDEFINED (-1)
+
+matrix_graph *__graph_create(void);
+void __graph_free(matrix_graph *graph);
+
+/**
+ * @brief Matrixi grafiğe girdi olarak ekler. Matrix kopyalanmaz,
+ * __share_matrix ile paylaşılır; aynı depolama iki kez eklenirse
+ * aynı düğüm döner.
+ *
+ * @param graph
+ * @param matx
+ * @return graph_node
+ */
+graph_node __graph_input(matrix_graph *graph, matrix *matx);
+
+graph_node __graph_multiplication(matrix_graph *graph, graph_node a, graph_node b);
+graph_node __graph_transpose(matrix_graph *graph, graph_node a);
+graph_node __graph_power(matrix_graph *graph, graph_node a, unsigned int pow);
+graph_node __graph_sum(matrix_graph *graph, graph_node a, graph_node b);
+graph_node __graph_substract(matrix_graph *graph, graph_node a, graph_node b);
+graph_node __graph_divide(matrix_graph *graph, graph_node a, graph_node b);
+graph_node __graph_scalar_multiplication(matrix_graph *graph, graph_node a, float scalar);
+graph_node __graph_map(matrix_graph *graph, graph_node a, map_kernel kernel);
+graph_node __graph_zip(matrix_graph *graph, graph_node a, graph_node b, zip_kernel kernel);
+
+/**
+ * @brief Düğümün boyutları.
+ *
+ * @param graph
+ * @param node
+ * @param row
+ * @param col
+ * @return bool
+ */
+bool __graph_shape(const matrix_graph *graph, graph_node node, MX *row, MX *col);
+
+/**
+ * @brief İstenen düğümleri hesaplar. results[i], outputs[i]'nin değeridir ve
+ * __free_matrix ile bırakılmalıdır. Yalnızca bu düğümlerin ihtiyaç
+ * duyduğu düğümler hesaplanır.
+ *
+ * @param graph
+ * @param outputs
+ * @param count
+ * @param results
+ * @return bool
+ */
+bool __graph_evaluate_many(matrix_graph *graph, const graph_node *outputs, MX count, matrix *results);
+
+/**
+ * @brief Tek bir düğümü hesaplar.
+ *
+ * @param graph
+ * @param output
+ * @return matrix
+ */
+matrix __graph_evaluate(matrix_graph *graph, graph_node output);
+
+#endif
\ No newline at end of file
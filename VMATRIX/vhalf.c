@@ -0,0 +1,562 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//
+//      VHALF.C
+//  FP16 / BF16 olarak tutulan
+//  vektör ve matrixler
+//
+#include "vhalf.h"
+#include "vkernel.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Satır adımının yuvarlandığı eleman sayısı (64 bayt).
+ */
+#define HALF_ALIGN 32
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği çarpma-toplam sayısı.
+ */
+#define HALF_CHUNK 32768
+
+/**
+ * @brief Çarpımda birlikte float'a çevrilen A satırı sayısı.
+ */
+#define HALF_ROW_BLOCK 32
+
+const hvec HVEC_UNDEFINED = {HALF_FP16, 0, NULL};
+const hmatrix HMATRIX_UNDEFINED = {HALF_FP16, 0, 0, 0, NULL};
+
+/*
+ * half_loadv : SIMD_WIDTH adet 16 bitlik değeri float yazmacına çevirir.
+ * FP16 için F16C (vcvtph2ps), BF16 için 16 bit sola kaydırma kullanılır.
+ * Hedefte ikisi de yoksa HALF_VECTOR 0'dır ve döngüler skaler çalışır.
+ */
+#if defined(__AVX512F__)
+
+#define HALF_VECTOR 1
+
+static inline simd_f half_loadv(const uint16_t *p, half_format format)
+{
+    __m256i h = _mm256_loadu_si256((const __m256i *)p);
+
+    if (format == HALF_FP16)
+        return _mm512_cvtph_ps(h);
+
+    return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16));
+}
+
+static inline void half_store_fp16(uint16_t *p, simd_f v)
+{
+    _mm256_storeu_si256((__m256i *)p, _mm512_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+}
+
+#elif defined(__AVX2__) && defined(__F16C__)
+
+#define HALF_VECTOR 1
+
+static inline simd_f half_loadv(const uint16_t *p, half_format format)
+{
+    __m128i h = _mm_loadu_si128((const __m128i *)p);
+
+    if (format == HALF_FP16)
+        return _mm256_cvtph_ps(h);
+
+    return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16));
+}
+
+static inline void half_store_fp16(uint16_t *p, simd_f v)
+{
+    _mm_storeu_si128((__m128i *)p, _mm256_cvtps_ph(v, _MM_FROUND_TO_NEAREST_INT));
+}
+
+#else
+
+#define HALF_VECTOR 0
+
+#endif
+
+uint16_t __float_to_half(float x, half_format format)
+{
+    uint32_t u;
+
+    memcpy(&u, &x, sizeof(u));
+
+    if (format == HALF_BF16)
+    {
+        // NaN yuvarlanınca sonsuza dönmesin
+        if ((u & 0x7fffffffu) > 0x7f800000u)
+            return (uint16_t)((u >> 16) | 0x40u);
+
+        return (uint16_t)((u + 0x7fffu + ((u >> 16) & 1u)) >> 16);
+    }
+
+    uint32_t sign = (u >> 16) & 0x8000u;
+    uint32_t a = u & 0x7fffffffu;
+
+    if (a >= 0x7f800000u)
+        return (uint16_t)(sign | 0x7c00u | (a > 0x7f800000u ? 0x200u : 0u));
+
+    // 65520 ve üzeri sonsuza yuvarlanır
+    if (a >= 0x477ff000u)
+        return (uint16_t)(sign | 0x7c00u);
+
+    // 2^-14'ten küçükler alt normal olur
+    if (a < 0x38800000u)
+    {
+        if (a < 0x33000000u)
+            return (uint16_t)sign;
+
+        uint32_t shift = 126u - (a >> 23);
+        uint32_t m = (a & 0x7fffffu) | 0x800000u;
+        uint32_t q = m >> shift;
+        uint32_t rem = m & ((1u << shift) - 1u);
+        uint32_t half = 1u << (shift - 1u);
+
+        if (rem > half || (rem == half && (q & 1u)))
+            q++;
+
+        return (uint16_t)(sign | q);
+    }
+
+    // Kesir 13 bit kısalır, üs 127'den 15'e kaydırılır
+    a += 0xfffu + ((a >> 13) & 1u);
+
+    return (uint16_t)(sign | ((a - 0x38000000u) >> 13));
+}
+
+float __half_to_float(uint16_t h, half_format format)
+{
+    uint32_t u;
+    float x;
+
+    if (format == HALF_BF16)
+    {
+        u = (uint32_t)h << 16;
+    }
+    else
+    {
+        uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+        uint32_t e = (h >> 10) & 0x1fu;
+        uint32_t m = h & 0x3ffu;
+
+        if (e == 0x1fu)
+        {
+            u = sign | 0x7f800000u | (m << 13);
+        }
+        else if (e != 0)
+        {
+            u = sign | ((e + 112u) << 23) | (m << 13);
+        }
+        else
+        {
+            // Alt normal: m * 2^-24
+            x = (float)m * 5.9604644775390625e-8f;
+            return sign ? -x : x;
+        }
+    }
+
+    memcpy(&x, &u, sizeof(x));
+
+    return x;
+}
+
+static void half_from_float_n(uint16_t *dst, const float *src, MX n, half_format format)
+{
+    MX t = 0;
+
+#if HALF_VECTOR
+    if (format == HALF_FP16)
+    {
+        for (; t + SIMD_WIDTH <= n; t += SIMD_WIDTH)
+        {
+            half_store_fp16(dst + t, simd_loadu(src + t));
+        }
+    }
+#endif
+
+    for (; t < n; t++)
+    {
+        dst[t] = __float_to_half(src[t], format);
+    }
+}
+
+static void half_to_float_n(float *dst, const uint16_t *src, MX n, half_format format)
+{
+    MX t = 0;
+
+#if HALF_VECTOR
+    for (; t + SIMD_WIDTH <= n; t += SIMD_WIDTH)
+    {
+        simd_storeu(dst + t, half_loadv(src + t, format));
+    }
+#endif
+
+    for (; t < n; t++)
+    {
+        dst[t] = __half_to_float(src[t], format);
+    }
+}
+
+/**
+ * @brief sum a[t] b[t]; a her adımda yazmaç içinde float'a çevrilir.
+ */
+static float half_dot_kernel(const uint16_t *a, const float *b, MX n, half_format format)
+{
+    float r = 0.0f;
+    MX t = 0;
+
+#if HALF_VECTOR
+    simd_f s0 = simd_zero(), s1 = simd_zero();
+
+    for (; t + 2 * SIMD_WIDTH <= n; t += 2 * SIMD_WIDTH)
+    {
+        s0 = simd_fmaddv(half_loadv(a + t, format), simd_loadu(b + t), s0);
+        s1 = simd_fmaddv(half_loadv(a + t + SIMD_WIDTH, format), simd_loadu(b + t + SIMD_WIDTH), s1);
+    }
+    for (; t + SIMD_WIDTH <= n; t += SIMD_WIDTH)
+    {
+        s0 = simd_fmaddv(half_loadv(a + t, format), simd_loadu(b + t), s0);
+    }
+
+    r = simd_hsum(simd_addv(s0, s1));
+#endif
+
+    for (; t < n; t++)
+    {
+        r += __half_to_float(a[t], format) * b[t];
+    }
+
+    return r;
+}
+
+/**
+ * @brief sum (a[t] - b[t])^2.
+ */
+static float half_sqdist_kernel(const uint16_t *a, const float *b, MX n, half_format format)
+{
+    float r = 0.0f;
+    MX t = 0;
+
+#if HALF_VECTOR
+    simd_f s0 = simd_zero(), s1 = simd_zero();
+
+    for (; t + 2 * SIMD_WIDTH <= n; t += 2 * SIMD_WIDTH)
+    {
+        simd_f d0 = simd_subv(half_loadv(a + t, format), simd_loadu(b + t));
+        simd_f d1 = simd_subv(half_loadv(a + t + SIMD_WIDTH, format), simd_loadu(b + t + SIMD_WIDTH));
+
+        s0 = simd_fmaddv(d0, d0, s0);
+        s1 = simd_fmaddv(d1, d1, s1);
+    }
+    for (; t + SIMD_WIDTH <= n; t += SIMD_WIDTH)
+    {
+        simd_f d0 = simd_subv(half_loadv(a + t, format), simd_loadu(b + t));
+
+        s0 = simd_fmaddv(d0, d0, s0);
+    }
+
+    r = simd_hsum(simd_addv(s0, s1));
+#endif
+
+    for (; t < n; t++)
+    {
+        float d = __half_to_float(a[t], format) - b[t];
+        r += d * d;
+    }
+
+    return r;
+}
+
+hvec __half_vector(vec v, half_format format)
+{
+    hvec h = {format, v.dim, NULL};
+
+    h.data = (uint16_t *)MEMORY_ALLOC_ALIGNED((v.dim > 0 ? v.dim : 1) * sizeof(uint16_t));
+
+    __allocation_err(h.data, "Half vector");
+
+    half_from_float_n(h.data, v.elements, v.dim, format);
+
+    return h;
+}
+
+vec __half_vector_to_float(hvec h)
+{
+    vec v = allocate_vector_mem(h.dim);
+
+    half_to_float_n(v.elements, h.data, h.dim, h.format);
+
+    return v;
+}
+
+void __free_half_vector(hvec *h)
+{
+    if (h->data != NULL)
+    {
+        memory_free_aligned(h->data);
+    }
+
+    *h = HVEC_UNDEFINED;
+}
+
+hmatrix __half_matrix(matrix matx, half_format format)
+{
+    hmatrix h = {format, matx.row, matx.col, (matx.col + HALF_ALIGN - 1) / HALF_ALIGN * HALF_ALIGN, NULL};
+    size_t size = (size_t)h.row * h.ld;
+
+    h.data = (uint16_t *)MEMORY_ALLOC_ALIGNED((size > 0 ? size : 1) * sizeof(uint16_t));
+
+    __allocation_err(h.data, "Half matrix");
+
+    memset(h.data, 0, size * sizeof(uint16_t));
+
+    for (MX i = 0; i < h.row; i++)
+    {
+        half_from_float_n(h.data + (size_t)i * h.ld, matx.vrows[i]->elements, h.col, format);
+    }
+
+    return h;
+}
+
+matrix __half_matrix_to_float(hmatrix h)
+{
+    matrix out = __allocate_row_vectors(h.row, h.col);
+
+    for (MX i = 0; i < h.row; i++)
+    {
+        half_to_float_n(out.vrows[i]->elements, h.data + (size_t)i * h.ld, h.col, h.format);
+    }
+
+    return out;
+}
+
+void __free_half_matrix(hmatrix *h)
+{
+    if (h->data != NULL)
+    {
+        memory_free_aligned(h->data);
+    }
+
+    *h = HMATRIX_UNDEFINED;
+}
+
+float __half_get(hmatrix h, MX i, MX j)
+{
+    if (i >= h.row || j >= h.col)
+    {
+        printf("\n\nDimention Error half get function\n\n");
+        return 0.0f;
+    }
+
+    return __half_to_float(h.data[(size_t)i * h.ld + j], h.format);
+}
+
+float __half_dot(hvec a, vec b)
+{
+    if (a.dim != b.dim)
+    {
+        printf("\n\nDimention Error half dot function\n\n");
+        return 0.0f;
+    }
+
+    return half_dot_kernel(a.data, b.elements, a.dim, a.format);
+}
+
+float __half_distance(hvec a, vec b)
+{
+    if (a.dim != b.dim)
+    {
+        printf("\n\nDimention Error half distance function\n\n");
+        return 0.0f;
+    }
+
+    return sqrtf(half_sqdist_kernel(a.data, b.elements, a.dim, a.format));
+}
+
+typedef struct
+{
+    hmatrix A;
+    const float *x;
+    float *y;
+
+} half_rows_ctx;
+
+static void half_matvec_rows(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    half_rows_ctx *c = (half_rows_ctx *)arg;
+    (void)worker;
+
+    for (MX i = (MX)begin; i < (MX)end; i++)
+    {
+        c->y[i] = half_dot_kernel(c->A.data + (size_t)i * c->A.ld, c->x, c->A.col, c->A.format);
+    }
+}
+
+static void half_distance_rows(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    half_rows_ctx *c = (half_rows_ctx *)arg;
+    (void)worker;
+
+    for (MX i = (MX)begin; i < (MX)end; i++)
+    {
+        c->y[i] = sqrtf(half_sqdist_kernel(c->A.data + (size_t)i * c->A.ld, c->x, c->A.col, c->A.format));
+    }
+}
+
+vec __half_matvec(hmatrix A, vec x)
+{
+    if (x.dim != A.col)
+    {
+        printf("\n\nDimention Error half matvec function\n\n");
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_HALF_MATVEC);
+
+    vec y = allocate_vector_mem(A.row);
+    half_rows_ctx ctx = {A, x.elements, y.elements};
+
+    parallel_for(0, A.row, A.col >= HALF_CHUNK ? 1 : HALF_CHUNK / (A.col + 1), half_matvec_rows, &ctx);
+
+    PROFILE_END(PROFILE_HALF_MATVEC, 2ull * A.row * A.col,
+                (size_t)A.row * A.col * sizeof(uint16_t) + (A.row + A.col) * sizeof(float));
+
+    return y;
+}
+
+vec __half_row_distances(hmatrix A, vec x)
+{
+    if (x.dim != A.col)
+    {
+        printf("\n\nDimention Error half row distances function\n\n");
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_HALF_MATVEC);
+
+    vec y = allocate_vector_mem(A.row);
+    half_rows_ctx ctx = {A, x.elements, y.elements};
+
+    parallel_for(0, A.row, A.col >= HALF_CHUNK ? 1 : HALF_CHUNK / (A.col + 1), half_distance_rows, &ctx);
+
+    PROFILE_END(PROFILE_HALF_MATVEC, 3ull * A.row * A.col,
+                (size_t)A.row * A.col * sizeof(uint16_t) + (A.row + A.col) * sizeof(float));
+
+    return y;
+}
+
+typedef struct
+{
+    hmatrix A;
+    matrix Bt;
+    float *C;
+    MX ldc;
+
+} half_multiply_ctx;
+
+/**
+ * @brief A'nın HALF_ROW_BLOCK satırlık blokları [begin, end): blok float
+ * tampona çevrilir ve B^T satırlarıyla __dot_rows_block üzerinden çarpılır.
+ */
+static void half_multiply_blocks(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    half_multiply_ctx *c = (half_multiply_ctx *)arg;
+    MX ld = __leading_dimension(c->A.col);
+    float *rows = (float *)MEMORY_ALLOC_ALIGNED((size_t)HALF_ROW_BLOCK * (ld > 0 ? ld : 1) * sizeof(float));
+    (void)worker;
+
+    __allocation_err(rows, "Half multiplication");
+
+    for (MX blk = (MX)begin; blk < (MX)end; blk++)
+    {
+        MX i0 = blk * HALF_ROW_BLOCK;
+        MX r = c->A.row - i0 < HALF_ROW_BLOCK ? c->A.row - i0 : HALF_ROW_BLOCK;
+
+        for (MX t = 0; t < r; t++)
+        {
+            half_to_float_n(rows + (size_t)t * ld, c->A.data + (size_t)(i0 + t) * c->A.ld, c->A.col, c->A.format);
+        }
+
+        matrix view = __matrix_from_buffer(rows, r, c->A.col, ld);
+
+        __dot_rows_block(view, 0, r, c->Bt, 0, c->Bt.row, c->C + (size_t)i0 * c->ldc, c->ldc);
+
+        __free_matrix(&view);
+    }
+
+    memory_free_aligned(rows);
+}
+
+matrix __half_multiplication(hmatrix A, matrix B)
+{
+    if (A.col != B.row)
+    {
+        printf("\n\nDimention Error half multiplication function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_HALF_MULTIPLICATION);
+
+    matrix C = __allocate_row_vectors(A.row, B.col);
+    half_multiply_ctx ctx = {A, __transpose_matrix(B), NULL, 0};
+    unsigned long blocks = (A.row + HALF_ROW_BLOCK - 1) / HALF_ROW_BLOCK;
+
+    ctx.C = __matrix_buffer(C, &ctx.ldc);
+
+    if (A.row > 0 && B.col > 0)
+    {
+        parallel_for(0, blocks, 1, half_multiply_blocks, &ctx);
+    }
+
+    __free_matrix(&ctx.Bt);
+
+    PROFILE_END(PROFILE_HALF_MULTIPLICATION, 2ull * A.row * A.col * B.col,
+                (size_t)A.row * A.col * sizeof(uint16_t) + ((size_t)B.row * B.col + (size_t)A.row * B.col) * sizeof(float));
+
+    return C;
+}
+
+matrix __half_multiplication_right(matrix A, hmatrix B)
+{
+    if (A.col != B.row)
+    {
+        printf("\n\nDimention Error half multiplication function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_HALF_MULTIPLICATION);
+
+    matrix C = __allocate_row_vectors(A.row, B.col);
+    matrix Bt = __allocate_row_vectors(B.col, B.row);
+    float *row = (float *)MEMORY_ALLOC((B.col > 0 ? B.col : 1) * sizeof(float));
+
+    __allocation_err(row, "Half multiplication");
+
+    // B'nin her satırı bir kez çevrilir ve B^T'nin sütununa dağıtılır
+    for (MX t = 0; t < B.row; t++)
+    {
+        half_to_float_n(row, B.data + (size_t)t * B.ld, B.col, B.format);
+
+        for (MX j = 0; j < B.col; j++)
+        {
+            Bt.vrows[j]->elements[t] = row[j];
+        }
+    }
+
+    memory_free(row);
+
+    __dot_rows_matrix(A, Bt, &C);
+
+    __free_matrix(&Bt);
+
+    PROFILE_END(PROFILE_HALF_MULTIPLICATION, 2ull * A.row * A.col * B.col,
+                (size_t)B.row * B.col * sizeof(uint16_t) + ((size_t)A.row * A.col + (size_t)A.row * B.col) * sizeof(float));
+
+    return C;
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include <stdint.h>
+
+#include "vmatrix.h"
+#include "../CMATH/vec.h"
+
+#ifndef VHALF_H
+#define VHALF_H
+
+/**
+ * @brief 16 bitlik kayan nokta biçimleri.
+ *
+ * HALF_FP16 : IEEE 754 binary16 (5 bit üs, 10 bit kesir), en büyük değer 65504
+ * HALF_BF16 : bfloat16, float'un üst 16 biti (8 bit üs, 7 bit kesir)
+ *
+ * Değerler float'a en yakın çifte yuvarlanarak çevrilir. Tüm hesaplar
+ * float birikeçlerle yapılır; yalnızca saklama 16 bittir.
+ */
+typedef enum
+{
+    HALF_FP16,
+    HALF_BF16
+
+} half_format;
+
+typedef struct
+{
+    half_format format;
+    MX dim;
+    uint16_t *data;
+
+} hvec;
+
+/**
+ * @brief Satır i, data + i * ld adresindedir; ld 32'nin katıdır (64 bayt).
+ */
+typedef struct
+{
+    half_format format;
+    MX row;
+    MX col;
+    MX ld;
+    uint16_t *data;
+
+} hmatrix;
+
+extern const hvec HVEC_UNDEFINED;
+extern const hmatrix HMATRIX_UNDEFINED;
+
+uint16_t __float_to_half(float x, half_format format);
+float __half_to_float(uint16_t h, half_format format);
+
+hvec __half_vector(vec v, half_format format);
+vec __half_vector_to_float(hvec h);
+void __free_half_vector(hvec *h);
+
+hmatrix __half_matrix(matrix matx, half_format format);
+matrix __half_matrix_to_float(hmatrix h);
+void __free_half_matrix(hmatrix *h);
+
+float __half_get(hmatrix h, MX i, MX j);
+
+/**
+ * @brief a . b ve |a - b|; a çekirdek içinde float'a çevrilir.
+ */
+float __half_dot(hvec a, vec b);
+float __half_distance(hvec a, vec b);
+
+/**
+ * @brief y = A . x.
+ *
+ * @param A
+ * @param x A.col boyutlu
+ * @return vec
+ */
+vec __half_matvec(hmatrix A, vec x);
+
+/**
+ * @brief Her satırın x'e öklid uzaklığı (ör. gömme tablosunda arama).
+ *
+ * @param A
+ * @param x A.col boyutlu
+ * @return vec A.row boyutlu
+ */
+vec __half_row_distances(hmatrix A, vec x);
+
+/**
+ * @brief C = A . B, A 16 bit.
+ *
+ * A'nın satırları küçük bloklar halinde float'a çevrilip __multiplication_matrix
+ * ile aynı çekirdekle çarpılır; A'nın float kopyası oluşturulmaz.
+ *
+ * @param A
+ * @param B
+ * @return matrix
+ */
+matrix __half_multiplication(hmatrix A, matrix B);
+
+/**
+ * @brief C = A . B, B 16 bit. B, float çarpımın zaten ayırdığı transpoze
+ * tamponuna çevrilerek yazılır.
+ *
+ * @param A
+ * @param B
+ * @return matrix
+ */
+matrix __half_multiplication_right(matrix A, hmatrix B);
+
+#endif
\ No newline at end of file
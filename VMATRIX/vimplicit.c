@@ -0,0 +1,456 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//
+//      VIMPLICIT.C
+//  Birim, sıfır, skaler ve köşegen
+//  matrixlerin kapalı gösterimi
+//
+#include "vimplicit.h"
+#include "vmap.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği eleman sayısı.
+ */
+#define IMPLICIT_CHUNK 32768
+
+static unsigned long implicit_grain(MX col)
+{
+    return col >= IMPLICIT_CHUNK ? 1 : IMPLICIT_CHUNK / (col > 0 ? col : 1);
+}
+
+const implicit_matrix IMPLICIT_UNDEFINED = {IMPLICIT_ZERO, 0, 0, 0.0f, {0, NULL, NULL}};
+
+static implicit_matrix implicit_new(implicit_kind kind, MX row, MX col, float scalar)
+{
+    implicit_matrix m = {kind, row, col, scalar, VEC_UNDEFINED};
+
+    return m;
+}
+
+implicit_matrix __implicit_zero(MX row, MX col)
+{
+    return implicit_new(IMPLICIT_ZERO, row, col, 0.0f);
+}
+
+implicit_matrix __implicit_identity(MX n)
+{
+    return implicit_new(IMPLICIT_IDENTITY, n, n, 1.0f);
+}
+
+implicit_matrix __implicit_scalar(MX n, float scalar)
+{
+    return implicit_new(IMPLICIT_SCALAR, n, n, scalar);
+}
+
+implicit_matrix __implicit_diagonal(vec d)
+{
+    implicit_matrix m = implicit_new(IMPLICIT_DIAGONAL, d.dim, d.dim, 0.0f);
+
+    m.diag = allocate_vector_mem(d.dim);
+    memcpy(m.diag.elements, d.elements, d.dim * sizeof(float));
+
+    return m;
+}
+
+void __free_implicit(implicit_matrix *m)
+{
+    if (m->kind == IMPLICIT_DIAGONAL)
+    {
+        free_vector(&m->diag);
+    }
+
+    m->diag = VEC_UNDEFINED;
+}
+
+float __implicit_diag_at(implicit_matrix m, MX i)
+{
+    switch (m.kind)
+    {
+    case IMPLICIT_ZERO:
+        return 0.0f;
+    case IMPLICIT_IDENTITY:
+        return 1.0f;
+    case IMPLICIT_SCALAR:
+        return m.scalar;
+    case IMPLICIT_DIAGONAL:
+    default:
+        return m.diag.elements[i];
+    }
+}
+
+/**
+ * @brief Birim matrix skalerin özel halidir; işlemler iki türü birlikte ele alır.
+ */
+static bool implicit_is_scalar(implicit_matrix m)
+{
+    return m.kind == IMPLICIT_IDENTITY || m.kind == IMPLICIT_SCALAR;
+}
+
+/**
+ * @brief fn(a_i, b_i) köşegenli yeni köşegen matrix.
+ */
+static implicit_matrix implicit_diag_zip(implicit_matrix a, implicit_matrix b, bool multiply)
+{
+    implicit_matrix m = implicit_new(IMPLICIT_DIAGONAL, a.row, a.row, 0.0f);
+
+    m.diag = allocate_vector_mem(a.row);
+
+    for (MX i = 0; i < a.row; i++)
+    {
+        float x = __implicit_diag_at(a, i), y = __implicit_diag_at(b, i);
+
+        m.diag.elements[i] = multiply ? x * y : x + y;
+    }
+
+    return m;
+}
+
+/**
+ * @brief Sonuç özel matrixin bağımsız bir kopyası (köşegen kopyalanır).
+ */
+static implicit_matrix implicit_copy(implicit_matrix a)
+{
+    return a.kind == IMPLICIT_DIAGONAL ? __implicit_diagonal(a.diag) : a;
+}
+
+implicit_matrix __implicit_multiplication(implicit_matrix a, implicit_matrix b)
+{
+    if (a.col != b.row)
+    {
+        printf("\n\nDimention Error implicit multiplication function\n\n");
+        return IMPLICIT_UNDEFINED;
+    }
+
+    if (a.kind == IMPLICIT_ZERO || b.kind == IMPLICIT_ZERO)
+    {
+        return __implicit_zero(a.row, b.col);
+    }
+
+    if (a.kind == IMPLICIT_IDENTITY)
+    {
+        return implicit_copy(b);
+    }
+
+    if (b.kind == IMPLICIT_IDENTITY)
+    {
+        return implicit_copy(a);
+    }
+
+    if (implicit_is_scalar(a) && implicit_is_scalar(b))
+    {
+        return __implicit_scalar(a.row, a.scalar * b.scalar);
+    }
+
+    return implicit_diag_zip(a, b, true);
+}
+
+implicit_matrix __implicit_sum(implicit_matrix a, implicit_matrix b)
+{
+    if (a.row != b.row || a.col != b.col)
+    {
+        printf("\n\nDimention Error implicit add function\n\n");
+        return IMPLICIT_UNDEFINED;
+    }
+
+    if (a.kind == IMPLICIT_ZERO)
+    {
+        return implicit_copy(b);
+    }
+
+    if (b.kind == IMPLICIT_ZERO)
+    {
+        return implicit_copy(a);
+    }
+
+    if (implicit_is_scalar(a) && implicit_is_scalar(b))
+    {
+        return __implicit_scalar(a.row, a.scalar + b.scalar);
+    }
+
+    return implicit_diag_zip(a, b, false);
+}
+
+implicit_matrix __implicit_power(implicit_matrix a, unsigned int pow)
+{
+    if (a.row != a.col)
+    {
+        printf("\n\nDimention Error implicit power function\n\n");
+        return IMPLICIT_UNDEFINED;
+    }
+
+    if (pow == 0 || a.kind == IMPLICIT_IDENTITY)
+    {
+        return __implicit_identity(a.row);
+    }
+
+    switch (a.kind)
+    {
+    case IMPLICIT_ZERO:
+        return a;
+    case IMPLICIT_SCALAR:
+        return __implicit_scalar(a.row, powf(a.scalar, (float)pow));
+    case IMPLICIT_DIAGONAL:
+    default:
+    {
+        implicit_matrix m = __implicit_diagonal(a.diag);
+
+        for (MX i = 0; i < m.row; i++)
+        {
+            m.diag.elements[i] = powf(m.diag.elements[i], (float)pow);
+        }
+
+        return m;
+    }
+    }
+}
+
+implicit_matrix __implicit_transpose(implicit_matrix a)
+{
+    if (a.kind == IMPLICIT_ZERO)
+    {
+        return __implicit_zero(a.col, a.row);
+    }
+
+    // Köşegen matrixler simetriktir
+    return implicit_copy(a);
+}
+
+matrix __implicit_to_matrix(implicit_matrix m)
+{
+    matrix ret_matrix = __zero_matrix(m.row, m.col);
+
+    if (m.kind != IMPLICIT_ZERO)
+    {
+        for (MX i = 0; i < m.row; i++)
+        {
+            ret_matrix.vrows[i]->elements[i] = __implicit_diag_at(m, i);
+        }
+    }
+
+    return ret_matrix;
+}
+
+typedef struct
+{
+    implicit_matrix a;
+    matrix *matx;
+
+} implicit_ctx;
+
+/**
+ * @brief Satır i, a'nın i. köşegen elemanı ile ölçeklenir.
+ */
+static void scale_rows_task(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    implicit_ctx *c = (implicit_ctx *)arg;
+    (void)worker;
+
+    for (unsigned long i = begin; i < end; i++)
+    {
+        float *x = c->matx->vrows[i]->elements;
+        float d = __implicit_diag_at(c->a, (MX)i);
+
+        if (d == 0.0f)
+        {
+            memset(x, 0, c->matx->col * sizeof(float));
+        }
+        else if (d != 1.0f)
+        {
+            simd_scale(x, x, d, c->matx->col);
+        }
+    }
+}
+
+/**
+ * @brief Her satır köşegen ile eleman eleman çarpılır (sütun ölçekleme).
+ */
+static void scale_cols_task(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    implicit_ctx *c = (implicit_ctx *)arg;
+    zip_kernel mul = __zip_kernel(ZIP_MUL, 0.0f, 0.0f);
+    (void)worker;
+
+    for (unsigned long i = begin; i < end; i++)
+    {
+        float *x = c->matx->vrows[i]->elements;
+
+        __zip_span(&mul, x, x, c->a.diag.elements, c->matx->col);
+    }
+}
+
+bool __implicit_multiplication_left_ptr(implicit_matrix a, matrix *B)
+{
+    if (a.col != B->row || a.row != a.col)
+    {
+        printf("\n\nDimention Error implicit multiplication function\n\n");
+        return false;
+    }
+
+    if (a.kind == IMPLICIT_IDENTITY)
+    {
+        return true;
+    }
+
+    __unshare_matrix(B);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_IMPLICIT);
+
+    implicit_ctx ctx = {a, B};
+
+    parallel_for(0, B->row, implicit_grain(B->col), scale_rows_task, &ctx);
+
+    PROFILE_END(PROFILE_MATRIX_IMPLICIT, (unsigned long long)B->row * B->col,
+                2ull * B->row * B->col * sizeof(float));
+
+    return true;
+}
+
+bool __implicit_multiplication_right_ptr(matrix *A, implicit_matrix b)
+{
+    if (A->col != b.row || b.row != b.col)
+    {
+        printf("\n\nDimention Error implicit multiplication function\n\n");
+        return false;
+    }
+
+    if (b.kind == IMPLICIT_IDENTITY)
+    {
+        return true;
+    }
+
+    // Skaler ve sıfır matrix her iki taraftan da aynı etkiyi yapar
+    if (b.kind != IMPLICIT_DIAGONAL)
+    {
+        return __implicit_multiplication_left_ptr(__implicit_scalar(A->row, b.scalar), A);
+    }
+
+    __unshare_matrix(A);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_IMPLICIT);
+
+    implicit_ctx ctx = {b, A};
+
+    parallel_for(0, A->row, implicit_grain(A->col), scale_cols_task, &ctx);
+
+    PROFILE_END(PROFILE_MATRIX_IMPLICIT, (unsigned long long)A->row * A->col,
+                (2ull * A->row * A->col + A->col) * sizeof(float));
+
+    return true;
+}
+
+matrix __implicit_multiplication_left(implicit_matrix a, matrix B)
+{
+    if (a.col != B.row)
+    {
+        printf("\n\nDimention Error implicit multiplication function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    // Dikdörtgen sıfır matrix de bu yoldan geçer
+    if (a.kind == IMPLICIT_ZERO)
+    {
+        return __zero_matrix(a.row, B.col);
+    }
+
+    matrix ret_matrix = __copy_matrix(B);
+
+    __implicit_multiplication_left_ptr(a, &ret_matrix);
+
+    return ret_matrix;
+}
+
+matrix __implicit_multiplication_right(matrix A, implicit_matrix b)
+{
+    if (A.col != b.row)
+    {
+        printf("\n\nDimention Error implicit multiplication function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    if (b.kind == IMPLICIT_ZERO)
+    {
+        return __zero_matrix(A.row, b.col);
+    }
+
+    matrix ret_matrix = __copy_matrix(A);
+
+    __implicit_multiplication_right_ptr(&ret_matrix, b);
+
+    return ret_matrix;
+}
+
+/**
+ * @brief A[i][i] += sign * b[i][i]; yalnızca köşegen okunur ve yazılır.
+ */
+static bool implicit_add_ptr(matrix *A, implicit_matrix b, float sign)
+{
+    if (A->row != b.row || A->col != b.col)
+    {
+        printf("\n\nDimention Error implicit add function\n\n");
+        return false;
+    }
+
+    if (b.kind == IMPLICIT_ZERO)
+    {
+        return true;
+    }
+
+    __unshare_matrix(A);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_IMPLICIT);
+
+    for (MX i = 0; i < A->row; i++)
+    {
+        A->vrows[i]->elements[i] += sign * __implicit_diag_at(b, i);
+    }
+
+    PROFILE_END(PROFILE_MATRIX_IMPLICIT, A->row, 2ull * A->row * sizeof(float));
+
+    return true;
+}
+
+bool __implicit_sum_matrix_ptr(matrix *A, implicit_matrix b)
+{
+    return implicit_add_ptr(A, b, 1.0f);
+}
+
+bool __implicit_substract_matrix_ptr(matrix *A, implicit_matrix b)
+{
+    return implicit_add_ptr(A, b, -1.0f);
+}
+
+matrix __implicit_sum_matrix(matrix A, implicit_matrix b)
+{
+    if (A.row != b.row || A.col != b.col)
+    {
+        printf("\n\nDimention Error implicit add function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = __copy_matrix(A);
+
+    implicit_add_ptr(&ret_matrix, b, 1.0f);
+
+    return ret_matrix;
+}
+
+matrix __implicit_substract_matrix(matrix A, implicit_matrix b)
+{
+    if (A.row != b.row || A.col != b.col)
+    {
+        printf("\n\nDimention Error implicit substract function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = __copy_matrix(A);
+
+    implicit_add_ptr(&ret_matrix, b, -1.0f);
+
+    return ret_matrix;
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "vmatrix.h"
+#include "../CMATH/vec.h"
+
+#ifndef VIMPLICIT_H
+#define VIMPLICIT_H
+
+/**
+ * @brief Elemanları tutulmayan özel matrixler.
+ *
+ * IMPLICIT_ZERO     : row x col sıfır matrix, O(1) bellek
+ * IMPLICIT_IDENTITY : n x n birim matrix, O(1) bellek
+ * IMPLICIT_SCALAR   : scalar * I, O(1) bellek
+ * IMPLICIT_DIAGONAL : köşegeni diag olan n x n matrix, O(n) bellek
+ */
+typedef enum
+{
+    IMPLICIT_ZERO,
+    IMPLICIT_IDENTITY,
+    IMPLICIT_SCALAR,
+    IMPLICIT_DIAGONAL
+
+} implicit_kind;
+
+typedef struct
+{
+    implicit_kind kind;
+    MX row;
+    MX col;
+
+    /* IMPLICIT_SCALAR için katsayı */
+    float scalar;
+
+    /* IMPLICIT_DIAGONAL için köşegen, diğerlerinde VEC_UNDEFINED */
+    vec diag;
+
+} implicit_matrix;
+
+/**
+ * @brief Boyutları uymayan işlemlerin sonucu (0 x 0 sıfır matrix).
+ */
+extern const implicit_matrix IMPLICIT_UNDEFINED;
+
+implicit_matrix __implicit_zero(MX row, MX col);
+implicit_matrix __implicit_identity(MX n);
+implicit_matrix __implicit_scalar(MX n, float scalar);
+
+/**
+ * @brief Köşegen matrix; d kopyalanır.
+ *
+ * @param d
+ * @return implicit_matrix
+ */
+implicit_matrix __implicit_diagonal(vec d);
+
+void __free_implicit(implicit_matrix *m);
+
+/**
+ * @brief A[i][i] (köşegen dışı elemanlar her zaman 0'dır).
+ *
+ * @param m
+ * @param i
+ * @return float
+ */
+float __implicit_diag_at(implicit_matrix m, MX i);
+
+/**
+ * @brief Yoğun matrix karşılığı.
+ *
+ * @param m
+ * @return matrix
+ */
+matrix __implicit_to_matrix(implicit_matrix m);
+
+/**
+ * @brief Özel matrixler arasındaki işlemler kapalı biçimde hesaplanır
+ * ve yine özel matrix döner (köşegen için O(n), diğerleri için O(1)).
+ * pow = 0 birim matrix verir.
+ */
+implicit_matrix __implicit_multiplication(implicit_matrix a, implicit_matrix b);
+implicit_matrix __implicit_sum(implicit_matrix a, implicit_matrix b);
+implicit_matrix __implicit_power(implicit_matrix a, unsigned int pow);
+implicit_matrix __implicit_transpose(implicit_matrix a);
+
+/**
+ * @brief a . B; köşegen için satırlar ölçeklenir (O(n m)), çarpma yapılmaz.
+ *
+ * @param a
+ * @param B
+ * @return matrix
+ */
+matrix __implicit_multiplication_left(implicit_matrix a, matrix B);
+
+/**
+ * @brief A . b; köşegen için sütunlar ölçeklenir.
+ *
+ * @param A
+ * @param b
+ * @return matrix
+ */
+matrix __implicit_multiplication_right(matrix A, implicit_matrix b);
+
+/**
+ * @brief Sonucu B'ye / A'ya yazar.
+ */
+bool __implicit_multiplication_left_ptr(implicit_matrix a, matrix *B);
+bool __implicit_multiplication_right_ptr(matrix *A, implicit_matrix b);
+
+/**
+ * @brief A + b ve A - b; yalnızca köşegen değişir.
+ *
+ * _ptr sürümleri yerinde çalışır ve O(n) sürer (ör. A + lambda I).
+ */
+matrix __implicit_sum_matrix(matrix A, implicit_matrix b);
+matrix __implicit_substract_matrix(matrix A, implicit_matrix b);
+bool __implicit_sum_matrix_ptr(matrix *A, implicit_matrix b);
+bool __implicit_substract_matrix_ptr(matrix *A, implicit_matrix b);
+
+#endif
\ No newline at end of file
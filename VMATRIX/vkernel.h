@@ -0,0 +1,50 @@
+#include <stddef.h>
+
+#include "vmatrix.h"
+
+#ifndef VKERNEL_H
+#define VKERNEL_H
+
+/**
+ * @brief İki matrixin satırları arasındaki tüm iç çarpımları hesaplar (C = A.B^T).
+ *
+ * C[(i - a_begin) * ldc + (j - b_begin)] = A_i . B_j
+ * a_begin <= i < a_end, b_begin <= j < b_end
+ *
+ * A ve B aynı sütun sayısına sahip olmalıdır. B satırları önbellekte kalacak
+ * şekilde bloklara bölünür ve her adımda 4x4 satır çifti birlikte işlenir.
+ * __multiplication_matrix ve uzaklık fonksiyonlarının ortak çekirdeğidir.
+ *
+ * @param A
+ * @param a_begin
+ * @param a_end
+ * @param B
+ * @param b_begin
+ * @param b_end
+ * @param C Sonuç tamponu
+ * @param ldc C'nin satır adımı (float)
+ */
+void __dot_rows_block(matrix A, MX a_begin, MX a_end,
+                      matrix B, MX b_begin, MX b_end,
+                      float *C, size_t ldc);
+
+/**
+ * @brief C = A.B^T, C önceden ayrılmış A.row x B.row boyutlu ve bitişik olmalıdır.
+ *
+ * C'nin uzun kenarı özyinelemeli olarak ikiye bölünür ve bloklar
+ * parallel_run ile iş çalan zamanlayıcıya dağıtılır; yapraklar
+ * __dot_rows_block çağırır.
+ *
+ * @param A
+ * @param B
+ * @param C
+ */
+void __dot_rows_matrix(matrix A, matrix B, matrix *C);
+
+/**
+ * @brief __dot_rows_matrix bu kadar çarpma-toplamdan küçük blokları tek
+ * görevde hesaplar; daha küçük çarpımlar paralel çalışmaz.
+ */
+#define MULTIPLY_LEAF_WORK (1ull << 21)
+
+#endif
\ No newline at end of file
@@ -0,0 +1,445 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//
+//      VKNN.C
+//  Matrix satırları üzerinde
+//  en yakın k komşu araması
+//
+#include "vknn.h"
+#include "vkernel.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Birlikte skorlanan sorgu ve veritabanı satırı sayısı.
+ */
+#define KNN_QUERY_BLOCK 64
+#define KNN_DB_BLOCK 256
+
+const knn_result KNN_UNDEFINED = {0, 0, NULL, NULL};
+
+/**
+ * @brief Thread'lerin paylaştığı arama durumu.
+ *
+ * İçeride tüm ölçüler "küçük daha iyi" sıralama skoruna çevrilir:
+ *  öklid  : ||y||^2 - 2 x.y   (||x||^2 sorgu için sabit)
+ *  kosinüs: -x.y / ||y||       (||x|| sorgu için sabit)
+ *  iç çarpım: -x.y
+ */
+typedef struct
+{
+    matrix queries;
+    matrix database;
+    MX k;
+    pairwise_metric metric;
+
+    /* Veritabanı için ||y||^2 veya 1/||y|| */
+    const float *db_terms;
+
+    MX query_blocks;
+    MX shards;
+
+    /* (sorgu, parça) başına k elemanlı yığınlar */
+    float *heap_scores;
+    unsigned int *heap_indices;
+    MX *heap_counts;
+
+    /* Thread başına skor bloğu */
+    float *scratch;
+
+    knn_result *result;
+
+} knn_state;
+
+/**
+ * @brief (s1, i1) adayı (s2, i2)'den kötü ise true
+ */
+static inline bool knn_worse(float s1, unsigned int i1, float s2, unsigned int i2)
+{
+    return s1 > s2 || (s1 == s2 && i1 > i2);
+}
+
+/**
+ * @brief En kötü aday tepede olacak şekilde k elemanlı yığına ekler.
+ */
+static void knn_heap_push(float *hs, unsigned int *hi, MX *count, MX k, float s, unsigned int idx)
+{
+    MX n = *count;
+
+    if (n < k)
+    {
+        // Yukarı kaydır
+        MX pos = n++;
+
+        while (pos > 0)
+        {
+            MX parent = (pos - 1) / 2;
+
+            if (!knn_worse(s, idx, hs[parent], hi[parent]))
+            {
+                break;
+            }
+
+            hs[pos] = hs[parent];
+            hi[pos] = hi[parent];
+            pos = parent;
+        }
+
+        hs[pos] = s;
+        hi[pos] = idx;
+        *count = n;
+        return;
+    }
+
+    if (!knn_worse(hs[0], hi[0], s, idx))
+    {
+        return;
+    }
+
+    // Tepeyi değiştirip aşağı kaydır
+    MX pos = 0;
+
+    for (;;)
+    {
+        MX child = 2 * pos + 1;
+
+        if (child >= n)
+        {
+            break;
+        }
+        if (child + 1 < n && knn_worse(hs[child + 1], hi[child + 1], hs[child], hi[child]))
+        {
+            child++;
+        }
+        if (!knn_worse(hs[child], hi[child], s, idx))
+        {
+            break;
+        }
+
+        hs[pos] = hs[child];
+        hi[pos] = hi[child];
+        pos = child;
+    }
+
+    hs[pos] = s;
+    hi[pos] = idx;
+}
+
+/**
+ * @brief Bir skor satırını yığına süzer. Yığındaki en kötü skordan
+ * iyi olmayan adaylar SIMD karşılaştırması ile topluca elenir.
+ */
+static void knn_select(const float *scores, unsigned int first_index, MX n,
+                       float *hs, unsigned int *hi, MX *count, MX k)
+{
+    MX j = 0;
+
+    // Yığın dolana kadar her aday eklenir
+    for (; j < n && *count < k; j++)
+    {
+        knn_heap_push(hs, hi, count, k, scores[j], first_index + j);
+    }
+
+#if SIMD_WIDTH > 1
+    for (; j + SIMD_WIDTH <= n; j += SIMD_WIDTH)
+    {
+        unsigned int mask = simd_lt_mask(simd_loadu(scores + j), simd_set1(hs[0]));
+
+        while (mask != 0)
+        {
+            unsigned int lane = (unsigned int)__builtin_ctz(mask);
+            mask &= mask - 1;
+
+            knn_heap_push(hs, hi, count, k, scores[j + lane], first_index + j + lane);
+        }
+    }
+#endif
+
+    for (; j < n; j++)
+    {
+        if (scores[j] < hs[0])
+        {
+            knn_heap_push(hs, hi, count, k, scores[j], first_index + j);
+        }
+    }
+}
+
+/**
+ * @brief Bir (sorgu bloğu, veritabanı parçası) görevini çalıştırır.
+ */
+static void knn_task(void *ctx, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    knn_state *st = (knn_state *)ctx;
+    float *tile = st->scratch + (size_t)worker * KNN_QUERY_BLOCK * KNN_DB_BLOCK;
+
+    for (unsigned long task = begin; task < end; task++)
+    {
+        MX qb = (MX)(task / st->shards);
+        MX shard = (MX)(task % st->shards);
+
+        MX q0 = qb * KNN_QUERY_BLOCK;
+        MX q1 = q0 + KNN_QUERY_BLOCK < st->queries.row ? q0 + KNN_QUERY_BLOCK : st->queries.row;
+
+        MX n = st->database.row;
+        MX d_begin = (MX)((unsigned long long)n * shard / st->shards);
+        MX d_end = (MX)((unsigned long long)n * (shard + 1) / st->shards);
+
+        for (MX d0 = d_begin; d0 < d_end; d0 += KNN_DB_BLOCK)
+        {
+            MX d1 = d0 + KNN_DB_BLOCK < d_end ? d0 + KNN_DB_BLOCK : d_end;
+            MX width = d1 - d0;
+
+            __dot_rows_block(st->queries, q0, q1, st->database, d0, d1, tile, KNN_DB_BLOCK);
+
+            for (MX q = q0; q < q1; q++)
+            {
+                float *row = tile + (size_t)(q - q0) * KNN_DB_BLOCK;
+                const float *terms = st->db_terms + d0;
+
+                // x.y değerleri sıralama skoruna çevrilir
+                switch (st->metric)
+                {
+                case PAIRWISE_EUCLIDEAN:
+                case PAIRWISE_SQEUCLIDEAN:
+                    for (MX j = 0; j < width; j++)
+                    {
+                        row[j] = terms[j] - 2.0f * row[j];
+                    }
+                    break;
+                case PAIRWISE_COSINE:
+                case PAIRWISE_COSINE_SIMILARITY:
+                    for (MX j = 0; j < width; j++)
+                    {
+                        row[j] = -row[j] * terms[j];
+                    }
+                    break;
+                case PAIRWISE_DOT:
+                default:
+                    for (MX j = 0; j < width; j++)
+                    {
+                        row[j] = -row[j];
+                    }
+                    break;
+                }
+
+                size_t heap = (size_t)q * st->shards + shard;
+
+                knn_select(row, d0, width, st->heap_scores + heap * st->k,
+                           st->heap_indices + heap * st->k, &st->heap_counts[heap], st->k);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Birleştirmede sıralama için aday.
+ */
+typedef struct
+{
+    float score;
+    unsigned int index;
+
+} knn_candidate;
+
+static int knn_candidate_compare(const void *a, const void *b)
+{
+    const knn_candidate *x = (const knn_candidate *)a;
+    const knn_candidate *y = (const knn_candidate *)b;
+
+    if (knn_worse(x->score, x->index, y->score, y->index))
+    {
+        return 1;
+    }
+    if (knn_worse(y->score, y->index, x->score, x->index))
+    {
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Parça yığınlarını birleştirir ve skorları ölçünün kendi birimine çevirir.
+ */
+static void knn_merge(void *ctx, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    (void)worker;
+
+    knn_state *st = (knn_state *)ctx;
+    knn_result *res = st->result;
+    knn_candidate *all = (knn_candidate *)MEMORY_ALLOC((size_t)st->shards * st->k * sizeof(knn_candidate));
+
+    __allocation_err(all, "knn merge");
+
+    for (unsigned long q = begin; q < end; q++)
+    {
+        MX total = 0;
+
+        for (MX s = 0; s < st->shards; s++)
+        {
+            size_t heap = q * st->shards + s;
+
+            for (MX i = 0; i < st->heap_counts[heap]; i++)
+            {
+                all[total].score = st->heap_scores[heap * st->k + i];
+                all[total].index = st->heap_indices[heap * st->k + i];
+                total++;
+            }
+        }
+
+        qsort(all, total, sizeof(knn_candidate), knn_candidate_compare);
+
+        const float *x = st->queries.vrows[q]->elements;
+        float x_term = st->metric == PAIRWISE_DOT ? 0.0f : simd_dot(x, x, st->queries.col);
+
+        for (MX i = 0; i < res->k; i++)
+        {
+            float s = all[i].score;
+
+            switch (st->metric)
+            {
+            case PAIRWISE_EUCLIDEAN:
+            case PAIRWISE_SQEUCLIDEAN:
+                s += x_term;
+                s = s > 0.0f ? s : 0.0f;
+                s = st->metric == PAIRWISE_EUCLIDEAN ? sqrtf(s) : s;
+                break;
+            case PAIRWISE_COSINE:
+            case PAIRWISE_COSINE_SIMILARITY:
+                s = x_term > 0.0f ? -s / sqrtf(x_term) : 0.0f;
+                s = st->metric == PAIRWISE_COSINE ? 1.0f - s : s;
+                break;
+            case PAIRWISE_DOT:
+            default:
+                s = -s;
+                break;
+            }
+
+            res->indices[q * res->k + i] = all[i].index;
+            res->scores[q * res->k + i] = s;
+        }
+    }
+
+    memory_free(all);
+}
+
+knn_result __knn_search(matrix queries, matrix database, MX k, pairwise_metric metric)
+{
+    if (queries.col != database.col || database.row == 0 || k == 0)
+    {
+        printf("\n\nDimention Error knn search function\n\n");
+        return KNN_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_KNN);
+
+    if (k > database.row)
+    {
+        k = database.row;
+    }
+
+    // Boş sorgu grubu için boş sonuç (parça sayısı sorgu bloklarına bölünür)
+    if (queries.row == 0)
+    {
+        knn_result empty = {0, k, NULL, NULL};
+
+        PROFILE_END(PROFILE_MATRIX_KNN, 0, 0);
+        return empty;
+    }
+
+    knn_state st;
+    st.queries = queries;
+    st.database = database;
+    st.k = k;
+    st.metric = metric;
+
+    // Veritabanı satırlarının sabit terimleri bir kez hesaplanır
+    float *terms = (float *)MEMORY_ALLOC(database.row * sizeof(float));
+
+    __allocation_err(terms, "knn norms");
+
+    for (MX j = 0; j < database.row; j++)
+    {
+        const float *y = database.vrows[j]->elements;
+        float n2 = simd_dot(y, y, database.col);
+
+        if (metric == PAIRWISE_COSINE || metric == PAIRWISE_COSINE_SIMILARITY)
+        {
+            terms[j] = n2 > 0.0f ? 1.0f / sqrtf(n2) : 0.0f;
+        }
+        else
+        {
+            terms[j] = n2;
+        }
+    }
+    st.db_terms = terms;
+
+    // Az sorgu varsa veritabanı thread sayısının birkaç katı parçaya bölünür
+    unsigned int threads = parallel_threads();
+    MX db_blocks = (database.row + KNN_DB_BLOCK - 1) / KNN_DB_BLOCK;
+
+    st.query_blocks = (queries.row + KNN_QUERY_BLOCK - 1) / KNN_QUERY_BLOCK;
+    st.shards = (4 * threads + st.query_blocks - 1) / st.query_blocks;
+    st.shards = st.shards < db_blocks ? st.shards : db_blocks;
+    st.shards = st.shards > 0 ? st.shards : 1;
+
+    size_t heaps = (size_t)queries.row * st.shards;
+
+    st.heap_scores = (float *)MEMORY_ALLOC(heaps * k * sizeof(float));
+    st.heap_indices = (unsigned int *)MEMORY_ALLOC(heaps * k * sizeof(unsigned int));
+    st.heap_counts = (MX *)MEMORY_ALLOC(heaps * sizeof(MX));
+    st.scratch = (float *)MEMORY_ALLOC((size_t)threads * KNN_QUERY_BLOCK * KNN_DB_BLOCK * sizeof(float));
+
+    __allocation_err(st.heap_scores, "knn heaps");
+    __allocation_err(st.heap_indices, "knn heaps");
+    __allocation_err(st.heap_counts, "knn heaps");
+    __allocation_err(st.scratch, "knn scratch");
+
+    memset(st.heap_counts, 0, heaps * sizeof(MX));
+
+    parallel_for(0, (unsigned long)st.query_blocks * st.shards, 1, knn_task, &st);
+
+    knn_result res;
+    res.queries = queries.row;
+    res.k = k;
+    res.indices = (unsigned int *)MEMORY_ALLOC((size_t)queries.row * k * sizeof(unsigned int));
+    res.scores = (float *)MEMORY_ALLOC((size_t)queries.row * k * sizeof(float));
+
+    __allocation_err(res.indices, "knn result");
+    __allocation_err(res.scores, "knn result");
+
+    st.result = &res;
+
+    parallel_for(0, queries.row, 16, knn_merge, &st);
+
+    memory_free(terms);
+    memory_free(st.scratch);
+    memory_free(st.heap_scores);
+    memory_free(st.heap_indices);
+    memory_free(st.heap_counts);
+
+    PROFILE_END(PROFILE_MATRIX_KNN, 2ull * queries.row * database.row * database.col,
+                ((unsigned long long)queries.row + database.row) * database.col * sizeof(float));
+
+    return res;
+}
+
+knn_result __knn_search_vec(vec query, matrix database, MX k, pairwise_metric metric)
+{
+    // Vektör kopyalanmadan tek satırlı bir matrix olarak görülür
+    vec *row = &query;
+    matrix q = {1, query.dim, &row, NULL, query.elements, query.dim, 0};
+
+    return __knn_search(q, database, k, metric);
+}
+
+void __free_knn_result(knn_result *result)
+{
+    memory_free(result->indices);
+    memory_free(result->scores);
+
+    *result = KNN_UNDEFINED;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "vmatrix.h"
+#include "vdistance.h"
+#include "../CMATH/vec.h"
+
+#ifndef VKNN_H
+#define VKNN_H
+
+/**
+ * @brief En yakın k komşu arama sonucu.
+ *
+ * Sorgu q için i. komşu indices[q * k + i] ve scores[q * k + i] içindedir.
+ * Komşular en yakından uzağa sıralıdır (uzaklıklarda artan, benzerliklerde
+ * azalan skor). Eşit skorlarda küçük satır indeksi önce gelir.
+ */
+typedef struct
+{
+    MX queries;
+    MX k;
+
+    unsigned int *indices;
+    float *scores;
+
+} knn_result;
+
+/**
+ * @brief Tanımsız sonuç (hata durumlarında döner).
+ */
+extern const knn_result KNN_UNDEFINED;
+
+/**
+ * @brief Her sorgu satırı için veritabanındaki en yakın k satırı bulur (tam, kaba kuvvet).
+ *
+ * Skorlar sorgu ve veritabanı blokları arasında __multiplication_matrix ile
+ * aynı çekirdekte hesaplanır. Her sorgu için k büyüklüğünde bir yığın
+ * tutulur ve bir blok skoru, yığındaki en kötü skordan iyiyse SIMD
+ * karşılaştırması ile seçilip yığına eklenir. Veritabanı parçalara bölünüp
+ * thread'lere dağıtılır, parçaların sonuçları en sonda birleştirilir.
+ *
+ * @param queries Q x D sorgu matrixi; Q = 0 ise indices ve scores NULL olan boş sonuç
+ * @param database N x D veritabanı
+ * @param k Komşu sayısı (N'den büyükse N)
+ * @param metric
+ * @return knn_result
+ */
+knn_result __knn_search(matrix queries, matrix database, MX k, pairwise_metric metric);
+
+/**
+ * @brief Tek bir sorgu vektörü için en yakın k satır.
+ *
+ * @param query D boyutlu vektör
+ * @param database
+ * @param k
+ * @param metric
+ * @return knn_result
+ */
+knn_result __knn_search_vec(vec query, matrix database, MX k, pairwise_metric metric);
+
+/**
+ * @brief Sonucun belleğini serbest bırakır.
+ *
+ * @param result
+ */
+void __free_knn_result(knn_result *result);
+
+#endif
\ No newline at end of file
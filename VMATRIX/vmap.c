@@ -0,0 +1,455 @@
+#include <stdlib.h>
+#include <math.h>
+
+//
+//      VMAP.C
+//  Eleman bazında map / zip / zip3
+//  işlemleri
+//
+#include "vmap.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği eleman sayısı.
+ */
+#define MAP_CHUNK 16384
+
+//
+//  Span çekirdekleri: d[i] = f(x[i], y[i], z[i]), 0 <= i < n
+//  d, x, y veya z ile aynı adres olabilir.
+//
+
+#if SIMD_WIDTH > 1
+#define SPAN_LOOP(EXPR, SCALAR)                      \
+    for (; i + SIMD_WIDTH <= n; i += SIMD_WIDTH)     \
+    {                                                \
+        simd_storeu(d + i, EXPR);                    \
+    }                                                \
+    for (; i < n; i++)                               \
+    {                                                \
+        d[i] = SCALAR;                               \
+    }
+#else
+#define SPAN_LOOP(EXPR, SCALAR) \
+    for (; i < n; i++)          \
+    {                           \
+        d[i] = SCALAR;          \
+    }
+#endif
+
+#define X simd_loadu(x + i)
+#define Y simd_loadu(y + i)
+#define Z simd_loadu(z + i)
+
+void __map_span(const map_kernel *k, float *d, const float *x, MX n)
+{
+    MX i = 0;
+
+#if SIMD_WIDTH > 1
+    const simd_f va = simd_set1(k->a), vb = simd_set1(k->b);
+#endif
+
+    switch (k->op)
+    {
+    case MAP_ABS:
+        SPAN_LOOP(simd_absv(X), fabsf(x[i]))
+        break;
+    case MAP_NEGATE:
+        SPAN_LOOP(simd_subv(simd_zero(), X), -x[i])
+        break;
+    case MAP_SQUARE:
+        SPAN_LOOP(simd_mulv(X, X), x[i] * x[i])
+        break;
+    case MAP_SQRT:
+        SPAN_LOOP(simd_sqrtv(X), sqrtf(x[i]))
+        break;
+    case MAP_AFFINE:
+        SPAN_LOOP(simd_fmaddv(va, X, vb), k->a * x[i] + k->b)
+        break;
+    case MAP_CLAMP:
+        SPAN_LOOP(simd_minv(simd_maxv(X, va), vb),
+                  x[i] < k->a ? k->a : (x[i] > k->b ? k->b : x[i]))
+        break;
+    case MAP_MIN:
+        SPAN_LOOP(simd_minv(X, va), x[i] < k->a ? x[i] : k->a)
+        break;
+    case MAP_MAX:
+        SPAN_LOOP(simd_maxv(X, va), x[i] > k->a ? x[i] : k->a)
+        break;
+    case MAP_CUSTOM:
+    default:
+        for (; i < n; i++)
+        {
+            d[i] = k->fn(x[i], k->ctx);
+        }
+        break;
+    }
+}
+
+void __zip_span(const zip_kernel *k, float *d, const float *x, const float *y, MX n)
+{
+    MX i = 0;
+
+#if SIMD_WIDTH > 1
+    const simd_f va = simd_set1(k->a), vb = simd_set1(k->b);
+#endif
+
+    switch (k->op)
+    {
+    case ZIP_ADD:
+        SPAN_LOOP(simd_addv(X, Y), x[i] + y[i])
+        break;
+    case ZIP_SUB:
+        SPAN_LOOP(simd_subv(X, Y), x[i] - y[i])
+        break;
+    case ZIP_MUL:
+        SPAN_LOOP(simd_mulv(X, Y), x[i] * y[i])
+        break;
+    case ZIP_DIV:
+        SPAN_LOOP(simd_divv(X, Y), x[i] / y[i])
+        break;
+    case ZIP_MIN:
+        SPAN_LOOP(simd_minv(X, Y), x[i] < y[i] ? x[i] : y[i])
+        break;
+    case ZIP_MAX:
+        SPAN_LOOP(simd_maxv(X, Y), x[i] > y[i] ? x[i] : y[i])
+        break;
+    case ZIP_AXPBY:
+        SPAN_LOOP(simd_fmaddv(va, X, simd_mulv(vb, Y)), k->a * x[i] + k->b * y[i])
+        break;
+    case ZIP_CUSTOM:
+    default:
+        for (; i < n; i++)
+        {
+            d[i] = k->fn(x[i], y[i], k->ctx);
+        }
+        break;
+    }
+}
+
+static void zip3_span(const zip3_kernel *k, float *d, const float *x, const float *y, const float *z, MX n)
+{
+    MX i = 0;
+
+    switch (k->op)
+    {
+    case ZIP3_FMA:
+        SPAN_LOOP(simd_fmaddv(X, Y, Z), x[i] * y[i] + z[i])
+        break;
+    case ZIP3_SELECT:
+        SPAN_LOOP(simd_select_nz(X, Y, Z), x[i] != 0.0f ? y[i] : z[i])
+        break;
+    case ZIP3_CLAMP:
+        SPAN_LOOP(simd_minv(simd_maxv(X, Y), Z),
+                  x[i] < y[i] ? y[i] : (x[i] > z[i] ? z[i] : x[i]))
+        break;
+    case ZIP3_CUSTOM:
+    default:
+        for (; i < n; i++)
+        {
+            d[i] = k->fn(x[i], y[i], z[i], k->ctx);
+        }
+        break;
+    }
+}
+
+#undef X
+#undef Y
+#undef Z
+#undef SPAN_LOOP
+
+/**
+ * @brief parallel_for'a verilen iş. Matrixlerde indeksler satır,
+ * vektörlerde eleman indeksidir.
+ */
+typedef struct
+{
+    unsigned int arity;
+    const void *kernel;
+
+    /* Matrix girişleri (out NULL değilse) */
+    matrix *out;
+    matrix mx, my, mz;
+
+    /* Vektör girişleri */
+    float *d;
+    const float *x, *y, *z;
+
+} map_job;
+
+static void map_job_span(const map_job *job, float *d, const float *x, const float *y, const float *z, MX n)
+{
+    switch (job->arity)
+    {
+    case 1:
+        __map_span((const map_kernel *)job->kernel, d, x, n);
+        break;
+    case 2:
+        __zip_span((const zip_kernel *)job->kernel, d, x, y, n);
+        break;
+    default:
+        zip3_span((const zip3_kernel *)job->kernel, d, x, y, z, n);
+        break;
+    }
+}
+
+static void map_matrix_task(void *ctx, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    (void)worker;
+
+    const map_job *job = (const map_job *)ctx;
+
+    for (unsigned long i = begin; i < end; i++)
+    {
+        map_job_span(job, job->out->vrows[i]->elements,
+                     job->mx.vrows[i]->elements,
+                     job->arity > 1 ? job->my.vrows[i]->elements : NULL,
+                     job->arity > 2 ? job->mz.vrows[i]->elements : NULL,
+                     job->out->col);
+    }
+}
+
+static void map_vector_task(void *ctx, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    (void)worker;
+
+    const map_job *job = (const map_job *)ctx;
+
+    map_job_span(job, job->d + begin, job->x + begin,
+                 job->arity > 1 ? job->y + begin : NULL,
+                 job->arity > 2 ? job->z + begin : NULL,
+                 (MX)(end - begin));
+}
+
+/**
+ * @brief Kernel geçerli mi (özel işlemde fonksiyon verilmiş mi).
+ */
+static bool map_kernel_valid(unsigned int arity, const void *kernel)
+{
+    switch (arity)
+    {
+    case 1:
+        return ((const map_kernel *)kernel)->op != MAP_CUSTOM || ((const map_kernel *)kernel)->fn != NULL;
+    case 2:
+        return ((const zip_kernel *)kernel)->op != ZIP_CUSTOM || ((const zip_kernel *)kernel)->fn != NULL;
+    default:
+        return ((const zip3_kernel *)kernel)->op != ZIP3_CUSTOM || ((const zip3_kernel *)kernel)->fn != NULL;
+    }
+}
+
+/**
+ * @brief Matrix işlemlerinin boyut ve işlev denetimi; sonuç ayrılmadan veya
+ * paylaşılan depolama kopyalanmadan önce yapılır.
+ */
+static bool map_matrix_check(unsigned int arity, const void *kernel, matrix X, matrix Y, matrix Z)
+{
+    if ((arity > 1 && (Y.row != X.row || Y.col != X.col)) ||
+        (arity > 2 && (Z.row != X.row || Z.col != X.col)))
+    {
+        printf("\n\nDimention Error elementwise map function\n\n");
+        return false;
+    }
+
+    if (!map_kernel_valid(arity, kernel))
+    {
+        printf("\n\nCustom elementwise map requires a function\n\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Matrix işlemlerinin ortak gövdesi. Girdiler map_matrix_check ile
+ * denetlenmiş, out önceden ayrılmış olmalıdır; out X ile aynı matrix olabilir.
+ */
+static void map_matrix_run(unsigned int arity, const void *kernel, matrix *out,
+                           matrix X, matrix Y, matrix Z)
+{
+    PROFILE_BEGIN(PROFILE_MATRIX_MAP);
+
+    map_job job = {arity, kernel, out, X, Y, Z, NULL, NULL, NULL, NULL};
+    unsigned long grain = X.col >= MAP_CHUNK ? 1 : MAP_CHUNK / (X.col > 0 ? X.col : 1);
+
+    parallel_for(0, X.row, grain, map_matrix_task, &job);
+
+    PROFILE_END(PROFILE_MATRIX_MAP, (unsigned long long)X.row * X.col,
+                (arity + 1ull) * X.row * X.col * sizeof(float));
+}
+
+/**
+ * @brief Vektör işlemlerinin ortak gövdesi.
+ */
+static bool map_vector_run(unsigned int arity, const void *kernel, vec *out, vec x, vec y, vec z)
+{
+    if ((arity > 1 && y.dim != x.dim) || (arity > 2 && z.dim != x.dim))
+    {
+        printf("\n* Dimention Error\n");
+        return false;
+    }
+
+    if (!map_kernel_valid(arity, kernel))
+    {
+        printf("\n* Custom elementwise map requires a function\n");
+        return false;
+    }
+
+    PROFILE_BEGIN(PROFILE_VECTOR_MAP);
+
+    map_job job = {arity, kernel, NULL, MATRIX_UNDEFINED, MATRIX_UNDEFINED, MATRIX_UNDEFINED,
+                   out->elements, x.elements, y.elements, z.elements};
+
+    parallel_for(0, x.dim, MAP_CHUNK, map_vector_task, &job);
+
+    PROFILE_END(PROFILE_VECTOR_MAP, x.dim, (arity + 1ull) * x.dim * sizeof(float));
+
+    return true;
+}
+
+matrix __map_matrix(matrix matx, map_kernel kernel)
+{
+    if (!map_matrix_check(1, &kernel, matx, MATRIX_UNDEFINED, MATRIX_UNDEFINED))
+    {
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = __allocate_row_vectors(matx.row, matx.col);
+
+    map_matrix_run(1, &kernel, &ret_matrix, matx, MATRIX_UNDEFINED, MATRIX_UNDEFINED);
+
+    return ret_matrix;
+}
+
+void __map_matrix_ptr(matrix *matx, map_kernel kernel)
+{
+    if (!map_matrix_check(1, &kernel, *matx, MATRIX_UNDEFINED, MATRIX_UNDEFINED))
+    {
+        return;
+    }
+
+    __unshare_matrix(matx);
+
+    map_matrix_run(1, &kernel, matx, *matx, MATRIX_UNDEFINED, MATRIX_UNDEFINED);
+}
+
+matrix __zip_matrix(matrix X, matrix Y, zip_kernel kernel)
+{
+    if (!map_matrix_check(2, &kernel, X, Y, MATRIX_UNDEFINED))
+    {
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = __allocate_row_vectors(X.row, X.col);
+
+    map_matrix_run(2, &kernel, &ret_matrix, X, Y, MATRIX_UNDEFINED);
+
+    return ret_matrix;
+}
+
+void __zip_matrix_ptr(matrix *X, matrix Y, zip_kernel kernel)
+{
+    if (!map_matrix_check(2, &kernel, *X, Y, MATRIX_UNDEFINED))
+    {
+        return;
+    }
+
+    // Y, X ile aynı depolamayı paylaşıyorsa okunacak değerler değişmez
+    __unshare_matrix(X);
+
+    map_matrix_run(2, &kernel, X, *X, Y, MATRIX_UNDEFINED);
+}
+
+matrix __zip3_matrix(matrix X, matrix Y, matrix Z, zip3_kernel kernel)
+{
+    if (!map_matrix_check(3, &kernel, X, Y, Z))
+    {
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = __allocate_row_vectors(X.row, X.col);
+
+    map_matrix_run(3, &kernel, &ret_matrix, X, Y, Z);
+
+    return ret_matrix;
+}
+
+void __zip3_matrix_ptr(matrix *X, matrix Y, matrix Z, zip3_kernel kernel)
+{
+    if (!map_matrix_check(3, &kernel, *X, Y, Z))
+    {
+        return;
+    }
+
+    __unshare_matrix(X);
+
+    map_matrix_run(3, &kernel, X, *X, Y, Z);
+}
+
+vec __map_vector(vec v, map_kernel kernel)
+{
+    vec ret_vec = allocate_vector_mem(v.dim);
+
+    if (!map_vector_run(1, &kernel, &ret_vec, v, VEC_UNDEFINED, VEC_UNDEFINED))
+    {
+        free_vector(&ret_vec);
+        return VEC_UNDEFINED;
+    }
+
+    return ret_vec;
+}
+
+void __map_vector_ptr(vec *v, map_kernel kernel)
+{
+    map_vector_run(1, &kernel, v, *v, VEC_UNDEFINED, VEC_UNDEFINED);
+}
+
+vec __zip_vector(vec x, vec y, zip_kernel kernel)
+{
+    if (x.dim != y.dim)
+    {
+        printf("\n* Dimention Error\n");
+        return VEC_UNDEFINED;
+    }
+
+    vec ret_vec = allocate_vector_mem(x.dim);
+
+    if (!map_vector_run(2, &kernel, &ret_vec, x, y, VEC_UNDEFINED))
+    {
+        free_vector(&ret_vec);
+        return VEC_UNDEFINED;
+    }
+
+    return ret_vec;
+}
+
+bool __zip_vector_ptr(vec *x, vec y, zip_kernel kernel)
+{
+    return map_vector_run(2, &kernel, x, *x, y, VEC_UNDEFINED);
+}
+
+vec __zip3_vector(vec x, vec y, vec z, zip3_kernel kernel)
+{
+    if (x.dim != y.dim || x.dim != z.dim)
+    {
+        printf("\n* Dimention Error\n");
+        return VEC_UNDEFINED;
+    }
+
+    vec ret_vec = allocate_vector_mem(x.dim);
+
+    if (!map_vector_run(3, &kernel, &ret_vec, x, y, z))
+    {
+        free_vector(&ret_vec);
+        return VEC_UNDEFINED;
+    }
+
+    return ret_vec;
+}
+
+bool __zip3_vector_ptr(vec *x, vec y, vec z, zip3_kernel kernel)
+{
+    return map_vector_run(3, &kernel, x, *x, y, z);
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "vmatrix.h"
+#include "../CMATH/vec.h"
+
+#ifndef VMAP_H
+#define VMAP_H
+
+/**
+ * @brief Kullanıcı tanımlı eleman fonksiyonları. ctx çağrıya olduğu gibi geçirilir.
+ *
+ * Fonksiyonlar birden fazla thread'den aynı anda çağrılabilir; ctx
+ * üzerine yazıyorlarsa kendi senkronizasyonlarını yapmalıdır.
+ */
+typedef float (*map_fn)(float x, void *ctx);
+typedef float (*zip_fn)(float x, float y, void *ctx);
+typedef float (*zip3_fn)(float x, float y, float z, void *ctx);
+
+/**
+ * @brief Tek girişli hazır işlemler (SIMD ile çalışır).
+ *
+ * MAP_CUSTOM : fn(x, ctx)
+ * MAP_ABS    : |x|
+ * MAP_NEGATE : -x
+ * MAP_SQUARE : x * x
+ * MAP_SQRT   : sqrt(x)
+ * MAP_AFFINE : a * x + b
+ * MAP_CLAMP  : a <= x <= b aralığına kırpar
+ * MAP_MIN    : min(x, a)
+ * MAP_MAX    : max(x, a)   (a = 0 ise ReLU)
+ */
+typedef enum
+{
+    MAP_CUSTOM,
+    MAP_ABS,
+    MAP_NEGATE,
+    MAP_SQUARE,
+    MAP_SQRT,
+    MAP_AFFINE,
+    MAP_CLAMP,
+    MAP_MIN,
+    MAP_MAX
+
+} map_op;
+
+/**
+ * @brief İki girişli hazır işlemler.
+ *
+ * ZIP_CUSTOM : fn(x, y, ctx)
+ * ZIP_ADD, ZIP_SUB, ZIP_MUL, ZIP_DIV : x op y
+ * ZIP_MIN, ZIP_MAX : min(x, y), max(x, y)
+ * ZIP_AXPBY : a * x + b * y
+ */
+typedef enum
+{
+    ZIP_CUSTOM,
+    ZIP_ADD,
+    ZIP_SUB,
+    ZIP_MUL,
+    ZIP_DIV,
+    ZIP_MIN,
+    ZIP_MAX,
+    ZIP_AXPBY
+
+} zip_op;
+
+/**
+ * @brief Üç girişli hazır işlemler.
+ *
+ * ZIP3_CUSTOM : fn(x, y, z, ctx)
+ * ZIP3_FMA    : x * y + z
+ * ZIP3_SELECT : x != 0 ise y, değilse z (where)
+ * ZIP3_CLAMP  : x'i [y, z] aralığına kırpar
+ */
+typedef enum
+{
+    ZIP3_CUSTOM,
+    ZIP3_FMA,
+    ZIP3_SELECT,
+    ZIP3_CLAMP
+
+} zip3_op;
+
+/**
+ * @brief Uygulanacak işlem: hazır bir işlem ve parametreleri
+ * ya da op = *_CUSTOM ile fonksiyon ve bağlamı.
+ */
+typedef struct
+{
+    map_op op;
+    float a;
+    float b;
+
+    map_fn fn;
+    void *ctx;
+
+} map_kernel;
+
+typedef struct
+{
+    zip_op op;
+    float a;
+    float b;
+
+    zip_fn fn;
+    void *ctx;
+
+} zip_kernel;
+
+typedef struct
+{
+    zip3_op op;
+
+    zip3_fn fn;
+    void *ctx;
+
+} zip3_kernel;
+
+static inline map_kernel __map_kernel(map_op op, float a, float b)
+{
+    map_kernel k = {op, a, b, NULL, NULL};
+    return k;
+}
+
+static inline map_kernel __map_custom(map_fn fn, void *ctx)
+{
+    map_kernel k = {MAP_CUSTOM, 0.0f, 0.0f, fn, ctx};
+    return k;
+}
+
+static inline zip_kernel __zip_kernel(zip_op op, float a, float b)
+{
+    zip_kernel k = {op, a, b, NULL, NULL};
+    return k;
+}
+
+static inline zip_kernel __zip_custom(zip_fn fn, void *ctx)
+{
+    zip_kernel k = {ZIP_CUSTOM, 0.0f, 0.0f, fn, ctx};
+    return k;
+}
+
+static inline zip3_kernel __zip3_kernel(zip3_op op)
+{
+    zip3_kernel k = {op, NULL, NULL};
+    return k;
+}
+
+static inline zip3_kernel __zip3_custom(zip3_fn fn, void *ctx)
+{
+    zip3_kernel k = {ZIP3_CUSTOM, fn, ctx};
+    return k;
+}
+
+/**
+ * @brief Her elemana kernel uygulanmış yeni matrix.
+ *
+ * Satırlar parçalara bölünüp parallel_for ile thread'lere dağıtılır.
+ *
+ * @param matx
+ * @param kernel
+ * @return matrix
+ */
+matrix __map_matrix(matrix matx, map_kernel kernel);
+
+/**
+ * @brief Kernel'i matrixin elemanlarına yerinde uygular.
+ *
+ * @param matx
+ * @param kernel
+ */
+void __map_matrix_ptr(matrix *matx, map_kernel kernel);
+
+/**
+ * @brief C[i][j] = kernel(X[i][j], Y[i][j]). Boyutlar aynı olmalıdır.
+ *
+ * @param X
+ * @param Y
+ * @param kernel
+ * @return matrix
+ */
+matrix __zip_matrix(matrix X, matrix Y, zip_kernel kernel);
+
+/**
+ * @brief Sonucu X'e yazar.
+ *
+ * @param X
+ * @param Y
+ * @param kernel
+ */
+void __zip_matrix_ptr(matrix *X, matrix Y, zip_kernel kernel);
+
+/**
+ * @brief C[i][j] = kernel(X[i][j], Y[i][j], Z[i][j]). Boyutlar aynı olmalıdır.
+ *
+ * @param X
+ * @param Y
+ * @param Z
+ * @param kernel
+ * @return matrix
+ */
+matrix __zip3_matrix(matrix X, matrix Y, matrix Z, zip3_kernel kernel);
+
+/**
+ * @brief Sonucu X'e yazar.
+ *
+ * @param X
+ * @param Y
+ * @param Z
+ * @param kernel
+ */
+void __zip3_matrix_ptr(matrix *X, matrix Y, matrix Z, zip3_kernel kernel);
+
+/**
+ * @brief Tek bir aralık üzerinde çalışan çekirdekler: d[i] = kernel(x[i] [, y[i]]).
+ * d, x veya y ile aynı adres olabilir. Diğer modüllerin (ör. vgraph) kendi
+ * döngülerinde kullanması içindir; thread'lere bölme yapmazlar.
+ */
+void __map_span(const map_kernel *kernel, float *d, const float *x, MX n);
+void __zip_span(const zip_kernel *kernel, float *d, const float *x, const float *y, MX n);
+
+/**
+ * @brief Vektör karşılıkları. _ptr sürümleri sonucu ilk vektöre yazar.
+ */
+vec __map_vector(vec v, map_kernel kernel);
+void __map_vector_ptr(vec *v, map_kernel kernel);
+vec __zip_vector(vec x, vec y, zip_kernel kernel);
+bool __zip_vector_ptr(vec *x, vec y, zip_kernel kernel);
+vec __zip3_vector(vec x, vec y, vec z, zip3_kernel kernel);
+bool __zip3_vector_ptr(vec *x, vec y, vec z, zip3_kernel kernel);
+
+#endif
\ No newline at end of file
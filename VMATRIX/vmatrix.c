@@ -1,6 +1,8 @@
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <math.h>
+#include <stdatomic.h>
 
 //
 //      VMATRIX.H
@@ -9,7 +11,12 @@
 //
 //
 #include "vmatrix.h"
+#include "vkernel.h"
 #include "../CMATH/vec.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
 
 /**
  * @file vmatrix.c
@@ -27,7 +34,21 @@
  * işlem basamakalrında yaşanacak olumsuzluklar
  * için bir geridönüş değeridir.
  */
-const matrix MATRIX_UNDEFINED = {0, 0, NULL};
+const matrix MATRIX_UNDEFINED = {0, 0, NULL, NULL, NULL, 0, 0};
+
+/**
+ * @brief Paylaşılan depolamayı kullanan tutamaç sayısı.
+ *
+ * __adopt_matrix ile alınan tamponlarda son tutamaç bırakıldığında
+ * release(data, ctx) çağrılır.
+ */
+struct matrix_share
+{
+    atomic_uint refs;
+
+    buffer_release_fn release;
+    void *ctx;
+};
 
 /**
  * @brief Fonksiyonlarda meydana gelen bellek tahsilat hataları kontrolü
@@ -50,16 +71,18 @@ void __allocation_err(void *ptr, const char *msg)
  * @brief Vektör pointerını işaret eden pointerın işaret ettiği vektör.
  *
  * @param size
+ * @param func, file, line Tahsis yeri
  * @return vec*
  */
-vec *__allocate_vector_mem(MX size)
+vec *__allocate_vector_mem_at(MX size, const char *func, const char *file, int line)
 {
-    vec *v = (vec *)malloc(sizeof(vec));
+    vec *v = (vec *)memory_alloc(sizeof(vec), func, file, line);
 
     __allocation_err(v, "vector pointer");
 
     v->dim = size;
-    v->elements = (float *)malloc(size * sizeof(float));
+    v->elements = (float *)memory_alloc_aligned(size * sizeof(float), MEMORY_ALIGNMENT, func, file, line);
+    v->owner = NULL;
 
     __allocation_err(v->elements, "vector elements pointer");
 
@@ -67,32 +90,358 @@ vec *__allocate_vector_mem(MX size)
 }
 
 /**
- * @brief Matrix'i vektörler ile ifade etmek.
+ * @brief col sütunlu bir matrix için otomatik seçilen satır adımı.
+ *
+ * @param col
+ * @return MX
+ */
+MX __leading_dimension(MX col)
+{
+    // 64 bayta (16 float) yuvarla
+    MX ld = (col + 15u) & ~15u;
+
+    // 1 KB'ın katı adımlar sütun gezinmesinde aynı önbellek kümelerine düşer
+    if (ld >= 256 && ld % 256 == 0)
+    {
+        ld += 16;
+    }
+
+    return ld;
+}
+
+/**
+ * @brief Satır adımı verilerek matrix tahsis eder.
+ *
+ * Satırlar tek parça, 64 bayta hizalı bir tamponda tutulur. vrows ve
+ * satır vektörlerinin başlıkları da tek blok olarak tahsis edilir.
  *
  * @param row
  * @param col
+ * @param ld 0 ise otomatik
+ * @param func, file, line Tahsis yeri
  * @return matrix
  */
-matrix __allocate_row_vectors(MX row, MX col)
+matrix __allocate_matrix_ld_at(MX row, MX col, MX ld, const char *func, const char *file, int line)
 {
+    PROFILE_BEGIN(PROFILE_ALLOCATION);
+
+    if (ld == 0)
+    {
+        ld = __leading_dimension(col);
+    }
+    else if (ld < col)
+    {
+        printf("\n\nLeading dimension is smaller than column count\n\n");
+        ld = col;
+    }
 
     matrix rt_matrix;
     rt_matrix.row = row;
     rt_matrix.col = col;
+    rt_matrix.share = NULL;
+    rt_matrix.ld = ld;
 
-    /* Vektör boyutunda row adet vektör yeri bellekten tahsil edilir */
-    rt_matrix.vrows = (vec **)malloc(row * sizeof(vec *));
+    /* Vektör boyutunda row adet vektör yeri ve başlıkları bellekten tahsil edilir */
+    rt_matrix.vrows = (vec **)memory_alloc(row * (sizeof(vec *) + sizeof(vec)), func, file, line);
 
     __allocation_err(rt_matrix.vrows, "Row Vectors");
 
+    rt_matrix.data = (float *)memory_alloc_aligned((size_t)row * ld * sizeof(float), MEMORY_ALIGNMENT,
+                                                   func, file, line);
+
+    __allocation_err(rt_matrix.data, "Matrix elements");
+
+    rt_matrix.flags = MATRIX_CONTIGUOUS;
+
+    if (ld % 16 == 0)
+    {
+        rt_matrix.flags |= MATRIX_ALIGNED;
+    }
+    if (ld > col)
+    {
+        rt_matrix.flags |= MATRIX_PADDED;
+    }
+
+    vec *headers = (vec *)(rt_matrix.vrows + row);
+
+    for (MX i = 0; i < row; i++)
+    {
+        headers[i].dim = col;
+        headers[i].elements = rt_matrix.data + (size_t)i * ld;
+        headers[i].owner = NULL;
+
+        // Dolgu sıfırlanır, böylece SIMD ile okunabilir
+        memset(headers[i].elements + col, 0, (ld - col) * sizeof(float));
+
+        rt_matrix.vrows[i] = &headers[i];
+    }
+
+    PROFILE_END(PROFILE_ALLOCATION, 0, 0);
+
+    return rt_matrix;
+}
+
+/**
+ * @brief Matrix'i vektörler ile ifade etmek.
+ *
+ * @param row
+ * @param col
+ * @param func, file, line Tahsis yeri
+ * @return matrix
+ */
+matrix __allocate_row_vectors_at(MX row, MX col, const char *func, const char *file, int line)
+{
+    return __allocate_matrix_ld_at(row, col, 0, func, file, line);
+}
+
+/**
+ * @brief Başka bir depolamanın satırlarını gösterecek matrix başlığı ayırır.
+ * Satır başlıklarının elements alanları çağıran tarafından doldurulur.
+ */
+static matrix matrix_view(MX row, MX col, const char *msg)
+{
+    matrix rt_matrix = MATRIX_UNDEFINED;
+
+    rt_matrix.row = row;
+    rt_matrix.col = col;
+    rt_matrix.vrows = (vec **)MEMORY_ALLOC(row * (sizeof(vec *) + sizeof(vec)));
+
+    __allocation_err(rt_matrix.vrows, msg);
+
+    vec *headers = (vec *)(rt_matrix.vrows + row);
+
     for (MX i = 0; i < row; i++)
     {
-        rt_matrix.vrows[i] = __allocate_vector_mem(col); // her vektör için bellek tahsis et
+        headers[i].dim = col;
+        headers[i].elements = NULL;
+        headers[i].owner = NULL;
+        rt_matrix.vrows[i] = &headers[i];
     }
 
+    rt_matrix.flags = MATRIX_BORROWED;
+
     return rt_matrix;
 }
 
+/**
+ * @brief Satırlar data + i * ld ise görünümü tek parça olarak işaretler.
+ */
+static void matrix_view_contiguous(matrix *view, float *data, MX ld)
+{
+    view->data = data;
+    view->ld = ld;
+    view->flags |= MATRIX_CONTIGUOUS;
+
+    if ((uintptr_t)data % MEMORY_ALIGNMENT == 0 && ld % 16 == 0)
+    {
+        view->flags |= MATRIX_ALIGNED;
+    }
+}
+
+/**
+ * @brief fmatrix'i kopyalamadan matrix olarak kullanır.
+ *
+ * @param matx
+ * @return matrix
+ */
+matrix __matrix_from_fmatrix(fmatrix matx)
+{
+    if (matx.elements == NULL)
+    {
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = matrix_view(matx.row, matx.col, "Matrix view");
+    bool contiguous = matx.row > 0;
+
+    for (MX i = 0; i < matx.row; i++)
+    {
+        ret_matrix.vrows[i]->elements = matx.elements[i];
+        contiguous = contiguous && matx.elements[i] == matx.elements[0] + (size_t)i * matx.col;
+    }
+
+    if (contiguous)
+    {
+        matrix_view_contiguous(&ret_matrix, matx.elements[0], matx.col);
+    }
+
+    return ret_matrix;
+}
+
+/**
+ * @brief matrix satırlarını gösteren fmatrix.
+ *
+ * @param matx
+ * @return fmatrix
+ */
+fmatrix __fmatrix_from_matrix(matrix matx)
+{
+    if (matx.vrows == NULL)
+    {
+        return FMATRIX_UNDEFINED;
+    }
+
+    fmatrix ret_matrix = {matx.row, matx.col, (float **)MEMORY_ALLOC(matx.row * sizeof(float *))};
+
+    __allocation_err(ret_matrix.elements, "Matrix view");
+
+    for (MX i = 0; i < matx.row; i++)
+    {
+        ret_matrix.elements[i] = matx.vrows[i]->elements;
+    }
+
+    return ret_matrix;
+}
+
+/**
+ * @brief float dizisini kopyalamadan matrix olarak kullanır.
+ *
+ * @param data
+ * @param row
+ * @param col
+ * @param ld
+ * @return matrix
+ */
+matrix __matrix_from_buffer(float *data, MX row, MX col, MX ld)
+{
+    ld = ld == 0 ? col : ld;
+
+    if (data == NULL || ld < col)
+    {
+        printf("\n\nInvalid buffer for matrix view\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = matrix_view(row, col, "Matrix view");
+
+    for (MX i = 0; i < row; i++)
+    {
+        ret_matrix.vrows[i]->elements = data + (size_t)i * ld;
+    }
+
+    matrix_view_contiguous(&ret_matrix, data, ld);
+
+    return ret_matrix;
+}
+
+/**
+ * @brief float dizisini kopyalamadan matrix olarak kullanır ve son tutamaç
+ * bırakıldığında release fonksiyonunu çağırır.
+ *
+ * @param data
+ * @param row
+ * @param col
+ * @param ld
+ * @param release NULL ise __matrix_from_buffer ile aynıdır
+ * @param ctx
+ * @return matrix
+ */
+matrix __adopt_matrix(float *data, MX row, MX col, MX ld, buffer_release_fn release, void *ctx)
+{
+    matrix ret_matrix = __matrix_from_buffer(data, row, col, ld);
+
+    if (ret_matrix.vrows == NULL || release == NULL)
+    {
+        return ret_matrix;
+    }
+
+    ret_matrix.share = (matrix_share *)MEMORY_ALLOC(sizeof(matrix_share));
+
+    __allocation_err(ret_matrix.share, "Share counter");
+
+    atomic_init(&ret_matrix.share->refs, 1);
+    ret_matrix.share->release = release;
+    ret_matrix.share->ctx = ctx;
+
+    return ret_matrix;
+}
+
+/**
+ * @brief Satır satır yerleşmiş float dizisinden yeni bir matrix oluşturur.
+ *
+ * @param data
+ * @param row
+ * @param col
+ * @param ld Satır adımı (float); 0 ise col
+ * @return matrix
+ */
+matrix __matrix_from_array(const float *data, MX row, MX col, MX ld)
+{
+    if (data == NULL || (ld != 0 && ld < col))
+    {
+        printf("\n\nInvalid array for matrix\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = __allocate_row_vectors(row, col);
+
+    __fill_matrix(&ret_matrix, data, ld);
+
+    return ret_matrix;
+}
+
+/**
+ * @brief Matrixin elemanlarını satır satır yerleşmiş bir float dizisinden doldurur.
+ *
+ * @param matx
+ * @param data
+ * @param ld Satır adımı (float); 0 ise matx->col
+ * @return bool
+ */
+bool __fill_matrix(matrix *matx, const float *data, MX ld)
+{
+    ld = ld == 0 ? matx->col : ld;
+
+    if (data == NULL || ld < matx->col)
+    {
+        printf("\n\nInvalid array for matrix\n\n");
+        return false;
+    }
+
+    __unshare_matrix(matx);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_CREATE);
+
+    // Her iki taraf da tek parça ve dolgusuzsa tek kopya yeterlidir
+    if ((matx->flags & MATRIX_CONTIGUOUS) && matx->ld == matx->col && ld == matx->col)
+    {
+        memcpy(matx->data, data, (size_t)matx->row * matx->col * sizeof(float));
+    }
+    else
+    {
+        for (MX i = 0; i < matx->row; i++)
+        {
+            memcpy(matx->vrows[i]->elements, data + (size_t)i * ld, matx->col * sizeof(float));
+        }
+    }
+
+    PROFILE_END(PROFILE_MATRIX_CREATE, 0, 2ull * matx->row * matx->col * sizeof(float));
+
+    return true;
+}
+
+/**
+ * @brief Tek parça matrixin eleman dizisi.
+ *
+ * @param matx
+ * @param ld
+ * @return float*
+ */
+float *__matrix_buffer(matrix matx, MX *ld)
+{
+    if (!(matx.flags & MATRIX_CONTIGUOUS))
+    {
+        return NULL;
+    }
+
+    if (ld != NULL)
+    {
+        *ld = matx.ld;
+    }
+
+    return matx.data;
+}
+
 /**
  * @brief Oluşturulan matrixin bellekten serbest bırakan fonksiyon
  *
@@ -100,12 +449,47 @@ matrix __allocate_row_vectors(MX row, MX col)
  */
 void __free_matrix(matrix *matx)
 {
-    for (MX i = 0; i < matx->row; i++)
+    PROFILE_BEGIN(PROFILE_MATRIX_FREE);
+
+    if (matx->share != NULL)
+    {
+        // Başka tutamaçlar hala kullanıyorsa sadece bu tutamaç bırakılır
+        if (atomic_fetch_sub(&matx->share->refs, 1) > 1)
+        {
+            matx->share = NULL;
+            PROFILE_END(PROFILE_MATRIX_FREE, 0, 0);
+            return;
+        }
+
+        if (matx->share->release != NULL)
+        {
+            matx->share->release(matx->data, matx->share->ctx);
+        }
+
+        memory_free(matx->share);
+        matx->share = NULL;
+    }
+
+    // Ödünç alınan elemanlar sahiplerine aittir; sıfır blokların elemanı yoktur
+    if (matx->flags & (MATRIX_BORROWED | MATRIX_ZERO_BLOCK))
+    {
+    }
+    else if (matx->flags & MATRIX_CONTIGUOUS)
+    {
+        memory_free_aligned(matx->data);
+    }
+    else
     {
-        free(matx->vrows[i]->elements);
-        free(matx->vrows[i]);
+        // Bayraksız matrix: satırlar __allocate_vector_mem ile tek tek kurulmuştur
+        for (MX i = 0; i < matx->row; i++)
+        {
+            free_vector(matx->vrows[i]);
+            memory_free(matx->vrows[i]);
+        }
     }
-    free(matx->vrows);
+    memory_free(matx->vrows);
+
+    PROFILE_END(PROFILE_MATRIX_FREE, 0, 0);
 }
 
 /**
@@ -153,6 +537,8 @@ matrix __identity_matrix(MX row, MX col)
         return MATRIX_UNDEFINED;
     }
 
+    PROFILE_BEGIN(PROFILE_MATRIX_CREATE);
+
     matrix rt_matrix = __allocate_row_vectors(row, col);
 
     for (MX i = 0; i < row; i++)
@@ -171,6 +557,8 @@ matrix __identity_matrix(MX row, MX col)
         }
     }
 
+    PROFILE_END(PROFILE_MATRIX_CREATE, 0, (unsigned long long)row * col * sizeof(float));
+
     return rt_matrix;
 }
 
@@ -183,6 +571,7 @@ matrix __identity_matrix(MX row, MX col)
  */
 matrix __zero_matrix(MX row, MX col)
 {
+    PROFILE_BEGIN(PROFILE_MATRIX_CREATE);
 
     matrix rt_matrix = __allocate_row_vectors(row, col);
 
@@ -194,6 +583,8 @@ matrix __zero_matrix(MX row, MX col)
         }
     }
 
+    PROFILE_END(PROFILE_MATRIX_CREATE, 0, (unsigned long long)row * col * sizeof(float));
+
     return rt_matrix;
 }
 
@@ -207,6 +598,8 @@ matrix __zero_matrix(MX row, MX col)
  */
 matrix __create_matrix(MX row, MX col, ...)
 {
+    PROFILE_BEGIN(PROFILE_MATRIX_CREATE);
+
     matrix ret_matrix = __allocate_row_vectors(row, col);
 
     va_list list;
@@ -233,6 +626,8 @@ matrix __create_matrix(MX row, MX col, ...)
 
     va_end(list);
 
+    PROFILE_END(PROFILE_MATRIX_CREATE, 0, (unsigned long long)row * col * sizeof(float));
+
     return ret_matrix;
 }
 
@@ -244,16 +639,17 @@ matrix __create_matrix(MX row, MX col, ...)
  */
 matrix __copy_matrix(matrix matx)
 {
+    PROFILE_BEGIN(PROFILE_MATRIX_COPY);
+
     matrix ret_matrix = __allocate_row_vectors(matx.row, matx.col);
 
     for (MX i = 0; i < ret_matrix.row; i++)
     {
-        for (MX c = 0; c < ret_matrix.col; c++)
-        {
-            ret_matrix.vrows[i]->elements[c] = matx.vrows[i]->elements[c];
-        }
+        memcpy(ret_matrix.vrows[i]->elements, matx.vrows[i]->elements, matx.col * sizeof(float));
     }
 
+    PROFILE_END(PROFILE_MATRIX_COPY, 0, 2ull * matx.row * matx.col * sizeof(float));
+
     return ret_matrix;
 }
 
@@ -265,6 +661,8 @@ matrix __copy_matrix(matrix matx)
  */
 matrix *__copy_matrix_ptr(matrix matx)
 {
+    PROFILE_BEGIN(PROFILE_MATRIX_COPY);
+
     matrix *ret_ptr = (matrix *)malloc(sizeof(matrix));
 
     __allocation_err(ret_ptr, "Copy function");
@@ -273,66 +671,168 @@ matrix *__copy_matrix_ptr(matrix matx)
 
     for (MX i = 0; i < matx.row; i++)
     {
-        for (MX c = 0; c < matx.col; c++)
-        {
-            ret_ptr->vrows[i]->elements[c] = matx.vrows[i]->elements[c];
-        }
+        memcpy(ret_ptr->vrows[i]->elements, matx.vrows[i]->elements, matx.col * sizeof(float));
     }
 
+    PROFILE_END(PROFILE_MATRIX_COPY, 0, 2ull * matx.row * matx.col * sizeof(float));
+
     return ret_ptr;
 }
 
 /**
- * @brief İki adet Matrix'in toplamını hesaplayan fonksiyon
+ * @brief Kopyalamadan, aynı depolamayı paylaşan yeni bir tutamaç döndürür.
  *
- * @param matx1 Toplanacak Matris
- * @param matx2 Toplama işlemi uygulanacak ikinci matris
- * @return matrix Toplam Matrisi
+ * @param matx Paylaşılacak matrix
+ * @return matrix
  */
-matrix __sum_matrix(matrix matx1, matrix matx2)
+matrix __share_matrix(matrix *matx)
 {
-    if (matx1.row != matx2.row || matx1.col != matx2.col)
+    if (matx->vrows == NULL)
     {
-        printf("\n\nDimention Error add function\n\n");
         return MATRIX_UNDEFINED;
     }
 
-    matrix ret_matx = __allocate_row_vectors(matx1.row, matx2.col);
-
-    for (MX i = 0; i < matx1.row; i++)
+    if (matx->share == NULL)
     {
-        for (MX c = 0; c < matx2.col; c++)
-        {
-            ret_matx.vrows[i]->elements[c] = matx1.vrows[i]->elements[c] +
-                                             matx2.vrows[i]->elements[c];
-        }
+        matx->share = (matrix_share *)MEMORY_ALLOC(sizeof(matrix_share));
+
+        __allocation_err(matx->share, "Share counter");
+
+        atomic_init(&matx->share->refs, 1);
+        matx->share->release = NULL;
+        matx->share->ctx = NULL;
     }
 
-    return ret_matx;
+    atomic_fetch_add(&matx->share->refs, 1);
+
+    return *matx;
 }
 
 /**
- * @brief Toplam sonucunu birinci matrise pointer ile eşitler.
+ * @brief Depolama paylaşılıyorsa matrixe özel bir kopya çıkarır.
  *
- * @param matx1 Toplam sonucunu içeren matris
- * @param matx2 Toplanacak ikinci matris
+ * @param matx
  */
-void __sum_matrix_ptr(matrix *matx1, matrix matx2)
+void __unshare_matrix(matrix *matx)
 {
-    if (matx1->row != matx2.row || matx1->col != matx2.col)
+    matrix_share *share = matx->share;
+
+    if (share == NULL)
     {
-        printf("\n\nDimention Error add with pointer function\n\n");
         return;
     }
 
+    // Tek kullanıcı bu tutamaç ise kopyaya gerek yok; devralınan tamponun
+    // serbest bırakma fonksiyonu sayaçta tutulduğundan sayaç korunur
+    if (atomic_load(&share->refs) == 1)
+    {
+        if (share->release != NULL)
+        {
+            return;
+        }
+
+        memory_free(share);
+        matx->share = NULL;
+        return;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_COPY);
+
+    matrix own = __allocate_row_vectors(matx->row, matx->col);
+
+    for (MX i = 0; i < matx->row; i++)
+    {
+        memcpy(own.vrows[i]->elements, matx->vrows[i]->elements, matx->col * sizeof(float));
+    }
+
+    // Diğer tutamaçlar aynı anda bırakıldıysa eski depolamayı son çıkan serbest bırakır
+    matrix old = *matx;
+    *matx = own;
+    __free_matrix(&old);
+
+    PROFILE_END(PROFILE_MATRIX_COPY, 0, 2ull * own.row * own.col * sizeof(float));
+}
+
+/**
+ * @brief İki adet Matrix'in toplamını hesaplayan fonksiyon
+ *
+ * @param matx1 Toplanacak Matris
+ * @param matx2 Toplama işlemi uygulanacak ikinci matris
+ * @return matrix Toplam Matrisi
+ */
+matrix __sum_matrix(matrix matx1, matrix matx2)
+{
+    if (matx1.row != matx2.row || matx1.col != matx2.col)
+    {
+        printf("\n\nDimention Error add function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_SUM);
+
+    matrix ret_matx = __allocate_row_vectors(matx1.row, matx2.col);
+
+    // Tüm satırlar hizalıysa hizalı SIMD yüklemeleri kullanılır
+    bool aligned = (matx1.flags & matx2.flags & MATRIX_ALIGNED) != 0;
+
+    for (MX i = 0; i < matx1.row; i++)
+    {
+        float *dst = ret_matx.vrows[i]->elements;
+
+        if (aligned)
+        {
+            simd_add_a(dst, matx1.vrows[i]->elements, matx2.vrows[i]->elements, matx1.col);
+        }
+        else
+        {
+            simd_add(dst, matx1.vrows[i]->elements, matx2.vrows[i]->elements, matx1.col);
+        }
+    }
+
+    PROFILE_END(PROFILE_MATRIX_SUM, (unsigned long long)matx1.row * matx1.col,
+                3ull * matx1.row * matx1.col * sizeof(float));
+
+    return ret_matx;
+}
+
+/**
+ * @brief Toplam sonucunu birinci matrise pointer ile eşitler.
+ *
+ * @param matx1 Toplam sonucunu içeren matris
+ * @param matx2 Toplanacak ikinci matris
+ */
+void __sum_matrix_ptr(matrix *matx1, matrix matx2)
+{
+    if (matx1->row != matx2.row || matx1->col != matx2.col)
+    {
+        printf("\n\nDimention Error add with pointer function\n\n");
+        return;
+    }
+
+    // Paylaşılan depolamaya yazılmadan önce özel kopya alınır
+    __unshare_matrix(matx1);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_SUM);
+
+    bool aligned = (matx1->flags & matx2.flags & MATRIX_ALIGNED) != 0;
+
     for (MX i = 0; i < matx1->row; i++)
     {
-        for (MX c = 0; c < matx2.row; c++)
+        float *dst = matx1->vrows[i]->elements;
+
+        if (aligned)
         {
-            matx1->vrows[i]->elements[c] += matx2.vrows[i]->elements[c];
+            simd_add_a(dst, dst, matx2.vrows[i]->elements, matx1->col);
+        }
+        else
+        {
+            simd_add(dst, dst, matx2.vrows[i]->elements, matx1->col);
         }
     }
 
+    PROFILE_END(PROFILE_MATRIX_SUM, (unsigned long long)matx1->row * matx1->col,
+                3ull * matx1->row * matx1->col * sizeof(float));
+
     return;
 }
 
@@ -351,17 +851,30 @@ matrix __substract_matrix(matrix matx1, matrix matx2)
         return MATRIX_UNDEFINED;
     }
 
+    PROFILE_BEGIN(PROFILE_MATRIX_SUBSTRACT);
+
     matrix ret_matx = __allocate_row_vectors(matx1.row, matx2.col);
 
+    // Tüm satırlar hizalıysa hizalı SIMD yüklemeleri kullanılır
+    bool aligned = (matx1.flags & matx2.flags & MATRIX_ALIGNED) != 0;
+
     for (MX i = 0; i < matx1.row; i++)
     {
-        for (MX c = 0; c < matx2.col; c++)
+        float *dst = ret_matx.vrows[i]->elements;
+
+        if (aligned)
         {
-            ret_matx.vrows[i]->elements[c] = matx1.vrows[i]->elements[c] -
-                                             matx2.vrows[i]->elements[c];
+            simd_sub_a(dst, matx1.vrows[i]->elements, matx2.vrows[i]->elements, matx1.col);
+        }
+        else
+        {
+            simd_sub(dst, matx1.vrows[i]->elements, matx2.vrows[i]->elements, matx1.col);
         }
     }
 
+    PROFILE_END(PROFILE_MATRIX_SUBSTRACT, (unsigned long long)matx1.row * matx1.col,
+                3ull * matx1.row * matx1.col * sizeof(float));
+
     return ret_matx;
 }
 
@@ -379,14 +892,30 @@ void __substract_matrix_ptr(matrix *matx1, matrix matx2)
         return;
     }
 
+    // Paylaşılan depolamaya yazılmadan önce özel kopya alınır
+    __unshare_matrix(matx1);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_SUBSTRACT);
+
+    bool aligned = (matx1->flags & matx2.flags & MATRIX_ALIGNED) != 0;
+
     for (MX i = 0; i < matx1->row; i++)
     {
-        for (MX c = 0; c < matx2.row; c++)
+        float *dst = matx1->vrows[i]->elements;
+
+        if (aligned)
         {
-            matx1->vrows[i]->elements[c] -= matx2.vrows[i]->elements[c];
+            simd_sub_a(dst, dst, matx2.vrows[i]->elements, matx1->col);
+        }
+        else
+        {
+            simd_sub(dst, dst, matx2.vrows[i]->elements, matx1->col);
         }
     }
 
+    PROFILE_END(PROFILE_MATRIX_SUBSTRACT, (unsigned long long)matx1->row * matx1->col,
+                3ull * matx1->row * matx1->col * sizeof(float));
+
     return;
 }
 
@@ -405,6 +934,8 @@ matrix __divide_matrix(matrix matx1, matrix matx2)
         return MATRIX_UNDEFINED;
     }
 
+    PROFILE_BEGIN(PROFILE_MATRIX_DIVIDE);
+
     matrix ret_matx = __allocate_row_vectors(matx1.row, matx2.col);
 
     for (MX i = 0; i < matx1.row; i++)
@@ -414,6 +945,8 @@ matrix __divide_matrix(matrix matx1, matrix matx2)
             if (matx2.vrows[i]->elements[c] == 0.0f)
             {
                 printf("\n\nSecond Matris has a value of 0 (zero)\n\n");
+                __free_matrix(&ret_matx);
+                PROFILE_END(PROFILE_MATRIX_DIVIDE, 0, 0);
                 return MATRIX_UNDEFINED;
             }
             else
@@ -424,13 +957,16 @@ matrix __divide_matrix(matrix matx1, matrix matx2)
         }
     }
 
+    PROFILE_END(PROFILE_MATRIX_DIVIDE, (unsigned long long)matx1.row * matx1.col,
+                3ull * matx1.row * matx1.col * sizeof(float));
+
     return ret_matx;
 }
 
 /**
  * @brief İki matrisin elementer bölümünü pointer yardımıyla hesaplayan fonskiyon
  *
- * @param matx1 Elementer bölümün sonucunu içerecek matrix
+ * @param matx1 Elementer bölümün sonucunu içerecek matrix; matx2'de 0 varsa değişmez
  * @param matx2 İkinci matrix elemanı
  * @return matrix
  */
@@ -442,23 +978,36 @@ void __divide_matrix_ptr(matrix *matx1, matrix matx2)
         return;
     }
 
-    for (MX i = 0; i < matx1->row; i++)
+    PROFILE_BEGIN(PROFILE_MATRIX_DIVIDE);
+
+    // Payda yazmadan önce denetlenir; 0 varsa matx1 hiç değişmez
+    for (MX i = 0; i < matx2.row; i++)
     {
-        for (MX c = 0; c < matx2.row; c++)
+        for (MX c = 0; c < matx2.col; c++)
         {
             if (matx2.vrows[i]->elements[c] == 0.0f)
             {
                 printf("\n\nSecond Matris has a value of 0 (zero)\n\n");
-                __free_matrix(matx1);
+                PROFILE_END(PROFILE_MATRIX_DIVIDE, 0, 0);
                 return;
             }
-            else
-            {
-                matx1->vrows[i]->elements[c] /= matx2.vrows[i]->elements[c];
-            }
         }
     }
 
+    // Paylaşılan depolamaya yazılmadan önce özel kopya alınır
+    __unshare_matrix(matx1);
+
+    for (MX i = 0; i < matx1->row; i++)
+    {
+        for (MX c = 0; c < matx2.col; c++)
+        {
+            matx1->vrows[i]->elements[c] /= matx2.vrows[i]->elements[c];
+        }
+    }
+
+    PROFILE_END(PROFILE_MATRIX_DIVIDE, (unsigned long long)matx1->row * matx1->col,
+                3ull * matx1->row * matx1->col * sizeof(float));
+
     return;
 }
 
@@ -471,17 +1020,27 @@ void __divide_matrix_ptr(matrix *matx1, matrix matx2)
  */
 matrix __scalar_multiplication(matrix matx1, float scalar)
 {
+    PROFILE_BEGIN(PROFILE_MATRIX_SCALAR);
 
     matrix ret_matrix = __allocate_row_vectors(matx1.row, matx1.col);
 
+    bool aligned = (matx1.flags & MATRIX_ALIGNED) != 0;
+
     for (MX i = 0; i < matx1.row; i++)
     {
-        for (MX c = 0; c < matx1.row; c++)
+        if (aligned)
         {
-            ret_matrix.vrows[i]->elements[c] = scalar * matx1.vrows[i]->elements[c];
+            simd_scale_a(ret_matrix.vrows[i]->elements, matx1.vrows[i]->elements, scalar, matx1.col);
+        }
+        else
+        {
+            simd_scale(ret_matrix.vrows[i]->elements, matx1.vrows[i]->elements, scalar, matx1.col);
         }
     }
 
+    PROFILE_END(PROFILE_MATRIX_SCALAR, (unsigned long long)matx1.row * matx1.col,
+                2ull * matx1.row * matx1.col * sizeof(float));
+
     return ret_matrix;
 }
 
@@ -493,15 +1052,30 @@ matrix __scalar_multiplication(matrix matx1, float scalar)
  */
 void __scalar_multiplication_ptr(matrix *matx1, float scalar)
 {
+    // Paylaşılan depolamaya yazılmadan önce özel kopya alınır
+    __unshare_matrix(matx1);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_SCALAR);
+
+    bool aligned = (matx1->flags & MATRIX_ALIGNED) != 0;
 
     for (MX i = 0; i < matx1->row; i++)
     {
-        for (MX c = 0; c < matx1->col; c++)
+        float *dst = matx1->vrows[i]->elements;
+
+        if (aligned)
+        {
+            simd_scale_a(dst, dst, scalar, matx1->col);
+        }
+        else
         {
-            matx1->vrows[i]->elements[c] *= scalar;
+            simd_scale(dst, dst, scalar, matx1->col);
         }
     }
 
+    PROFILE_END(PROFILE_MATRIX_SCALAR, (unsigned long long)matx1->row * matx1->col,
+                2ull * matx1->row * matx1->col * sizeof(float));
+
     return;
 }
 
@@ -520,6 +1094,8 @@ matrix __multiplication_matrix(matrix matx1, matrix matx2)
         return MATRIX_UNDEFINED;
     }
 
+    PROFILE_BEGIN(PROFILE_MATRIX_MULTIPLICATION);
+
     // Sonuç vektörünün boyutudur. -> (matx1.row, matx2.col)
     matrix ret_matrix = __allocate_row_vectors(matx1.row, matx2.col);
 
@@ -529,22 +1105,89 @@ matrix __multiplication_matrix(matrix matx1, matrix matx2)
     if (matx2.vrows == NULL)
     {
         printf("\n\n *Failed Transpose second Matrix \n\n");
+        __free_matrix(&ret_matrix);
+        PROFILE_END(PROFILE_MATRIX_MULTIPLICATION, 0, 0);
         return MATRIX_UNDEFINED;
     }
 
-    for (MX i = 0; i < ret_matrix.row; i++)
-    {
-        vec *r_ptr = (vec *)matx1.vrows[i];
+    // A'nın satırları ile B^T'nin satırlarının iç çarpımları; sonuç özyinelemeli
+    // olarak bloklara bölünür ve bloklar iş çalan zamanlayıcıya dağıtılır
+    __dot_rows_matrix(matx1, matx2, &ret_matrix);
+
+    // Geçici transpoze serbest bırakılır
+    __free_matrix(&matx2);
+
+    PROFILE_END(PROFILE_MATRIX_MULTIPLICATION, 2ull * matx1.row * matx1.col * ret_matrix.col,
+                ((unsigned long long)matx1.row * matx1.col + (unsigned long long)matx1.col * ret_matrix.col +
+                 (unsigned long long)ret_matrix.row * ret_matrix.col) * sizeof(float));
+
+    return ret_matrix;
+}
+
+/**
+ * @brief Transpozede kaynağın bir bloğu: src[r0:r1][c0:c1] -> dst[c0:c1][r0:r1]
+ */
+typedef struct
+{
+    const matrix *src;
+    matrix *dst;
+    MX r0, r1;
+    MX c0, c1;
+
+} transpose_range;
+
+/**
+ * @brief Yaprak blok kenarı; iki blok da L1 önbelleğe sığar.
+ * TRANSPOSE_TASK'tan küçük bloklar görev açmadan bölünür.
+ */
+#define TRANSPOSE_LEAF 32
+#define TRANSPOSE_TASK (128 * 128)
 
-        for (MX c = 0; c < ret_matrix.col; c++)
+/**
+ * @brief Önbellekten bağımsız transpoze: blok uzun kenarından ikiye
+ * bölünür, böylece her düzeyde okunan ve yazılan satırlar önbellekte kalır.
+ */
+static void transpose_recursive(void *arg)
+{
+    transpose_range *t = (transpose_range *)arg;
+    MX rows = t->r1 - t->r0, cols = t->c1 - t->c0;
+
+    if (rows <= TRANSPOSE_LEAF && cols <= TRANSPOSE_LEAF)
+    {
+        for (MX i = t->r0; i < t->r1; i++)
         {
-            vec *c_ptr = (vec *)matx2.vrows[c];
+            const float *src = t->src->vrows[i]->elements;
 
-            ret_matrix.vrows[i]->elements[c] = (float)dot_product_of_vector((vec)*r_ptr, (vec)*c_ptr);
+            for (MX c = t->c0; c < t->c1; c++)
+            {
+                t->dst->vrows[c]->elements[i] = src[c];
+            }
         }
+        return;
     }
 
-    return ret_matrix;
+    transpose_range first = *t, second = *t;
+
+    if (rows >= cols)
+    {
+        MX half = rows / 2 > 16 ? (rows / 2) & ~15u : rows / 2;
+        first.r1 = second.r0 = t->r0 + half;
+    }
+    else
+    {
+        MX half = cols / 2 > 16 ? (cols / 2) & ~15u : cols / 2;
+        first.c1 = second.c0 = t->c0 + half;
+    }
+
+    if ((unsigned long long)rows * cols >= TRANSPOSE_TASK)
+    {
+        parallel_join(transpose_recursive, &first, transpose_recursive, &second);
+    }
+    else
+    {
+        transpose_recursive(&first);
+        transpose_recursive(&second);
+    }
 }
 
 /**
@@ -555,22 +1198,51 @@ matrix __multiplication_matrix(matrix matx1, matrix matx2)
  */
 matrix __transpose_matrix(matrix matx)
 {
+    PROFILE_BEGIN(PROFILE_MATRIX_TRANSPOSE);
+
     matrix ret_matrix = __allocate_row_vectors(matx.col, matx.row);
 
-    for (MX i = 0; i < matx.row; i++)
+    transpose_range root = {&matx, &ret_matrix, 0, matx.row, 0, matx.col};
+    parallel_run(transpose_recursive, &root);
+
+    PROFILE_END(PROFILE_MATRIX_TRANSPOSE, 0, 2ull * matx.row * matx.col * sizeof(float));
+
+    return ret_matrix;
+}
+
+/**
+ * @brief Transpozeyi önceden ayrılmış bir matrixe yazar.
+ *
+ * @param matx
+ * @param out matx.col x matx.row boyutlu matrix
+ * @return bool
+ */
+bool __transpose_matrix_into(matrix matx, matrix *out)
+{
+    if (out->row != matx.col || out->col != matx.row)
     {
-        for (MX c = 0; c < matx.col; c++)
-        {
-            ret_matrix.vrows[c]->elements[i] = matx.vrows[i]->elements[c];
-        }
+        printf("\n\nDimention Error transpose function\n\n");
+        return false;
     }
 
-    return ret_matrix;
+    __unshare_matrix(out);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_TRANSPOSE);
+
+    transpose_range root = {&matx, out, 0, matx.row, 0, matx.col};
+    parallel_run(transpose_recursive, &root);
+
+    PROFILE_END(PROFILE_MATRIX_TRANSPOSE, 0, 2ull * matx.row * matx.col * sizeof(float));
+
+    return true;
 }
 
 /**
  * @brief Bir matrixin pozitif kuvvetini bulan fonksiyondur.
  *
+ * Üs soldan sağa ikili olarak işlenir: her bit için sonuç karesi alınır,
+ * bit 1 ise matx ile çarpılır. pow - 1 yerine en fazla 2 log2(pow) çarpım yapılır.
+ *
  * @param matx Kuvveti alınacak matrix
  * @param pow int olarak girilmelidir.
  * @return matrix Hesaplanan matrix sonucu.
@@ -582,17 +1254,630 @@ matrix __power_matrix(matrix matx, unsigned int pow)
         printf("Negative power error.");
         return MATRIX_UNDEFINED;
     }
-    else if (pow == 2)
+
+    if (matx.row != matx.col)
+    {
+        printf("\n\nDimention Error power function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_POWER);
+
+    unsigned int bit = 1u << 31;
+    unsigned long long products = 0;
+
+    while (!(pow & bit))
+    {
+        bit >>= 1;
+    }
+
+    matrix ret_matrix = __copy_matrix(matx);
+
+    for (bit >>= 1; bit != 0; bit >>= 1)
+    {
+        matrix next = __multiplication_matrix(ret_matrix, ret_matrix);
+
+        // Ara sonuç artık kullanılmıyor
+        __free_matrix(&ret_matrix);
+        ret_matrix = next;
+        products++;
+
+        if (pow & bit)
+        {
+            next = __multiplication_matrix(ret_matrix, matx);
+
+            __free_matrix(&ret_matrix);
+            ret_matrix = next;
+            products++;
+        }
+    }
+
+    PROFILE_END(PROFILE_MATRIX_POWER, 2ull * products * matx.row * matx.row * matx.col, 0);
+
+    return ret_matrix;
+}
+
+/**
+ * @brief Zincir çarpımının maliyet modeli katsayıları (çarpma-toplam birimi).
+ *
+ * CHAIN_MEMORY_COST : transpoze edilen veya sonuca yazılan eleman başına
+ * CHAIN_CALL_COST   : çarpım başına sabit maliyet (tampon hazırlama, görev açma)
+ */
+#define CHAIN_MEMORY_COST 2.0
+#define CHAIN_CALL_COST 4096.0
+
+/**
+ * @brief (p x q) . (q x r) çarpımının tahmini süresi.
+ *
+ * Çekirdek 4x4 satır döşemeleriyle çalıştığından p ve r 4'ün katına
+ * yuvarlanır. MULTIPLY_LEAF_WORK'ten büyük çarpımlar thread'lere bölünür.
+ */
+static double chain_cost(MX p, MX q, MX r, unsigned int threads)
+{
+    double work = 4.0 * ((p + 3ull) / 4) * 4.0 * ((r + 3ull) / 4) * q;
+    double tasks = work / MULTIPLY_LEAF_WORK;
+    double speedup = tasks < 1.0 ? 1.0 : (tasks < threads ? tasks : threads);
+
+    return work / speedup + CHAIN_MEMORY_COST * p * r + CHAIN_CALL_COST;
+}
+
+/**
+ * @brief Zincir çalışırken tekrar kullanılan ara sonuç tamponu.
+ */
+typedef struct
+{
+    matrix m;
+
+    /* Tahsis edilen eleman ve satır başlığı sayısı */
+    size_t data_cap;
+    MX row_cap;
+    vec *headers;
+
+    bool busy;
+
+} chain_buffer;
+
+typedef struct
+{
+    const matrix *list;
+    MX n;
+
+    /* split[i * n + j]: list[i..j] çarpımında sol parçanın son indeksi */
+    MX *split;
+
+    chain_buffer *pool;
+    MX pool_count;
+
+    unsigned long long flops;
+
+} chain_plan;
+
+/**
+ * @brief row x col boyutlu bir tampon verir. Yeterince büyük boş bir
+ * tampon varsa (en küçüğü) yeniden biçimlendirilir, yoksa yenisi tahsis edilir.
+ */
+static matrix chain_acquire(chain_plan *plan, MX row, MX col)
+{
+    MX ld = __leading_dimension(col);
+    size_t need = (size_t)row * ld;
+    chain_buffer *best = NULL;
+
+    for (MX i = 0; i < plan->pool_count; i++)
+    {
+        chain_buffer *b = &plan->pool[i];
+
+        if (!b->busy && b->data_cap >= need && b->row_cap >= row &&
+            (best == NULL || b->data_cap < best->data_cap))
+        {
+            best = b;
+        }
+    }
+
+    if (best == NULL)
+    {
+        best = &plan->pool[plan->pool_count++];
+        best->m = __allocate_row_vectors(row, col);
+        best->data_cap = need;
+        best->row_cap = row;
+        best->headers = (vec *)(best->m.vrows + row);
+    }
+    else
+    {
+        best->m.row = row;
+        best->m.col = col;
+        best->m.ld = ld;
+        best->m.flags = MATRIX_CONTIGUOUS | (ld % 16 == 0 ? MATRIX_ALIGNED : 0) | (ld > col ? MATRIX_PADDED : 0);
+
+        for (MX i = 0; i < row; i++)
+        {
+            best->headers[i].dim = col;
+            best->headers[i].elements = best->m.data + (size_t)i * ld;
+            best->headers[i].owner = NULL;
+            memset(best->headers[i].elements + col, 0, (ld - col) * sizeof(float));
+            best->m.vrows[i] = &best->headers[i];
+        }
+    }
+
+    best->busy = true;
+
+    return best->m;
+}
+
+/**
+ * @brief Tamponu havuza geri verir. Zincirin girdileri havuzda olmadığından etkilenmez.
+ */
+static void chain_release(chain_plan *plan, matrix m)
+{
+    for (MX i = 0; i < plan->pool_count; i++)
+    {
+        if (plan->pool[i].m.data == m.data)
+        {
+            plan->pool[i].busy = false;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief list[i..j] çarpımını hesaplar; transposed ise sonucun transpozesini döndürür.
+ *
+ * Sağ parça her zaman transpoze olarak istenir: (L.R)^T = R^T . L^T olduğundan
+ * ara sonucun transpozesi __dot_rows_matrix(R^T, L) ile doğrudan yazılır ve
+ * yalnızca sağda kalan girdiler transpoze edilir.
+ */
+static matrix chain_execute(chain_plan *plan, MX i, MX j, bool transposed)
+{
+    if (i == j)
+    {
+        if (!transposed)
+        {
+            return plan->list[i];
+        }
+
+        matrix t = chain_acquire(plan, plan->list[i].col, plan->list[i].row);
+        transpose_range root = {&plan->list[i], &t, 0, plan->list[i].row, 0, plan->list[i].col};
+        parallel_run(transpose_recursive, &root);
+
+        return t;
+    }
+
+    MX k = plan->split[(size_t)i * plan->n + j];
+
+    matrix left = chain_execute(plan, i, k, false);
+    matrix right_t = chain_execute(plan, k + 1, j, true);
+
+    matrix out;
+
+    plan->flops += 2ull * left.row * left.col * right_t.row;
+
+    if (transposed)
+    {
+        out = chain_acquire(plan, right_t.row, left.row);
+        __dot_rows_matrix(right_t, left, &out);
+    }
+    else
+    {
+        out = chain_acquire(plan, left.row, right_t.row);
+        __dot_rows_matrix(left, right_t, &out);
+    }
+
+    chain_release(plan, left);
+    chain_release(plan, right_t);
+
+    return out;
+}
+
+/**
+ * @brief Matrix zincirini en ucuz sırayla çarpar.
+ *
+ * @param list Çarpılacak matrixler
+ * @param n Matrix sayısı
+ * @return matrix
+ */
+matrix __multiply_chain(const matrix *list, MX n)
+{
+    if (n == 0 || list == NULL)
+    {
+        printf("\n\nMultiply chain requires at least one matrix\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    for (MX i = 0; i < n; i++)
+    {
+        if (list[i].vrows == NULL || (i + 1 < n && list[i].col != list[i + 1].row))
+        {
+            printf("\n\nDimention Error multiply chain function\n\n");
+            return MATRIX_UNDEFINED;
+        }
+    }
+
+    if (n == 1)
+    {
+        return __copy_matrix(list[0]);
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_CHAIN);
+
+    unsigned int threads = parallel_threads();
+
+    // cost[i * n + j]: list[i..j] çarpımının en düşük maliyeti
+    double *cost = (double *)MEMORY_ALLOC((size_t)n * n * sizeof(double));
+    MX *split = (MX *)MEMORY_ALLOC((size_t)n * n * sizeof(MX));
+
+    __allocation_err(cost, "Chain cost table");
+    __allocation_err(split, "Chain split table");
+
+    for (MX i = 0; i < n; i++)
+    {
+        cost[(size_t)i * n + i] = 0.0;
+    }
+
+    for (MX len = 2; len <= n; len++)
     {
-        return __multiplication_matrix(matx, matx);
+        for (MX i = 0; i + len <= n; i++)
+        {
+            MX j = i + len - 1;
+            double best = -1.0;
+
+            for (MX k = i; k < j; k++)
+            {
+                MX p = list[i].row, q = list[k].col, r = list[j].col;
+
+                double c = cost[(size_t)i * n + k] + cost[(size_t)(k + 1) * n + j] + chain_cost(p, q, r, threads);
+
+                // Sağ parça tek bir girdiyse transpozesi ayrıca alınır
+                if (k + 1 == j)
+                {
+                    c += CHAIN_MEMORY_COST * q * r;
+                }
+
+                if (best < 0.0 || c < best)
+                {
+                    best = c;
+                    split[(size_t)i * n + j] = k;
+                }
+            }
+
+            cost[(size_t)i * n + j] = best;
+        }
     }
 
-    matrix ret_matrix = __multiplication_matrix(matx, matx);
+    // n - 1 ara sonuç ve en fazla n - 1 transpoze tamponu
+    chain_plan plan = {list, n, split, NULL, 0, 0};
+    plan.pool = (chain_buffer *)MEMORY_ALLOC(2 * (size_t)n * sizeof(chain_buffer));
+
+    __allocation_err(plan.pool, "Chain buffer pool");
 
-    for (MX i = 0; i < pow - 2; i++)
+    matrix ret_matrix = chain_execute(&plan, 0, n - 1, false);
+
+    // Sonuç tamponu çağırana verilir, diğerleri serbest bırakılır
+    for (MX i = 0; i < plan.pool_count; i++)
     {
-        ret_matrix = __multiplication_matrix(ret_matrix, matx);
+        if (plan.pool[i].m.data != ret_matrix.data)
+        {
+            __free_matrix(&plan.pool[i].m);
+        }
     }
 
+    memory_free(plan.pool);
+    memory_free(split);
+    memory_free(cost);
+
+    PROFILE_END(PROFILE_MATRIX_CHAIN, plan.flops, 0);
+
     return ret_matrix;
-}
\ No newline at end of file
+}
+
+
+/**
+ * @brief Gram çekirdeğinde birlikte işlenen A satırlarının (panel) bayt
+ * hedefi; panel L2 önbellekte kalır.
+ */
+#define GRAM_PANEL_BYTES (256 * 1024)
+
+/**
+ * @brief Thread başına ayrı birikeçlerin toplamı bu kadar floatı geçerse
+ * satır panelleri yerine sonuç sütun blokları thread'lere dağıtılır.
+ */
+#define GRAM_PRIVATE_LIMIT (1u << 24)
+
+/**
+ * @brief Bir görevin aldığı sonuç satır bloğu.
+ */
+#define GRAM_TILE 64
+
+/**
+ * @brief Çekirdeğin bir adımda güncellediği sütun sayısı (4 x GRAM_NR birikeç).
+ */
+#define GRAM_NR (2 * SIMD_WIDTH)
+
+/**
+ * @brief C[i][j] += sum_{r0 <= r < r1} A[r][i] A[r][j], i_begin <= i < i_end, j <= i.
+ *
+ * 4 sonuç satırı ve GRAM_NR sütun yazmaçlarda tutulurken panelin satırları
+ * gezilir; her A satırından 4 skaler ve GRAM_NR ardışık eleman okunur.
+ * Köşegen 4'lüsünde üst üçgene düşen birkaç eleman da yazılır; bunlar
+ * gram_finish tarafından düzeltilir.
+ */
+static void gram_panel(matrix A, MX r0, MX r1, MX i_begin, MX i_end, float *C, size_t ldc)
+{
+    for (MX i = i_begin; i < i_end; i += 4)
+    {
+        MX mi = i_end - i < 4 ? i_end - i : 4;
+        MX ci[4];
+        MX j_end = i + mi;
+
+        for (MX k = 0; k < 4; k++)
+        {
+            ci[k] = i + (k < mi ? k : 0);
+        }
+
+        for (MX j = 0; j < j_end; j += GRAM_NR)
+        {
+            MX w = j_end - j < GRAM_NR ? j_end - j : GRAM_NR;
+
+#if SIMD_WIDTH > 1
+            if (w == GRAM_NR)
+            {
+                simd_f c00 = simd_zero(), c01 = simd_zero(), c10 = simd_zero(), c11 = simd_zero();
+                simd_f c20 = simd_zero(), c21 = simd_zero(), c30 = simd_zero(), c31 = simd_zero();
+
+                for (MX r = r0; r < r1; r++)
+                {
+                    const float *a = A.vrows[r]->elements;
+                    simd_f b0 = simd_loadu(a + j), b1 = simd_loadu(a + j + SIMD_WIDTH);
+                    simd_f x0 = simd_set1(a[ci[0]]), x1 = simd_set1(a[ci[1]]);
+                    simd_f x2 = simd_set1(a[ci[2]]), x3 = simd_set1(a[ci[3]]);
+
+                    c00 = simd_fmaddv(x0, b0, c00);
+                    c01 = simd_fmaddv(x0, b1, c01);
+                    c10 = simd_fmaddv(x1, b0, c10);
+                    c11 = simd_fmaddv(x1, b1, c11);
+                    c20 = simd_fmaddv(x2, b0, c20);
+                    c21 = simd_fmaddv(x2, b1, c21);
+                    c30 = simd_fmaddv(x3, b0, c30);
+                    c31 = simd_fmaddv(x3, b1, c31);
+                }
+
+                simd_f acc[4][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+
+                for (MX k = 0; k < mi; k++)
+                {
+                    float *c = C + (size_t)(i + k) * ldc + j;
+
+                    simd_storeu(c, simd_addv(simd_loadu(c), acc[k][0]));
+                    simd_storeu(c + SIMD_WIDTH, simd_addv(simd_loadu(c + SIMD_WIDTH), acc[k][1]));
+                }
+                continue;
+            }
+#endif
+
+            float acc[4][GRAM_NR];
+
+            memset(acc, 0, sizeof(acc));
+
+            for (MX r = r0; r < r1; r++)
+            {
+                const float *a = A.vrows[r]->elements;
+
+                for (MX k = 0; k < 4; k++)
+                {
+                    float x = a[ci[k]];
+
+                    for (MX s = 0; s < w; s++)
+                    {
+                        acc[k][s] += x * a[j + s];
+                    }
+                }
+            }
+
+            for (MX k = 0; k < mi; k++)
+            {
+                float *c = C + (size_t)(i + k) * ldc + j;
+
+                for (MX s = 0; s < w; s++)
+                {
+                    c[s] += acc[k][s];
+                }
+            }
+        }
+    }
+}
+
+typedef struct
+{
+    matrix A;
+    float *C;
+    size_t ldc;
+
+    /* Thread başına n x ldc birikeç; NULL ise doğrudan C'ye yazılır */
+    float *priv;
+    MX panel;
+
+} gram_ctx;
+
+/**
+ * @brief A^T A, satır panelleri [begin, end) üzerinden; her thread kendi birikecine yazar.
+ */
+static void gram_panels(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    gram_ctx *g = (gram_ctx *)arg;
+    float *C = g->priv != NULL ? g->priv + (size_t)worker * g->A.col * g->ldc : g->C;
+
+    for (unsigned long p = begin; p < end; p++)
+    {
+        MX r0 = (MX)p * g->panel;
+        MX r1 = g->A.row - r0 < g->panel ? g->A.row : r0 + g->panel;
+
+        gram_panel(g->A, r0, r1, 0, g->A.col, C, g->ldc);
+    }
+}
+
+/**
+ * @brief A^T A, sonuç satır blokları [begin, end) üzerinden; her blok tüm A'yı okur.
+ */
+static void gram_columns(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    gram_ctx *g = (gram_ctx *)arg;
+    (void)worker;
+
+    for (unsigned long blk = begin; blk < end; blk++)
+    {
+        MX i0 = (MX)blk * GRAM_TILE;
+        MX i1 = g->A.col - i0 < GRAM_TILE ? g->A.col : i0 + GRAM_TILE;
+
+        for (MX r0 = 0; r0 < g->A.row; r0 += g->panel)
+        {
+            gram_panel(g->A, r0, g->A.row - r0 < g->panel ? g->A.row : r0 + g->panel, i0, i1, g->C, g->ldc);
+        }
+    }
+}
+
+/**
+ * @brief Thread birikeçlerinin alt üçgenlerini C'ye toplar.
+ */
+static void gram_reduce(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    gram_ctx *g = (gram_ctx *)arg;
+    unsigned int threads = parallel_threads();
+    (void)worker;
+
+    for (MX i = (MX)begin; i < (MX)end; i++)
+    {
+        float *c = g->C + (size_t)i * g->ldc;
+
+        for (unsigned int w = 0; w < threads; w++)
+        {
+            simd_add(c, c, g->priv + ((size_t)w * g->A.col + i) * g->ldc, i + 1);
+        }
+    }
+}
+
+/**
+ * @brief A A^T, sonuç satır blokları [begin, end): blok I, A'nın 0..I satırlarıyla çarpılır.
+ */
+static void gram_rows(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    gram_ctx *g = (gram_ctx *)arg;
+    (void)worker;
+
+    for (unsigned long blk = begin; blk < end; blk++)
+    {
+        MX i0 = (MX)blk * GRAM_TILE;
+        MX i1 = g->A.row - i0 < GRAM_TILE ? g->A.row : i0 + GRAM_TILE;
+
+        __dot_rows_block(g->A, i0, i1, g->A, 0, i1, g->C + (size_t)i0 * g->ldc, g->ldc);
+    }
+}
+
+/**
+ * @brief Üst üçgeni alt üçgenin aynası veya sıfır yapar; 32'lik bloklarla
+ * gezilir, böylece sütun okumaları önbellekte kalır.
+ */
+static void gram_finish(float *C, size_t ldc, MX n, bool mirror)
+{
+    for (MX ib = 0; ib < n; ib += 32)
+    {
+        for (MX jb = ib; jb < n; jb += 32)
+        {
+            MX i_end = n - ib < 32 ? n : ib + 32;
+            MX j_end = n - jb < 32 ? n : jb + 32;
+
+            for (MX i = ib; i < i_end; i++)
+            {
+                for (MX j = jb > i + 1 ? jb : i + 1; j < j_end; j++)
+                {
+                    C[(size_t)i * ldc + j] = mirror ? C[(size_t)j * ldc + i] : 0.0f;
+                }
+            }
+        }
+    }
+}
+
+matrix __gram_matrix(matrix A, bool mirror)
+{
+    if (A.vrows == NULL && A.row > 0)
+    {
+        printf("\n\nDimention Error gram matrix function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_GRAM);
+
+    const MX n = A.col;
+    matrix ret_matrix = __zero_matrix(n, n);
+    gram_ctx ctx = {A, NULL, 0, NULL, 0};
+    MX ld = 0;
+
+    ctx.C = __matrix_buffer(ret_matrix, &ld);
+    ctx.ldc = ld;
+    ctx.panel = GRAM_PANEL_BYTES / ((size_t)(n > 0 ? n : 1) * sizeof(float));
+    ctx.panel = ctx.panel < 16 ? 16 : ctx.panel;
+
+    unsigned int threads = parallel_threads();
+    unsigned long panels = (A.row + ctx.panel - 1) / ctx.panel;
+
+    if (n > 0 && A.row > 0)
+    {
+        if (threads == 1)
+        {
+            gram_panels(&ctx, 0, panels, 0);
+        }
+        else if ((size_t)threads * n * ctx.ldc <= GRAM_PRIVATE_LIMIT && panels >= threads)
+        {
+            // Uzun ince A: A bir kez okunur, birikeçler sonra toplanır
+            ctx.priv = (float *)MEMORY_ALLOC_ALIGNED((size_t)threads * n * ctx.ldc * sizeof(float));
+
+            __allocation_err(ctx.priv, "Gram accumulators");
+
+            memset(ctx.priv, 0, (size_t)threads * n * ctx.ldc * sizeof(float));
+
+            parallel_for(0, panels, 1, gram_panels, &ctx);
+            parallel_for(0, n, 64, gram_reduce, &ctx);
+
+            memory_free_aligned(ctx.priv);
+        }
+        else
+        {
+            parallel_for(0, (n + GRAM_TILE - 1) / GRAM_TILE, 1, gram_columns, &ctx);
+        }
+    }
+
+    gram_finish(ctx.C, ctx.ldc, n, mirror);
+
+    PROFILE_END(PROFILE_MATRIX_GRAM, (unsigned long long)A.row * n * (n + 1),
+                ((unsigned long long)A.row * n + (unsigned long long)n * n) * sizeof(float));
+
+    return ret_matrix;
+}
+
+matrix __gram_matrix_rows(matrix A, bool mirror)
+{
+    if (A.vrows == NULL && A.row > 0)
+    {
+        printf("\n\nDimention Error gram matrix function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_GRAM);
+
+    const MX m = A.row;
+    matrix ret_matrix = __zero_matrix(m, m);
+    gram_ctx ctx = {A, NULL, 0, NULL, 0};
+    MX ld = 0;
+
+    ctx.C = __matrix_buffer(ret_matrix, &ld);
+    ctx.ldc = ld;
+
+    if (m > 0 && A.col > 0)
+    {
+        parallel_for(0, (m + GRAM_TILE - 1) / GRAM_TILE, 1, gram_rows, &ctx);
+    }
+
+    gram_finish(ctx.C, ctx.ldc, m, mirror);
+
+    PROFILE_END(PROFILE_MATRIX_GRAM, (unsigned long long)m * (m + 1) * A.col,
+                ((unsigned long long)m * A.col + (unsigned long long)m * m) * sizeof(float));
+
+    return ret_matrix;
+}
@@ -3,12 +3,19 @@
 
 #include "../CMATH/vec.h"
 #include "../CMATH/cmath.h"
+#include "../CMATH/matrix.h"
 
 typedef unsigned int MX;
 
 #ifndef VMATRIX_H
 #define VMATRIX_H
 
+/**
+ * @brief Paylaşılan matrix depolamasının referans sayacı (vmatrix.c içinde tanımlı).
+ *
+ */
+typedef struct matrix_share matrix_share;
+
 /**
  * @brief Bu Struct tanımı matrixin genel tanımıdır.
  *
@@ -22,8 +29,37 @@ typedef struct
     /* Vektörler ile beraber */
     vec **vrows;
 
+    /* __share_matrix ile paylaşıldıysa referans sayacı, aksi halde NULL */
+    matrix_share *share;
+
+    /* Satırların bulunduğu tek parça tampon ve satırlar arası adım (float cinsinden) */
+    float *data;
+    unsigned int ld;
+
+    /* MATRIX_CONTIGUOUS, MATRIX_ALIGNED, MATRIX_PADDED */
+    unsigned int flags;
+
 } matrix;
 
+/**
+ * @brief Matrix depolama bayrakları.
+ *
+ * MATRIX_CONTIGUOUS : satır i, data + i * ld adresindedir.
+ * MATRIX_ALIGNED    : her satırın başlangıcı MEMORY_ALIGNMENT (64) bayta hizalıdır,
+ *                     hizalı SIMD yüklemeleri güvenlidir.
+ * MATRIX_PADDED     : ld > col; satır sonundaki dolgu sıfırlanmıştır ve okunabilir,
+ *                     fonksiyonlar dolguya yazmaz.
+ * MATRIX_BORROWED   : elemanlar başka bir yapıya aittir (__matrix_from_* görünümleri);
+ *                     __free_matrix yalnızca satır başlıklarını bırakır.
+ * MATRIX_ZERO_BLOCK : yalnızca şekil, vrows NULL; __block_matrix sıfır blok
+ *                     olarak kullanır (bkz. __zero_block).
+ */
+#define MATRIX_CONTIGUOUS 0x1u
+#define MATRIX_ALIGNED 0x2u
+#define MATRIX_PADDED 0x4u
+#define MATRIX_BORROWED 0x8u
+#define MATRIX_ZERO_BLOCK 0x10u
+
 /**
  * @brief Tanımsız ifade oluşturabilecek durumlarda geri dönüş değeridir.
  *
@@ -41,19 +77,141 @@ void __allocation_err(void *ptr, const char *msg);
 /**
  * @brief Vektör pointerını işaret eden pointerın işaret ettiği vektör.
  *
+ * Doğrudan değil __allocate_vector_mem makrosu ile çağrılır.
+ *
  * @param size
+ * @param func, file, line Bellek takibinde görünecek tahsis yeri
  * @return vec*
  */
-vec *__allocate_vector_mem(MX size);
+vec *__allocate_vector_mem_at(MX size, const char *func, const char *file, int line);
+
+#define __allocate_vector_mem(size) __allocate_vector_mem_at((size), __func__, __FILE__, __LINE__)
 
 /**
  * @brief Matrix'i vektörler ile ifade etmek.
  *
+ * Doğrudan değil __allocate_row_vectors makrosu ile çağrılır.
+ *
+ * @param row
+ * @param col
+ * @param func, file, line Bellek takibinde görünecek tahsis yeri
+ * @return matrix
+ */
+matrix __allocate_row_vectors_at(MX row, MX col, const char *func, const char *file, int line);
+
+#define __allocate_row_vectors(row, col) __allocate_row_vectors_at((row), (col), __func__, __FILE__, __LINE__)
+
+/**
+ * @brief col sütunlu bir matrix için otomatik seçilen satır adımı.
+ *
+ * 16 float'ın (64 bayt) katına yuvarlanır. Adım 1 KB'ın katı olduğunda
+ * (1024/2048/4096 sütun gibi) sütun yönlü gezinmelerde aynı önbellek
+ * kümesine düşmemek için bir önbellek satırı kadar dolgu eklenir.
+ *
+ * @param col
+ * @return MX
+ */
+MX __leading_dimension(MX col);
+
+/**
+ * @brief Satır adımı verilerek matrix tahsis eder.
+ *
+ * Doğrudan değil __allocate_matrix_ld makrosu ile çağrılır.
+ *
+ * @param row
+ * @param col
+ * @param ld Satır adımı; 0 ise __leading_dimension(col) kullanılır, aksi halde ld >= col olmalıdır
+ * @param func, file, line Bellek takibinde görünecek tahsis yeri
+ * @return matrix
+ */
+matrix __allocate_matrix_ld_at(MX row, MX col, MX ld, const char *func, const char *file, int line);
+
+#define __allocate_matrix_ld(row, col, ld) __allocate_matrix_ld_at((row), (col), (ld), __func__, __FILE__, __LINE__)
+
+/**
+ * @brief CMATH/matrix.h'deki fmatrix'i kopyalamadan matrix olarak kullanır.
+ *
+ * Satırlar fmatrix'te kalır; matrix üzerinde yapılan yerinde işlemler
+ * fmatrix'e yansır. Satırlar tek parça ise (allocate_matrix_mem) matrix
+ * MATRIX_CONTIGUOUS olarak işaretlenir. Görünüm __free_matrix ile, fmatrix'ten
+ * önce bırakılmalıdır.
+ *
+ * @param matx
+ * @return matrix
+ */
+matrix __matrix_from_fmatrix(fmatrix matx);
+
+/**
+ * @brief matrix satırlarını gösteren bir fmatrix döndürür; yalnızca satır
+ * pointer dizisi ayrılır ve free_matrix ile bırakılır.
+ *
+ * @param matx
+ * @return fmatrix
+ */
+fmatrix __fmatrix_from_matrix(matrix matx);
+
+/**
+ * @brief Satır satır yerleşmiş bir float dizisini kopyalamadan matrix olarak kullanır.
+ *
+ * Satır i, data + i * ld adresindedir. Dizi görünüm bırakılana kadar
+ * geçerli kalmalıdır; __free_matrix diziyi serbest bırakmaz.
+ *
+ * @param data
+ * @param row
+ * @param col
+ * @param ld Satır adımı (float); 0 ise col
+ * @return matrix ld < col ise MATRIX_UNDEFINED
+ */
+matrix __matrix_from_buffer(float *data, MX row, MX col, MX ld);
+
+/**
+ * @brief __matrix_from_buffer gibi kopyalamadan kullanır; ek olarak son tutamaç
+ * __free_matrix ile bırakıldığında release(data, ctx) çağrılır. Böylece
+ * tamponun sahipliği matrixe devredilebilir (ör. release = free).
+ *
+ * Yerinde işlemler tampona yazar; __share_matrix ile alınan kopyalardan
+ * biri değiştirilirse o tutamaç kendi kopyasına geçer.
+ *
+ * @param data
+ * @param row
+ * @param col
+ * @param ld Satır adımı (float); 0 ise col
+ * @param release NULL olabilir
+ * @param ctx
+ * @return matrix
+ */
+matrix __adopt_matrix(float *data, MX row, MX col, MX ld, buffer_release_fn release, void *ctx);
+
+/**
+ * @brief Satır satır yerleşmiş float dizisini yeni bir matrixe kopyalar.
+ * __create_matrix'in aksine eleman başına çağrı yoktur; satırlar memcpy ile kopyalanır.
+ *
+ * @param data
  * @param row
  * @param col
+ * @param ld Satır adımı (float); 0 ise col
  * @return matrix
  */
-matrix __allocate_row_vectors(MX row, MX col);
+matrix __matrix_from_array(const float *data, MX row, MX col, MX ld);
+
+/**
+ * @brief Var olan matrixi float dizisinden doldurur.
+ *
+ * @param matx
+ * @param data
+ * @param ld Satır adımı (float); 0 ise matx->col
+ * @return bool ld < col ise false
+ */
+bool __fill_matrix(matrix *matx, const float *data, MX ld);
+
+/**
+ * @brief Matrix tek parça tutuluyorsa elemanların başlangıcını ve satır adımını verir.
+ *
+ * @param matx
+ * @param ld Satır adımı (float)
+ * @return float* Satırlar tek parça değilse NULL
+ */
+float *__matrix_buffer(matrix matx, MX *ld);
 
 /**
  * @brief Matrix konsolda yazdırmak için kullanılan fonksiyon.
@@ -65,6 +223,9 @@ void __print_matrix(matrix matx);
 /**
  * @brief Oluşturulan matrixin bellekten serbest bırakan fonksiyon
  *
+ * flags 0 olan matrixlerin (vrows elle kurulmuş, her satır
+ * __allocate_vector_mem ile ayrılmış) satırları tek tek bırakılır.
+ *
  * @param matx matrixi işaret eden pointerdir.
  */
 void __free_matrix(matrix *matx);
@@ -113,6 +274,29 @@ matrix __copy_matrix(matrix matx);
  */
 matrix *__copy_matrix_ptr(matrix matx);
 
+/**
+ * @brief Kopyalamadan, aynı depolamayı paylaşan yeni bir tutamaç döndürür.
+ *
+ * Paylaşılan depolama, _ptr ile biten yerinde değiştiren fonksiyonlardan
+ * biri ilk kez yazdığında o tutamaç için kopyalanır (copy-on-write).
+ * Sayaç atomiktir; tutamaçlar farklı thread'lere verilebilir. Ancak bir
+ * matrix ilk kez paylaşılırken kaynak tutamaç tek bir thread'de olmalıdır.
+ * Her tutamaç __free_matrix ile ayrı ayrı bırakılır.
+ *
+ * Elemanlara vrows üzerinden doğrudan yazmadan önce __unshare_matrix çağrılmalıdır.
+ *
+ * @param matx Paylaşılacak matrix (ilk paylaşımda sayaç buna eklenir)
+ * @return matrix
+ */
+matrix __share_matrix(matrix *matx);
+
+/**
+ * @brief Depolama başka tutamaçlarla paylaşılıyorsa matrixe özel bir kopya çıkarır.
+ *
+ * @param matx
+ */
+void __unshare_matrix(matrix *matx);
+
 /**
  * @brief İki adet Matrix'in toplamını hesaplayan fonksiyon
  *
@@ -159,7 +343,8 @@ matrix __divide_matrix(matrix matx1, matrix matx2);
 /**
  * @brief İki matrisin elementer bölümünü pointer yardımıyla hesaplayan fonskiyon
  *
- * @param matx1 Elementer bölümün sonucunu içerecek matrix
+ * @param matx1 Elementer bölümün sonucunu içerecek matrix; matx2'de 0 varsa
+ * hata yazdırılır ve matx1 değiştirilmez
  * @param matx2 İkinci matrix elemanı
  * @return matrix
  */
@@ -199,6 +384,15 @@ matrix __multiplication_matrix(matrix matx1, matrix matx2);
  */
 matrix __transpose_matrix(matrix matx);
 
+/**
+ * @brief Transpozeyi önceden ayrılmış out matrixine yazar.
+ *
+ * @param matx
+ * @param out matx.col x matx.row boyutlu matrix
+ * @return bool Boyutlar uymuyorsa false
+ */
+bool __transpose_matrix_into(matrix matx, matrix *out);
+
 /**
  * @brief Bir matrixin pozitif kuvvetini bulan fonksiyondur.
  *
@@ -208,4 +402,41 @@ matrix __transpose_matrix(matrix matx);
  */
 matrix __power_matrix(matrix matx, unsigned int pow);
 
+/**
+ * @brief list[0] . list[1] . ... . list[n - 1] çarpımını hesaplar.
+ *
+ * Çarpım sırası boyutlara göre dinamik programlama ile seçilir. Maliyet
+ * modeli çarpma-toplam sayısının yanında çekirdeğin 4x4 döşemelerini,
+ * transpoze ve yazma trafiğini ve büyük çarpımların paralel çalışmasını
+ * hesaba katar. Ara sonuçlar tekrar kullanılan tamponlarda tutulur.
+ *
+ * @param list
+ * @param n
+ * @return matrix Boyutlar uymuyorsa MATRIX_UNDEFINED
+ */
+matrix __multiply_chain(const matrix *list, MX n);
+
+/**
+ * @brief A^T A (n x n, n = A.col); transpoze oluşturulmaz, A yerinde okunur.
+ *
+ * Simetri nedeniyle yalnızca alt üçgen (i >= j) hesaplanır; yani çarpmaların
+ * yarısı yapılır. A'nın satır panelleri thread'lere dağıtılır ve her thread
+ * kendi birikecine yazar (sütun sayısı büyükse sonuç blokları dağıtılır).
+ *
+ * @param A
+ * @param mirror true ise üst üçgen alt üçgenden kopyalanır, false ise sıfırdır
+ * (sonuç __pack_matrix(C, PACKED_SYMMETRIC, 0, 0) ile doğrudan sıkıştırılabilir)
+ * @return matrix
+ */
+matrix __gram_matrix(matrix A, bool mirror);
+
+/**
+ * @brief A A^T (m x m, m = A.row); satır i yalnızca 0..i satırlarıyla çarpılır.
+ *
+ * @param A
+ * @param mirror
+ * @return matrix
+ */
+matrix __gram_matrix_rows(matrix A, bool mirror);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,606 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//
+//      VMODULAR.C
+//  mod üzerinden tamsayı matrixler,
+//  Barrett indirgemeli çarpım ve üs alma
+//
+#include "vmodular.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief ld'nin yuvarlandığı eleman sayısı (MOD_TILE'ın katı); çekirdeklerde kuyruk döngüsü olmaz.
+ */
+#define MOD_ALIGN 16
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği çarpma-toplam sayısı.
+ */
+#define MOD_CHUNK 65536
+
+/**
+ * @brief 32 bitlik yol için en büyük mod; elemanlar _mm*_mul_epu32 girdisine sığar.
+ */
+#define MOD_NARROW_LIMIT (1ull << 32)
+
+/**
+ * @brief 128 bitlik birikecin taşmadığı sınır (bkz. mod_dot_wide).
+ */
+#define MOD_LIMIT (1ull << 63)
+
+typedef unsigned __int128 mod_u128;
+
+const mmatrix MMATRIX_UNDEFINED = {0, 0, 0, 0, NULL};
+
+/**
+ * @brief x mod m, r = floor((2^64 - 1) / m) ile (Barrett); bölme yapılmaz.
+ */
+static inline uint64_t mod_barrett(uint64_t x, uint64_t m, uint64_t r)
+{
+    uint64_t q = (uint64_t)(((mod_u128)x * r) >> 64);
+
+    x -= q * m;
+    x = x >= m ? x - m : x;
+
+    return x >= m ? x - m : x;
+}
+
+/*
+ * 4 satır x MOD_TILE sütunluk blok: out[r][t] = sum_k a[r][k] b[k][t] (mod m'e denk).
+ * Birikeçler yazmaçlarda kalır. Her delay çarpımda bir katlanır:
+ * x = h 2^32 + l için x = h fold + l (mod m), fold = 2^32 mod m; bu, x'i
+ * (2^32 - 1)(fold + 1)'in altına indirir ve delay yeni çarpıma yer açar.
+ * B'nin her satırı dört A satırı için bir kez yüklenir (a, b < 2^32).
+ */
+#if defined(__AVX512F__)
+
+#define MOD_TILE 16
+
+static inline __m512i mod_fold512(__m512i x, __m512i fold, __m512i low)
+{
+    return _mm512_add_epi64(_mm512_mul_epu32(_mm512_srli_epi64(x, 32), fold), _mm512_and_si512(x, low));
+}
+
+static void mod_tile(const uint64_t *const a[4], const uint64_t *b, MX ldb, MX n, MX delay, uint64_t fold, uint64_t *out)
+{
+    const __m512i vf = _mm512_set1_epi64((long long)fold);
+    const __m512i low = _mm512_set1_epi64(0xffffffffll);
+    __m512i c00 = _mm512_setzero_si512(), c01 = c00, c10 = c00, c11 = c00;
+    __m512i c20 = c00, c21 = c00, c30 = c00, c31 = c00;
+
+    for (MX k0 = 0; k0 < n; k0 += delay)
+    {
+        MX k1 = n - k0 < delay ? n : k0 + delay;
+
+        for (MX k = k0; k < k1; k++)
+        {
+            const uint64_t *bk = b + (size_t)k * ldb;
+            const __m512i b0 = _mm512_load_si512((const void *)bk);
+            const __m512i b1 = _mm512_load_si512((const void *)(bk + 8));
+            __m512i v;
+
+            v = _mm512_set1_epi64((long long)a[0][k]);
+            c00 = _mm512_add_epi64(c00, _mm512_mul_epu32(v, b0));
+            c01 = _mm512_add_epi64(c01, _mm512_mul_epu32(v, b1));
+
+            v = _mm512_set1_epi64((long long)a[1][k]);
+            c10 = _mm512_add_epi64(c10, _mm512_mul_epu32(v, b0));
+            c11 = _mm512_add_epi64(c11, _mm512_mul_epu32(v, b1));
+
+            v = _mm512_set1_epi64((long long)a[2][k]);
+            c20 = _mm512_add_epi64(c20, _mm512_mul_epu32(v, b0));
+            c21 = _mm512_add_epi64(c21, _mm512_mul_epu32(v, b1));
+
+            v = _mm512_set1_epi64((long long)a[3][k]);
+            c30 = _mm512_add_epi64(c30, _mm512_mul_epu32(v, b0));
+            c31 = _mm512_add_epi64(c31, _mm512_mul_epu32(v, b1));
+        }
+
+        if (k1 < n)
+        {
+            c00 = mod_fold512(c00, vf, low);
+            c01 = mod_fold512(c01, vf, low);
+            c10 = mod_fold512(c10, vf, low);
+            c11 = mod_fold512(c11, vf, low);
+            c20 = mod_fold512(c20, vf, low);
+            c21 = mod_fold512(c21, vf, low);
+            c30 = mod_fold512(c30, vf, low);
+            c31 = mod_fold512(c31, vf, low);
+        }
+    }
+
+    _mm512_storeu_si512((void *)(out + 0), c00);
+    _mm512_storeu_si512((void *)(out + 8), c01);
+    _mm512_storeu_si512((void *)(out + 16), c10);
+    _mm512_storeu_si512((void *)(out + 24), c11);
+    _mm512_storeu_si512((void *)(out + 32), c20);
+    _mm512_storeu_si512((void *)(out + 40), c21);
+    _mm512_storeu_si512((void *)(out + 48), c30);
+    _mm512_storeu_si512((void *)(out + 56), c31);
+}
+
+#elif defined(__AVX2__)
+
+#define MOD_TILE 8
+
+static inline __m256i mod_fold256(__m256i x, __m256i fold, __m256i low)
+{
+    return _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), fold), _mm256_and_si256(x, low));
+}
+
+static void mod_tile(const uint64_t *const a[4], const uint64_t *b, MX ldb, MX n, MX delay, uint64_t fold, uint64_t *out)
+{
+    const __m256i vf = _mm256_set1_epi64x((long long)fold);
+    const __m256i low = _mm256_set1_epi64x(0xffffffffll);
+    __m256i c00 = _mm256_setzero_si256(), c01 = c00, c10 = c00, c11 = c00;
+    __m256i c20 = c00, c21 = c00, c30 = c00, c31 = c00;
+
+    for (MX k0 = 0; k0 < n; k0 += delay)
+    {
+        MX k1 = n - k0 < delay ? n : k0 + delay;
+
+        for (MX k = k0; k < k1; k++)
+        {
+            const uint64_t *bk = b + (size_t)k * ldb;
+            const __m256i b0 = _mm256_load_si256((const __m256i *)bk);
+            const __m256i b1 = _mm256_load_si256((const __m256i *)(bk + 4));
+            __m256i v;
+
+            v = _mm256_set1_epi64x((long long)a[0][k]);
+            c00 = _mm256_add_epi64(c00, _mm256_mul_epu32(v, b0));
+            c01 = _mm256_add_epi64(c01, _mm256_mul_epu32(v, b1));
+
+            v = _mm256_set1_epi64x((long long)a[1][k]);
+            c10 = _mm256_add_epi64(c10, _mm256_mul_epu32(v, b0));
+            c11 = _mm256_add_epi64(c11, _mm256_mul_epu32(v, b1));
+
+            v = _mm256_set1_epi64x((long long)a[2][k]);
+            c20 = _mm256_add_epi64(c20, _mm256_mul_epu32(v, b0));
+            c21 = _mm256_add_epi64(c21, _mm256_mul_epu32(v, b1));
+
+            v = _mm256_set1_epi64x((long long)a[3][k]);
+            c30 = _mm256_add_epi64(c30, _mm256_mul_epu32(v, b0));
+            c31 = _mm256_add_epi64(c31, _mm256_mul_epu32(v, b1));
+        }
+
+        if (k1 < n)
+        {
+            c00 = mod_fold256(c00, vf, low);
+            c01 = mod_fold256(c01, vf, low);
+            c10 = mod_fold256(c10, vf, low);
+            c11 = mod_fold256(c11, vf, low);
+            c20 = mod_fold256(c20, vf, low);
+            c21 = mod_fold256(c21, vf, low);
+            c30 = mod_fold256(c30, vf, low);
+            c31 = mod_fold256(c31, vf, low);
+        }
+    }
+
+    _mm256_storeu_si256((__m256i *)(out + 0), c00);
+    _mm256_storeu_si256((__m256i *)(out + 4), c01);
+    _mm256_storeu_si256((__m256i *)(out + 8), c10);
+    _mm256_storeu_si256((__m256i *)(out + 12), c11);
+    _mm256_storeu_si256((__m256i *)(out + 16), c20);
+    _mm256_storeu_si256((__m256i *)(out + 20), c21);
+    _mm256_storeu_si256((__m256i *)(out + 24), c30);
+    _mm256_storeu_si256((__m256i *)(out + 28), c31);
+}
+
+#else
+
+#define MOD_TILE 8
+
+static void mod_tile(const uint64_t *const a[4], const uint64_t *b, MX ldb, MX n, MX delay, uint64_t fold, uint64_t *out)
+{
+    uint64_t acc[4 * MOD_TILE] = {0};
+
+    for (MX k0 = 0; k0 < n; k0 += delay)
+    {
+        MX k1 = n - k0 < delay ? n : k0 + delay;
+
+        for (MX k = k0; k < k1; k++)
+        {
+            const uint64_t *bk = b + (size_t)k * ldb;
+
+            for (MX r = 0; r < 4; r++)
+            {
+                const uint64_t ar = a[r][k];
+
+                for (MX t = 0; t < MOD_TILE; t++)
+                {
+                    acc[r * MOD_TILE + t] += ar * bk[t];
+                }
+            }
+        }
+
+        if (k1 < n)
+        {
+            for (MX t = 0; t < 4 * MOD_TILE; t++)
+            {
+                acc[t] = (acc[t] >> 32) * fold + (acc[t] & 0xffffffffull);
+            }
+        }
+    }
+
+    memcpy(out, acc, sizeof(acc));
+}
+
+#endif
+
+/**
+ * @brief sum a[k] b[k] mod m, m < 2^63.
+ *
+ * t < m 2^64 tutulur: üst yarı m'yi geçtiğinde m 2^64 (= 0 mod m) çıkarılır.
+ * Bir çarpım m^2'den küçük olduğundan t + p < m (2^64 + m) < 2^128; böylece
+ * her adımda yalnızca bir karşılaştırma yapılır ve bölme sonda bir kez olur.
+ */
+static uint64_t mod_dot_wide(const uint64_t *a, const uint64_t *b, MX n, uint64_t m)
+{
+    mod_u128 t = 0;
+
+    for (MX k = 0; k < n; k++)
+    {
+        t += (mod_u128)a[k] * b[k];
+
+        if ((uint64_t)(t >> 64) >= m)
+        {
+            t -= (mod_u128)m << 64;
+        }
+    }
+
+    return (uint64_t)(t % m);
+}
+
+/**
+ * @brief B^T'nin art arda dört satırıyla mod_dot_wide; a[k] bir kez okunur.
+ */
+static void mod_dot_wide4(const uint64_t *a, const uint64_t *b, MX n, uint64_t m, uint64_t *out)
+{
+    mod_u128 t0 = 0, t1 = 0, t2 = 0, t3 = 0;
+    const mod_u128 fold = (mod_u128)m << 64;
+
+    for (MX k = 0; k < n; k++)
+    {
+        const uint64_t ak = a[k];
+
+        t0 += (mod_u128)ak * b[k];
+        t1 += (mod_u128)ak * b[n + k];
+        t2 += (mod_u128)ak * b[2 * n + k];
+        t3 += (mod_u128)ak * b[3 * n + k];
+
+        t0 = (uint64_t)(t0 >> 64) >= m ? t0 - fold : t0;
+        t1 = (uint64_t)(t1 >> 64) >= m ? t1 - fold : t1;
+        t2 = (uint64_t)(t2 >> 64) >= m ? t2 - fold : t2;
+        t3 = (uint64_t)(t3 >> 64) >= m ? t3 - fold : t3;
+    }
+
+    out[0] = (uint64_t)(t0 % m);
+    out[1] = (uint64_t)(t1 % m);
+    out[2] = (uint64_t)(t2 % m);
+    out[3] = (uint64_t)(t3 % m);
+}
+
+typedef struct
+{
+    const mmatrix *A;
+    const mmatrix *B;
+    mmatrix *C;
+
+    /* mod <= 2^32: katlamalar arası çarpım sayısı, 2^32 mod m ve Barrett sabiti */
+    MX delay;
+    uint64_t fold;
+    uint64_t barrett;
+
+    /* mod > 2^32: B^T, satır uzunluğu B.row */
+    const uint64_t *bt;
+
+} mod_ctx;
+
+static void mod_multiply_narrow(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    mod_ctx *c = (mod_ctx *)arg;
+    const uint64_t m = c->C->mod;
+    uint64_t tile[4 * MOD_TILE];
+    (void)worker;
+
+    for (MX blk = (MX)begin; blk < (MX)end; blk++)
+    {
+        const MX i0 = blk * 4;
+        const MX rows = c->C->row - i0 < 4 ? c->C->row - i0 : 4;
+        const uint64_t *a[4];
+
+        // Eksik satırlar ilk satırı tekrar eder; sonuçları yazılmaz
+        for (MX r = 0; r < 4; r++)
+        {
+            a[r] = c->A->data + (size_t)(i0 + (r < rows ? r : 0)) * c->A->ld;
+        }
+
+        for (MX j0 = 0; j0 < c->C->ld; j0 += MOD_TILE)
+        {
+            mod_tile(a, c->B->data + j0, c->B->ld, c->A->col, c->delay, c->fold, tile);
+
+            for (MX r = 0; r < rows; r++)
+            {
+                uint64_t *out = c->C->data + (size_t)(i0 + r) * c->C->ld + j0;
+
+                for (MX t = 0; t < MOD_TILE; t++)
+                {
+                    out[t] = mod_barrett(tile[r * MOD_TILE + t], m, c->barrett);
+                }
+            }
+        }
+    }
+}
+
+static void mod_multiply_wide(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    mod_ctx *c = (mod_ctx *)arg;
+    const MX inner = c->A->col;
+    (void)worker;
+
+    for (MX i = (MX)begin; i < (MX)end; i++)
+    {
+        const uint64_t *a = c->A->data + (size_t)i * c->A->ld;
+        uint64_t *out = c->C->data + (size_t)i * c->C->ld;
+        MX j = 0;
+
+        for (; j + 4 <= c->C->col; j += 4)
+        {
+            mod_dot_wide4(a, c->bt + (size_t)j * inner, inner, c->C->mod, out + j);
+        }
+
+        for (; j < c->C->col; j++)
+        {
+            out[j] = mod_dot_wide(a, c->bt + (size_t)j * inner, inner, c->C->mod);
+        }
+    }
+}
+
+/**
+ * @brief C = A . B; C önceden ayrılmıştır ve A, B'den farklıdır.
+ * Büyük modlarda bt, B.row * B.col elemanlık geçici tampondur.
+ */
+static void mod_multiply_into(const mmatrix *A, const mmatrix *B, mmatrix *C, uint64_t *bt)
+{
+    const uint64_t m = C->mod;
+    mod_ctx ctx = {A, B, C, 0, 0, 0, bt};
+    unsigned long row_work = (unsigned long)A->col * B->col + 1;
+    unsigned long grain = row_work >= MOD_CHUNK ? 1 : MOD_CHUNK / row_work;
+
+    if (m <= MOD_NARROW_LIMIT)
+    {
+        // Katlamadan sonra birikeç < (2^32 - 1)(fold + 1); her çarpım en fazla (m - 1)^2
+        uint64_t top = m - 1;
+
+        ctx.fold = (1ull << 32) % m;
+        ctx.barrett = UINT64_MAX / m;
+
+        uint64_t room = UINT64_MAX - 0xffffffffull * (ctx.fold + 1);
+        uint64_t delay = top == 0 ? UINT64_MAX : room / (top * top);
+
+        ctx.delay = delay > A->col ? A->col : (MX)delay;
+
+        parallel_for(0, (A->row + 3) / 4, grain / 4 + 1, mod_multiply_narrow, &ctx);
+    }
+    else
+    {
+        for (MX k = 0; k < B->row; k++)
+        {
+            const uint64_t *b = B->data + (size_t)k * B->ld;
+
+            for (MX j = 0; j < B->col; j++)
+            {
+                bt[(size_t)j * B->row + k] = b[j];
+            }
+        }
+
+        parallel_for(0, A->row, grain, mod_multiply_wide, &ctx);
+    }
+}
+
+mmatrix __allocate_mod_matrix(MX row, MX col, uint64_t mod)
+{
+    if (mod == 0 || mod >= MOD_LIMIT)
+    {
+        printf("\n\nModulus Error allocate_mod_matrix function\n\n");
+        return MMATRIX_UNDEFINED;
+    }
+
+    mmatrix m;
+    size_t bytes;
+
+    m.row = row;
+    m.col = col;
+    m.ld = (col + MOD_ALIGN - 1) / MOD_ALIGN * MOD_ALIGN;
+    m.mod = mod;
+
+    bytes = (size_t)row * m.ld * sizeof(uint64_t);
+    m.data = (uint64_t *)MEMORY_ALLOC_ALIGNED(bytes > 0 ? bytes : 1);
+
+    __allocation_err(m.data, "Modular matrix");
+
+    memset(m.data, 0, bytes);
+
+    return m;
+}
+
+mmatrix __mod_identity_matrix(MX n, uint64_t mod)
+{
+    mmatrix m = __allocate_mod_matrix(n, n, mod);
+
+    if (m.data != NULL)
+    {
+        for (MX i = 0; i < n; i++)
+        {
+            m.data[(size_t)i * m.ld + i] = 1 % mod;
+        }
+    }
+
+    return m;
+}
+
+mmatrix __mod_matrix_from(const uint64_t *values, MX row, MX col, uint64_t mod)
+{
+    mmatrix m = __allocate_mod_matrix(row, col, mod);
+
+    if (m.data != NULL)
+    {
+        for (MX i = 0; i < row; i++)
+        {
+            for (MX j = 0; j < col; j++)
+            {
+                m.data[(size_t)i * m.ld + j] = values[(size_t)i * col + j] % mod;
+            }
+        }
+    }
+
+    return m;
+}
+
+mmatrix __mod_matrix_from_float(matrix matx, uint64_t mod)
+{
+    mmatrix m = __allocate_mod_matrix(matx.row, matx.col, mod);
+
+    if (m.data != NULL)
+    {
+        for (MX i = 0; i < matx.row; i++)
+        {
+            const float *row = matx.vrows[i]->elements;
+
+            for (MX j = 0; j < matx.col; j++)
+            {
+                long long v = llrintf(row[j]) % (long long)mod;
+
+                m.data[(size_t)i * m.ld + j] = (uint64_t)(v < 0 ? v + (long long)mod : v);
+            }
+        }
+    }
+
+    return m;
+}
+
+void __free_mod_matrix(mmatrix *m)
+{
+    if (m->data != NULL)
+    {
+        memory_free_aligned(m->data);
+    }
+
+    *m = MMATRIX_UNDEFINED;
+}
+
+uint64_t __mod_get(mmatrix m, MX i, MX j)
+{
+    return m.data[(size_t)i * m.ld + j];
+}
+
+void __mod_set(mmatrix m, MX i, MX j, uint64_t value)
+{
+    m.data[(size_t)i * m.ld + j] = value % m.mod;
+}
+
+mmatrix __mod_multiplication(mmatrix A, mmatrix B)
+{
+    if (A.col != B.row || A.mod != B.mod || A.data == NULL || B.data == NULL)
+    {
+        printf("\n\nDimention Error mod_multiplication function\n\n");
+        return MMATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MOD_MULTIPLICATION);
+
+    mmatrix C = __allocate_mod_matrix(A.row, B.col, A.mod);
+    uint64_t *bt = NULL;
+
+    if (A.mod > MOD_NARROW_LIMIT)
+    {
+        bt = (uint64_t *)MEMORY_ALLOC(((size_t)B.row * B.col + 1) * sizeof(uint64_t));
+        __allocation_err(bt, "Modular transpose");
+    }
+
+    mod_multiply_into(&A, &B, &C, bt);
+
+    if (bt != NULL)
+    {
+        memory_free(bt);
+    }
+
+    PROFILE_END(PROFILE_MOD_MULTIPLICATION, 2ull * A.row * A.col * B.col,
+                ((unsigned long long)A.row * A.ld + (unsigned long long)B.row * B.ld + (unsigned long long)C.row * C.ld) * sizeof(uint64_t));
+
+    return C;
+}
+
+mmatrix __mod_power(mmatrix A, uint64_t e)
+{
+    if (A.row != A.col || A.data == NULL)
+    {
+        printf("\n\nDimention Error mod_power function\n\n");
+        return MMATRIX_UNDEFINED;
+    }
+
+    if (e == 0)
+    {
+        return __mod_identity_matrix(A.row, A.mod);
+    }
+
+    PROFILE_BEGIN(PROFILE_MOD_POWER);
+
+    const MX n = A.row;
+    mmatrix R = __allocate_mod_matrix(n, n, A.mod);
+    mmatrix T = __allocate_mod_matrix(n, n, A.mod);
+    uint64_t *bt = NULL;
+    unsigned long long products = 0;
+
+    memcpy(R.data, A.data, (size_t)n * A.ld * sizeof(uint64_t));
+
+    if (A.mod > MOD_NARROW_LIMIT)
+    {
+        bt = (uint64_t *)MEMORY_ALLOC(((size_t)n * n + 1) * sizeof(uint64_t));
+        __allocation_err(bt, "Modular transpose");
+    }
+
+    // Soldan sağa: en yüksek bitten sonraki her bit için kare, bit 1 ise A ile çarpım
+    uint64_t bit = 1ull << 63;
+
+    while (!(e & bit))
+    {
+        bit >>= 1;
+    }
+
+    for (bit >>= 1; bit != 0; bit >>= 1)
+    {
+        mod_multiply_into(&R, &R, &T, bt);
+
+        mmatrix swap = R;
+        R = T;
+        T = swap;
+        products++;
+
+        if (e & bit)
+        {
+            mod_multiply_into(&R, &A, &T, bt);
+
+            swap = R;
+            R = T;
+            T = swap;
+            products++;
+        }
+    }
+
+    if (bt != NULL)
+    {
+        memory_free(bt);
+    }
+
+    __free_mod_matrix(&T);
+
+    PROFILE_END(PROFILE_MOD_POWER, 2ull * products * n * n * n, 3ull * products * n * A.ld * sizeof(uint64_t));
+
+    return R;
+}
\ No newline at end of file
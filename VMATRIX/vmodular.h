@@ -0,0 +1,91 @@
+#include <stdint.h>
+
+#include "vmatrix.h"
+
+#ifndef VMODULAR_H
+#define VMODULAR_H
+
+/**
+ * @brief Elemanları [0, mod) aralığında tutulan tamsayı matrix; tüm işlemler
+ * mod üzerinden tamdır (doğrusal yinelemeler, yol sayma).
+ *
+ * Satır i, data + i * ld adresindedir; ld 16'nın katıdır ve dolgu sıfırdır.
+ * 1 <= mod < 2^63 olmalıdır. mod <= 2^32 iken çarpım SIMD ile 32 x 32 -> 64
+ * bit yapılır, daha büyük modlarda 128 bitlik birikeç kullanılır.
+ */
+typedef struct
+{
+    MX row;
+    MX col;
+    MX ld;
+    uint64_t mod;
+    uint64_t *data;
+
+} mmatrix;
+
+extern const mmatrix MMATRIX_UNDEFINED;
+
+/**
+ * @brief Sıfırlarla dolu row x col matrix.
+ *
+ * @param row
+ * @param col
+ * @param mod
+ * @return mmatrix mod geçersizse MMATRIX_UNDEFINED
+ */
+mmatrix __allocate_mod_matrix(MX row, MX col, uint64_t mod);
+
+mmatrix __mod_identity_matrix(MX n, uint64_t mod);
+
+/**
+ * @brief values satır sıralı row x col dizidir; her değer mod'a indirgenir.
+ *
+ * @param values
+ * @param row
+ * @param col
+ * @param mod
+ * @return mmatrix
+ */
+mmatrix __mod_matrix_from(const uint64_t *values, MX row, MX col, uint64_t mod);
+
+/**
+ * @brief float matrixten; değerler en yakın tamsayıya yuvarlanır, negatifler
+ * mod'a göre pozitife taşınır (ör. komşuluk matrixi).
+ *
+ * @param matx
+ * @param mod
+ * @return mmatrix
+ */
+mmatrix __mod_matrix_from_float(matrix matx, uint64_t mod);
+
+void __free_mod_matrix(mmatrix *m);
+
+uint64_t __mod_get(mmatrix m, MX i, MX j);
+void __mod_set(mmatrix m, MX i, MX j, uint64_t value);
+
+/**
+ * @brief C = A . B (mod). A ve B aynı modda olmalıdır.
+ *
+ * İndirgeme iç döngüden çıkarılır: 64 bitlik birikeçler yazmaçta kalır ve
+ * taşmaya yaklaştıklarında yalnızca 32 bitlik bir katlama ile küçültülür
+ * (ör. mod ~ 10^9 için 17 çarpımda bir); her eleman sonda bir kez Barrett
+ * indirgemesinden geçer.
+ *
+ * @param A
+ * @param B
+ * @return mmatrix
+ */
+mmatrix __mod_multiplication(mmatrix A, mmatrix B);
+
+/**
+ * @brief A^e (mod), ikili üs alma ile en fazla 2 log2(e) çarpım.
+ *
+ * Ara sonuçlar iki tampon arasında gidip gelir; döngüde bellek ayrılmaz.
+ *
+ * @param A Kare matrix
+ * @param e
+ * @return mmatrix e = 0 için birim matrix
+ */
+mmatrix __mod_power(mmatrix A, uint64_t e);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,533 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//
+//      VPACKED.C
+//  Üçgen, simetrik ve bant
+//  matrixlerin sıkıştırılmış hali
+//
+#include "vpacked.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği çarpma-toplam sayısı.
+ */
+#define PACKED_CHUNK 32768
+
+/**
+ * @brief Simetrik çarpımda bir thread'in aldığı sütun bloğu.
+ */
+#define PACKED_COL_BLOCK 64
+
+const packed_matrix PACKED_UNDEFINED = {PACKED_UPPER, 0, 0, 0, NULL, 0};
+
+/**
+ * @brief Satır i'nin tutulan bölümü: ilk sütun, uzunluk ve ilk elemanın adresi.
+ */
+static float *packed_row(packed_matrix p, MX i, MX *first, MX *len)
+{
+    switch (p.kind)
+    {
+    case PACKED_UPPER:
+        *first = i;
+        *len = p.n - i;
+        return p.data + (size_t)i * (2 * (size_t)p.n - i + 1) / 2;
+    case PACKED_LOWER:
+    case PACKED_SYMMETRIC:
+        *first = 0;
+        *len = i + 1;
+        return p.data + (size_t)i * (i + 1) / 2;
+    case PACKED_BANDED:
+    default:
+    {
+        MX lo = i > p.kl ? i - p.kl : 0;
+        MX hi = p.n - 1 - i > p.ku ? i + p.ku : p.n - 1;
+
+        *first = lo;
+        *len = hi - lo + 1;
+        return p.data + (size_t)i * (p.kl + p.ku + 1) + (lo + p.kl - i);
+    }
+    }
+}
+
+packed_matrix __allocate_packed(packed_kind kind, MX n, MX kl, MX ku)
+{
+    packed_matrix p = PACKED_UNDEFINED;
+
+    p.kind = kind;
+    p.n = n;
+
+    if (kind == PACKED_BANDED)
+    {
+        p.kl = kl < n ? kl : (n > 0 ? n - 1 : 0);
+        p.ku = ku < n ? ku : (n > 0 ? n - 1 : 0);
+        p.size = (size_t)n * (p.kl + p.ku + 1);
+    }
+    else
+    {
+        p.size = (size_t)n * (n + 1) / 2;
+    }
+
+    p.data = (float *)MEMORY_ALLOC_ALIGNED((p.size > 0 ? p.size : 1) * sizeof(float));
+
+    __allocation_err(p.data, "Packed matrix");
+
+    memset(p.data, 0, p.size * sizeof(float));
+
+    return p;
+}
+
+void __free_packed(packed_matrix *p)
+{
+    memory_free_aligned(p->data);
+    *p = PACKED_UNDEFINED;
+}
+
+packed_matrix __packed_identity(MX n)
+{
+    packed_matrix p = __allocate_packed(PACKED_BANDED, n, 0, 0);
+
+    for (MX i = 0; i < n; i++)
+    {
+        p.data[i] = 1.0f;
+    }
+
+    return p;
+}
+
+packed_matrix __pack_matrix(matrix matx, packed_kind kind, MX kl, MX ku)
+{
+    if (matx.row != matx.col || matx.vrows == NULL)
+    {
+        printf("\n\nDimention Error pack matrix function\n\n");
+        return PACKED_UNDEFINED;
+    }
+
+    packed_matrix p = __allocate_packed(kind, matx.row, kl, ku);
+
+    for (MX i = 0; i < p.n; i++)
+    {
+        MX first, len;
+        float *row = packed_row(p, i, &first, &len);
+
+        memcpy(row, matx.vrows[i]->elements + first, len * sizeof(float));
+    }
+
+    return p;
+}
+
+matrix __unpack_matrix(packed_matrix p)
+{
+    if (p.data == NULL)
+    {
+        return MATRIX_UNDEFINED;
+    }
+
+    matrix ret_matrix = __zero_matrix(p.n, p.n);
+
+    for (MX i = 0; i < p.n; i++)
+    {
+        MX first, len;
+        const float *row = packed_row(p, i, &first, &len);
+
+        memcpy(ret_matrix.vrows[i]->elements + first, row, len * sizeof(float));
+
+        // Simetrik türde üst üçgen alt üçgenin aynasıdır
+        if (p.kind == PACKED_SYMMETRIC)
+        {
+            for (MX j = 0; j < i; j++)
+            {
+                ret_matrix.vrows[j]->elements[i] = row[j];
+            }
+        }
+    }
+
+    return ret_matrix;
+}
+
+/**
+ * @brief A[i][j]'nin adresi; yapının dışındaysa NULL.
+ */
+static float *packed_at(packed_matrix p, MX i, MX j)
+{
+    if (i >= p.n || j >= p.n)
+    {
+        return NULL;
+    }
+
+    if (p.kind == PACKED_SYMMETRIC && j > i)
+    {
+        MX t = i;
+        i = j;
+        j = t;
+    }
+
+    MX first, len;
+    float *row = packed_row(p, i, &first, &len);
+
+    return j >= first && j - first < len ? row + (j - first) : NULL;
+}
+
+float __packed_get(packed_matrix p, MX i, MX j)
+{
+    float *e = packed_at(p, i, j);
+
+    return e != NULL ? *e : 0.0f;
+}
+
+bool __packed_set(packed_matrix *p, MX i, MX j, float value)
+{
+    float *e = packed_at(*p, i, j);
+
+    if (e == NULL)
+    {
+        printf("\n\nElement is outside the packed structure\n\n");
+        return false;
+    }
+
+    *e = value;
+
+    return true;
+}
+
+vec __packed_matvec(packed_matrix p, vec x)
+{
+    if (x.dim != p.n || p.data == NULL)
+    {
+        printf("\n\nDimention Error packed matvec function\n\n");
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_PACKED_MATVEC);
+
+    vec y = allocate_vector_mem(p.n);
+
+    if (p.kind == PACKED_SYMMETRIC)
+    {
+        // Satır i hem y_i'ye (alt üçgen) hem de y_0..y_{i-1}'e (aynası) katkı verir
+        memset(y.elements, 0, p.n * sizeof(float));
+
+        for (MX i = 0; i < p.n; i++)
+        {
+            MX first, len;
+            const float *row = packed_row(p, i, &first, &len);
+
+            y.elements[i] += simd_dot(row, x.elements, i) + row[i] * x.elements[i];
+            simd_axpy(y.elements, row, x.elements[i], i);
+        }
+    }
+    else
+    {
+        for (MX i = 0; i < p.n; i++)
+        {
+            MX first, len;
+            const float *row = packed_row(p, i, &first, &len);
+
+            y.elements[i] = simd_dot(row, x.elements + first, len);
+        }
+    }
+
+    PROFILE_END(PROFILE_PACKED_MATVEC, 2ull * (p.kind == PACKED_SYMMETRIC ? 2 * p.size - p.n : p.size),
+                (p.size + 2ull * p.n) * sizeof(float));
+
+    return y;
+}
+
+typedef struct
+{
+    packed_matrix p;
+    matrix B;
+    matrix C;
+
+} packed_multiply_ctx;
+
+/**
+ * @brief C_i = sum_j A[i][j] B_j; satırlar birbirinden bağımsızdır.
+ */
+static void packed_multiply_rows(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    packed_multiply_ctx *c = (packed_multiply_ctx *)arg;
+    (void)worker;
+
+    for (MX i = (MX)begin; i < (MX)end; i++)
+    {
+        MX first, len;
+        const float *row = packed_row(c->p, i, &first, &len);
+        float *out = c->C.vrows[i]->elements;
+
+        for (MX t = 0; t < len; t++)
+        {
+            if (row[t] != 0.0f)
+            {
+                simd_axpy(out, c->B.vrows[first + t]->elements, row[t], c->B.col);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Simetrik çarpım, sütun blokları üzerinde: alt üçgenin satır i'si
+ * C_i'ye ve aynası C_0..C_{i-1}'e yazar; bloklar farklı sütunlara yazdığından çakışmaz.
+ */
+static void packed_multiply_cols(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    packed_multiply_ctx *c = (packed_multiply_ctx *)arg;
+    (void)worker;
+
+    MX c0 = (MX)begin * PACKED_COL_BLOCK;
+    MX c1 = (MX)end * PACKED_COL_BLOCK < c->B.col ? (MX)end * PACKED_COL_BLOCK : c->B.col;
+
+    for (MX i = 0; i < c->p.n; i++)
+    {
+        MX first, len;
+        const float *row = packed_row(c->p, i, &first, &len);
+        const float *b_i = c->B.vrows[i]->elements + c0;
+        float *out = c->C.vrows[i]->elements + c0;
+
+        for (MX j = 0; j < i; j++)
+        {
+            if (row[j] != 0.0f)
+            {
+                simd_axpy(out, c->B.vrows[j]->elements + c0, row[j], c1 - c0);
+                simd_axpy(c->C.vrows[j]->elements + c0, b_i, row[j], c1 - c0);
+            }
+        }
+
+        simd_axpy(out, b_i, row[i], c1 - c0);
+    }
+}
+
+matrix __packed_multiplication(packed_matrix p, matrix B)
+{
+    if (B.row != p.n || p.data == NULL)
+    {
+        printf("\n\nDimention Error packed multiplication function\n\n");
+        return MATRIX_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_PACKED_MULTIPLICATION);
+
+    packed_multiply_ctx ctx = {p, B, __zero_matrix(p.n, B.col)};
+
+    if (p.kind == PACKED_SYMMETRIC)
+    {
+        unsigned long blocks = (B.col + PACKED_COL_BLOCK - 1) / PACKED_COL_BLOCK;
+
+        parallel_for(0, blocks, 1, packed_multiply_cols, &ctx);
+    }
+    else
+    {
+        unsigned long row_work = (unsigned long)(p.size / (p.n > 0 ? p.n : 1) + 1) * (B.col + 1);
+
+        parallel_for(0, p.n, row_work >= PACKED_CHUNK ? 1 : PACKED_CHUNK / row_work, packed_multiply_rows, &ctx);
+    }
+
+    PROFILE_END(PROFILE_PACKED_MULTIPLICATION, 2ull * (p.kind == PACKED_SYMMETRIC ? 2 * p.size - p.n : p.size) * B.col,
+                (p.size + 2ull * p.n * B.col) * sizeof(float));
+
+    return ctx.C;
+}
+
+/**
+ * @brief Alt üçgen L ile L . x = b (x yerinde b'nin üzerine yazılır).
+ */
+static bool solve_lower(packed_matrix p, float *x)
+{
+    for (MX i = 0; i < p.n; i++)
+    {
+        MX first, len;
+        const float *row = packed_row(p, i, &first, &len);
+
+        if (row[i] == 0.0f)
+        {
+            return false;
+        }
+
+        x[i] = (x[i] - simd_dot(row, x, i)) / row[i];
+    }
+
+    return true;
+}
+
+/**
+ * @brief L^T . x = b; L satır satır tutulduğundan sütun yönlü (axpy) geri yerine koyma.
+ */
+static bool solve_lower_transposed(packed_matrix p, float *x)
+{
+    for (MX i = p.n; i-- > 0;)
+    {
+        MX first, len;
+        const float *row = packed_row(p, i, &first, &len);
+
+        if (row[i] == 0.0f)
+        {
+            return false;
+        }
+
+        x[i] /= row[i];
+        simd_axpy(x, row, -x[i], i);
+    }
+
+    return true;
+}
+
+static bool solve_upper(packed_matrix p, float *x)
+{
+    for (MX i = p.n; i-- > 0;)
+    {
+        MX first, len;
+        const float *row = packed_row(p, i, &first, &len);
+
+        if (row[0] == 0.0f)
+        {
+            return false;
+        }
+
+        x[i] = (x[i] - simd_dot(row + 1, x + i + 1, len - 1)) / row[0];
+    }
+
+    return true;
+}
+
+/**
+ * @brief Yerinde Cholesky: A = L . L^T, L alt üçgen olarak A'nın yerine yazılır.
+ */
+static bool cholesky_packed(packed_matrix p)
+{
+    for (MX i = 0; i < p.n; i++)
+    {
+        MX first, len;
+        float *row_i = packed_row(p, i, &first, &len);
+
+        for (MX j = 0; j <= i; j++)
+        {
+            const float *row_j = packed_row(p, j, &first, &len);
+            float s = row_i[j] - simd_dot(row_i, row_j, j);
+
+            if (j < i)
+            {
+                row_i[j] = s / row_j[j];
+            }
+            else if (s > 0.0f)
+            {
+                row_i[i] = sqrtf(s);
+            }
+            else
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Pivotsuz bant eliminasyonu; kopya üzerinde çalışır, üst bant genişliği değişmez.
+ */
+static bool solve_banded(packed_matrix p, float *x)
+{
+    const MX w = p.kl + p.ku + 1;
+
+    for (MX k = 0; k < p.n; k++)
+    {
+        float *row_k = p.data + (size_t)k * w + p.kl;
+        MX span = p.n - 1 - k > p.ku ? p.ku : p.n - 1 - k;
+
+        if (row_k[0] == 0.0f)
+        {
+            return false;
+        }
+
+        for (MX i = k + 1; i < p.n && i - k <= p.kl; i++)
+        {
+            // Satır i'de sütun k'nın konumu
+            float *row_i = p.data + (size_t)i * w + (p.kl - (i - k));
+            float f = row_i[0] / row_k[0];
+
+            if (f != 0.0f)
+            {
+                simd_axpy(row_i + 1, row_k + 1, -f, span);
+                x[i] -= f * x[k];
+            }
+            row_i[0] = 0.0f;
+        }
+    }
+
+    for (MX i = p.n; i-- > 0;)
+    {
+        const float *row_i = p.data + (size_t)i * w + p.kl;
+        MX span = p.n - 1 - i > p.ku ? p.ku : p.n - 1 - i;
+
+        x[i] = (x[i] - simd_dot(row_i + 1, x + i + 1, span)) / row_i[0];
+    }
+
+    return true;
+}
+
+vec __packed_solve(packed_matrix p, vec b)
+{
+    if (b.dim != p.n || p.data == NULL)
+    {
+        printf("\n\nDimention Error packed solve function\n\n");
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_PACKED_SOLVE);
+
+    vec x = allocate_vector_mem(p.n);
+    memcpy(x.elements, b.elements, p.n * sizeof(float));
+
+    bool ok;
+    unsigned long long flops = 2ull * p.size;
+
+    switch (p.kind)
+    {
+    case PACKED_LOWER:
+        ok = solve_lower(p, x.elements);
+        break;
+    case PACKED_UPPER:
+        ok = solve_upper(p, x.elements);
+        break;
+    case PACKED_SYMMETRIC:
+    {
+        // Çarpanlara ayırma bir kopya üzerinde yapılır
+        packed_matrix l = __allocate_packed(p.kind, p.n, 0, 0);
+        memcpy(l.data, p.data, p.size * sizeof(float));
+
+        ok = cholesky_packed(l) && solve_lower(l, x.elements) && solve_lower_transposed(l, x.elements);
+        flops += (unsigned long long)p.n * p.n * p.n / 3;
+
+        __free_packed(&l);
+        break;
+    }
+    case PACKED_BANDED:
+    default:
+    {
+        packed_matrix lu = __allocate_packed(p.kind, p.n, p.kl, p.ku);
+        memcpy(lu.data, p.data, p.size * sizeof(float));
+
+        ok = solve_banded(lu, x.elements);
+        flops += 2ull * p.n * p.kl * (p.ku + 1);
+
+        __free_packed(&lu);
+        break;
+    }
+    }
+
+    if (!ok)
+    {
+        printf("\n\nPacked solve failed: zero pivot or matrix not positive definite\n\n");
+        free_vector(&x);
+        PROFILE_END(PROFILE_PACKED_SOLVE, 0, 0);
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_END(PROFILE_PACKED_SOLVE, flops, (p.size + 2ull * p.n) * sizeof(float));
+
+    return x;
+}
\ No newline at end of file
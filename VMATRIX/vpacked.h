@@ -0,0 +1,129 @@
+#include <stddef.h>
+
+#include "vmatrix.h"
+#include "../CMATH/vec.h"
+
+#ifndef VPACKED_H
+#define VPACKED_H
+
+/**
+ * @brief Sıkıştırılmış kare matrix türleri.
+ *
+ * PACKED_UPPER     : üst üçgen; satır i, i..n-1 sütunlarını tutar
+ * PACKED_LOWER     : alt üçgen; satır i, 0..i sütunlarını tutar
+ * PACKED_SYMMETRIC : simetrik; alt üçgen tutulur, A[i][j] = A[j][i]
+ * PACKED_BANDED    : bant; satır i, i-kl..i+ku sütunlarını tutar
+ *
+ * Üçgen ve simetrik türler n(n+1)/2, bant türü n(kl+ku+1) float kullanır.
+ * Yapının dışındaki elemanlar sıfırdır.
+ */
+typedef enum
+{
+    PACKED_UPPER,
+    PACKED_LOWER,
+    PACKED_SYMMETRIC,
+    PACKED_BANDED
+
+} packed_kind;
+
+typedef struct
+{
+    packed_kind kind;
+    MX n;
+
+    /* Bant türünde alt ve üst köşegen sayısı, diğerlerinde 0 */
+    MX kl;
+    MX ku;
+
+    /* Satırlar art arda, dolgusuz */
+    float *data;
+    size_t size;
+
+} packed_matrix;
+
+extern const packed_matrix PACKED_UNDEFINED;
+
+/**
+ * @brief Sıfırlanmış n x n sıkıştırılmış matrix.
+ *
+ * @param kind
+ * @param n
+ * @param kl Yalnızca PACKED_BANDED için
+ * @param ku Yalnızca PACKED_BANDED için
+ * @return packed_matrix
+ */
+packed_matrix __allocate_packed(packed_kind kind, MX n, MX kl, MX ku);
+
+void __free_packed(packed_matrix *p);
+
+/**
+ * @brief n x n birim matrix; yalnızca köşegen tutulur (kl = ku = 0 bant).
+ *
+ * @param n
+ * @return packed_matrix
+ */
+packed_matrix __packed_identity(MX n);
+
+/**
+ * @brief Kare matrixin ilgili bölümünü sıkıştırır. Simetrik türde alt üçgen alınır.
+ *
+ * @param matx
+ * @param kind
+ * @param kl
+ * @param ku
+ * @return packed_matrix
+ */
+packed_matrix __pack_matrix(matrix matx, packed_kind kind, MX kl, MX ku);
+
+/**
+ * @brief Tam (yoğun) matrix karşılığı.
+ *
+ * @param p
+ * @return matrix
+ */
+matrix __unpack_matrix(packed_matrix p);
+
+/**
+ * @brief A[i][j]; yapının dışındaki elemanlar için 0.
+ */
+float __packed_get(packed_matrix p, MX i, MX j);
+
+/**
+ * @brief A[i][j] = value. Simetrik türde A[j][i] de değişir.
+ *
+ * @return bool Eleman yapının dışındaysa false
+ */
+bool __packed_set(packed_matrix *p, MX i, MX j, float value);
+
+/**
+ * @brief y = A . x; yalnızca tutulan elemanlar çarpılır.
+ *
+ * @param p
+ * @param x n boyutlu
+ * @return vec
+ */
+vec __packed_matvec(packed_matrix p, vec x);
+
+/**
+ * @brief C = A . B, B yoğun n x m matrix.
+ *
+ * @param p
+ * @param B
+ * @return matrix
+ */
+matrix __packed_multiplication(packed_matrix p, matrix B);
+
+/**
+ * @brief A . x = b sistemini çözer.
+ *
+ * Üçgen türlerde ileri/geri yerine koyma, simetrik türde Cholesky
+ * (A pozitif tanımlı olmalıdır), bant türünde pivotsuz bant eliminasyonu
+ * kullanılır (köşegen baskın sistemler; kl = ku = 1 için Thomas algoritması).
+ *
+ * @param p
+ * @param b
+ * @return vec Sıfır pivot veya pozitif tanımlı olmayan matrixte VEC_UNDEFINED
+ */
+vec __packed_solve(packed_matrix p, vec b);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,592 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//
+//      VQUANT.C
+//  int8 olarak tutulan matrixler,
+//  tamsayı nokta çarpımı ile çarpım
+//
+#include "vquant.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Hat uzunluğunun yuvarlandığı bayt sayısı; çekirdeklerde kuyruk döngüsü olmaz.
+ */
+#define QUANT_ALIGN 64
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği çarpma-toplam sayısı.
+ */
+#define QUANT_CHUNK 65536
+
+/**
+ * @brief Çarpımda birlikte işlenen B hatlarının toplam boyutu (L2'de kalır).
+ */
+#define QUANT_B_BLOCK (128 * 1024)
+
+const qmatrix QMATRIX_UNDEFINED = {QUANT_PER_ROW, 0, 0, 0, 0, 0, NULL, NULL, NULL, NULL};
+
+/*
+ * int8 nokta çarpımları. Hatlar QUANT_ALIGN'a hizalı ve n bunun katıdır.
+ *
+ * AVX512-VNNI: vpdpbusd işaretsiz x işaretli bayt çarpar; b ^ 0x80 = b + 128
+ * işaretsiz olarak verilir ve sonuçtan 128 * sum(a) çıkarılır.
+ * AVX2: baytlar 16 bite genişletilip vpmaddwd ile toplanır (taşma olmaz;
+ * vpmaddubsw çift toplamında int16 doyması olurdu).
+ */
+#if defined(__AVX512VNNI__)
+
+static void quant_dot4(const int8_t *const a[4], const int32_t sum_a[4], const int8_t *b, MX n, int32_t out[4])
+{
+    const __m512i flip = _mm512_set1_epi8((char)0x80);
+    __m512i s0 = _mm512_setzero_si512(), s1 = s0, s2 = s0, s3 = s0;
+
+    for (MX t = 0; t < n; t += 64)
+    {
+        __m512i vb = _mm512_xor_si512(_mm512_load_si512((const void *)(b + t)), flip);
+
+        s0 = _mm512_dpbusd_epi32(s0, vb, _mm512_load_si512((const void *)(a[0] + t)));
+        s1 = _mm512_dpbusd_epi32(s1, vb, _mm512_load_si512((const void *)(a[1] + t)));
+        s2 = _mm512_dpbusd_epi32(s2, vb, _mm512_load_si512((const void *)(a[2] + t)));
+        s3 = _mm512_dpbusd_epi32(s3, vb, _mm512_load_si512((const void *)(a[3] + t)));
+    }
+
+    out[0] = _mm512_reduce_add_epi32(s0) - 128 * sum_a[0];
+    out[1] = _mm512_reduce_add_epi32(s1) - 128 * sum_a[1];
+    out[2] = _mm512_reduce_add_epi32(s2) - 128 * sum_a[2];
+    out[3] = _mm512_reduce_add_epi32(s3) - 128 * sum_a[3];
+}
+
+static int32_t quant_dot(const int8_t *a, int32_t sum_a, const int8_t *b, MX n)
+{
+    const __m512i flip = _mm512_set1_epi8((char)0x80);
+    __m512i s = _mm512_setzero_si512();
+
+    for (MX t = 0; t < n; t += 64)
+    {
+        s = _mm512_dpbusd_epi32(s, _mm512_xor_si512(_mm512_load_si512((const void *)(b + t)), flip),
+                                _mm512_load_si512((const void *)(a + t)));
+    }
+
+    return _mm512_reduce_add_epi32(s) - 128 * sum_a;
+}
+
+#elif defined(__AVX2__)
+
+static inline int32_t quant_hsum(__m256i v)
+{
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x4e));
+    s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0xb1));
+
+    return _mm_cvtsi128_si32(s);
+}
+
+static inline __m256i quant_madd(__m256i acc, const int8_t *a, __m256i b_lo, __m256i b_hi)
+{
+    __m128i va_lo = _mm_load_si128((const __m128i *)a);
+    __m128i va_hi = _mm_load_si128((const __m128i *)(a + 16));
+
+    acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_cvtepi8_epi16(va_lo), b_lo));
+    return _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_cvtepi8_epi16(va_hi), b_hi));
+}
+
+static void quant_dot4(const int8_t *const a[4], const int32_t sum_a[4], const int8_t *b, MX n, int32_t out[4])
+{
+    __m256i s0 = _mm256_setzero_si256(), s1 = s0, s2 = s0, s3 = s0;
+    (void)sum_a;
+
+    for (MX t = 0; t < n; t += 32)
+    {
+        __m256i b_lo = _mm256_cvtepi8_epi16(_mm_load_si128((const __m128i *)(b + t)));
+        __m256i b_hi = _mm256_cvtepi8_epi16(_mm_load_si128((const __m128i *)(b + t + 16)));
+
+        s0 = quant_madd(s0, a[0] + t, b_lo, b_hi);
+        s1 = quant_madd(s1, a[1] + t, b_lo, b_hi);
+        s2 = quant_madd(s2, a[2] + t, b_lo, b_hi);
+        s3 = quant_madd(s3, a[3] + t, b_lo, b_hi);
+    }
+
+    out[0] = quant_hsum(s0);
+    out[1] = quant_hsum(s1);
+    out[2] = quant_hsum(s2);
+    out[3] = quant_hsum(s3);
+}
+
+static int32_t quant_dot(const int8_t *a, int32_t sum_a, const int8_t *b, MX n)
+{
+    __m256i s = _mm256_setzero_si256();
+    (void)sum_a;
+
+    for (MX t = 0; t < n; t += 32)
+    {
+        s = quant_madd(s, a + t, _mm256_cvtepi8_epi16(_mm_load_si128((const __m128i *)(b + t))),
+                       _mm256_cvtepi8_epi16(_mm_load_si128((const __m128i *)(b + t + 16))));
+    }
+
+    return quant_hsum(s);
+}
+
+#else
+
+static void quant_dot4(const int8_t *const a[4], const int32_t sum_a[4], const int8_t *b, MX n, int32_t out[4])
+{
+    int32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    (void)sum_a;
+
+    for (MX t = 0; t < n; t++)
+    {
+        int32_t vb = b[t];
+
+        s0 += a[0][t] * vb;
+        s1 += a[1][t] * vb;
+        s2 += a[2][t] * vb;
+        s3 += a[3][t] * vb;
+    }
+
+    out[0] = s0;
+    out[1] = s1;
+    out[2] = s2;
+    out[3] = s3;
+}
+
+static int32_t quant_dot(const int8_t *a, int32_t sum_a, const int8_t *b, MX n)
+{
+    int32_t s = 0;
+    (void)sum_a;
+
+    for (MX t = 0; t < n; t++)
+    {
+        s += a[t] * b[t];
+    }
+
+    return s;
+}
+
+#endif
+
+static inline int32_t quant_clamp(long v)
+{
+    return v < -128 ? -128 : (v > 127 ? 127 : (int32_t)v);
+}
+
+static qmatrix quant_allocate(quant_axis axis, MX row, MX col)
+{
+    qmatrix q = QMATRIX_UNDEFINED;
+
+    q.axis = axis;
+    q.row = row;
+    q.col = col;
+    q.lines = axis == QUANT_PER_ROW ? row : col;
+    q.length = axis == QUANT_PER_ROW ? col : row;
+    q.ld = (q.length + QUANT_ALIGN - 1) / QUANT_ALIGN * QUANT_ALIGN;
+
+    size_t bytes = (size_t)q.lines * q.ld;
+
+    q.data = (int8_t *)MEMORY_ALLOC_ALIGNED(bytes > 0 ? bytes : 1);
+    __allocation_err(q.data, "Quantized matrix");
+    memset(q.data, 0, bytes);
+
+    /* Hat parametreleri tek blokta: scale | zero | sum */
+    q.scale = (float *)MEMORY_ALLOC((q.lines > 0 ? q.lines : 1) * (sizeof(float) + 2 * sizeof(int32_t)));
+    __allocation_err(q.scale, "Quantized matrix");
+    q.zero = (int32_t *)(q.scale + q.lines);
+    q.sum = q.zero + q.lines;
+
+    return q;
+}
+
+void __free_qmatrix(qmatrix *q)
+{
+    if (q->data != NULL)
+    {
+        memory_free_aligned(q->data);
+    }
+
+    if (q->scale != NULL)
+    {
+        memory_free(q->scale);
+    }
+
+    *q = QMATRIX_UNDEFINED;
+}
+
+size_t __qmatrix_bytes(qmatrix q)
+{
+    return (size_t)q.lines * q.ld + (size_t)q.lines * (sizeof(float) + 2 * sizeof(int32_t));
+}
+
+/**
+ * @brief Bir hattı int8'e çevirir. Aralık 0'ı içerecek şekilde genişletilir;
+ * böylece sıfırlar (ve doldurma) tam olarak temsil edilir.
+ */
+static void quant_line(const float *x, MX n, int8_t *out, float *scale, int32_t *zero, int32_t *sum)
+{
+    float lo = 0.0f, hi = 0.0f;
+
+    for (MX t = 0; t < n; t++)
+    {
+        lo = x[t] < lo ? x[t] : lo;
+        hi = x[t] > hi ? x[t] : hi;
+    }
+
+    float s = (hi - lo) / 255.0f;
+    int32_t z = 0;
+
+    if (s > 0.0f)
+    {
+        z = quant_clamp(lrintf(-128.0f - lo / s));
+    }
+    else
+    {
+        s = 1.0f;
+    }
+
+    float inv = 1.0f / s;
+    int32_t total = 0;
+
+    for (MX t = 0; t < n; t++)
+    {
+        out[t] = (int8_t)quant_clamp(lrintf(x[t] * inv) + z);
+        total += out[t];
+    }
+
+    *scale = s;
+    *zero = z;
+    *sum = total;
+}
+
+typedef struct
+{
+    matrix matx;
+    qmatrix q;
+
+} quant_convert_ctx;
+
+static void quant_convert_lines(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    quant_convert_ctx *c = (quant_convert_ctx *)arg;
+    float *tmp = NULL;
+    (void)worker;
+
+    if (c->q.axis == QUANT_PER_COL)
+    {
+        tmp = (float *)MEMORY_ALLOC((c->q.length > 0 ? c->q.length : 1) * sizeof(float));
+        __allocation_err(tmp, "Quantized matrix");
+    }
+
+    for (MX h = (MX)begin; h < (MX)end; h++)
+    {
+        const float *x;
+
+        if (c->q.axis == QUANT_PER_ROW)
+        {
+            x = c->matx.vrows[h]->elements;
+        }
+        else
+        {
+            for (MX i = 0; i < c->q.length; i++)
+            {
+                tmp[i] = c->matx.vrows[i]->elements[h];
+            }
+            x = tmp;
+        }
+
+        quant_line(x, c->q.length, c->q.data + (size_t)h * c->q.ld, c->q.scale + h, c->q.zero + h, c->q.sum + h);
+    }
+
+    if (tmp != NULL)
+    {
+        memory_free(tmp);
+    }
+}
+
+qmatrix __quantize_matrix(matrix matx, quant_axis axis)
+{
+    if (matx.vrows == NULL && matx.row > 0)
+    {
+        printf("\n\nDimention Error quantize matrix function\n\n");
+        return QMATRIX_UNDEFINED;
+    }
+
+    quant_convert_ctx ctx = {matx, quant_allocate(axis, matx.row, matx.col)};
+
+    parallel_for(0, ctx.q.lines, ctx.q.length >= QUANT_CHUNK ? 1 : QUANT_CHUNK / (ctx.q.length + 1),
+                 quant_convert_lines, &ctx);
+
+    return ctx.q;
+}
+
+float __qmatrix_get(qmatrix q, MX i, MX j)
+{
+    if (i >= q.row || j >= q.col)
+    {
+        printf("\n\nDimention Error qmatrix get function\n\n");
+        return 0.0f;
+    }
+
+    MX h = q.axis == QUANT_PER_ROW ? i : j;
+    MX t = q.axis == QUANT_PER_ROW ? j : i;
+
+    return q.scale[h] * (float)(q.data[(size_t)h * q.ld + t] - q.zero[h]);
+}
+
+matrix __dequantize_matrix(qmatrix q)
+{
+    matrix out = __zero_matrix(q.row, q.col);
+
+    for (MX h = 0; h < q.lines; h++)
+    {
+        const int8_t *line = q.data + (size_t)h * q.ld;
+        float s = q.scale[h];
+        int32_t z = q.zero[h];
+
+        for (MX t = 0; t < q.length; t++)
+        {
+            float v = s * (float)(line[t] - z);
+
+            if (q.axis == QUANT_PER_ROW)
+                out.vrows[h]->elements[t] = v;
+            else
+                out.vrows[t]->elements[h] = v;
+        }
+    }
+
+    return out;
+}
+
+typedef struct
+{
+    qmatrix A;
+    const int8_t *qx;
+    float sx;
+    int32_t sum_x;
+    const float *x;
+    float *y;
+
+} quant_matvec_ctx;
+
+/**
+ * @brief y_i = scale_i * sx * (sum_t q_it qx_t - zero_i * sum(qx)).
+ */
+static void quant_matvec_rows(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    quant_matvec_ctx *c = (quant_matvec_ctx *)arg;
+    (void)worker;
+
+    for (MX i = (MX)begin; i < (MX)end; i++)
+    {
+        int32_t d = quant_dot(c->A.data + (size_t)i * c->A.ld, c->A.sum[i], c->qx, c->A.ld);
+
+        c->y[i] = c->A.scale[i] * c->sx * (float)((int64_t)d - (int64_t)c->A.zero[i] * c->sum_x);
+    }
+}
+
+/**
+ * @brief Sütun başına ölçekte satır aralığı [begin, end): y_i = sum_j x_j s_j (q_ij - z_j).
+ */
+static void quant_matvec_cols(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    quant_matvec_ctx *c = (quant_matvec_ctx *)arg;
+    float shift = 0.0f;
+    (void)worker;
+
+    for (MX j = 0; j < c->A.lines; j++)
+    {
+        const int8_t *line = c->A.data + (size_t)j * c->A.ld;
+        float k = c->x[j] * c->A.scale[j];
+
+        for (MX i = (MX)begin; i < (MX)end; i++)
+        {
+            c->y[i] += k * (float)line[i];
+        }
+
+        shift += k * (float)c->A.zero[j];
+    }
+
+    for (MX i = (MX)begin; i < (MX)end; i++)
+    {
+        c->y[i] -= shift;
+    }
+}
+
+vec __quant_matvec(qmatrix A, vec x)
+{
+    if (x.dim != A.col || x.elements == NULL || A.data == NULL)
+    {
+        printf("\n\nDimention Error quant matvec function\n\n");
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_QUANT_MATVEC);
+
+    vec y = allocate_vector_mem(A.row);
+    quant_matvec_ctx ctx = {A, NULL, 1.0f, 0, x.elements, y.elements};
+
+    memset(y.elements, 0, (size_t)A.row * sizeof(float));
+
+    if (A.axis == QUANT_PER_ROW)
+    {
+        int8_t *qx = (int8_t *)MEMORY_ALLOC_ALIGNED(A.ld > 0 ? A.ld : 1);
+        float amax = 0.0f;
+
+        __allocation_err(qx, "Quantized vector");
+        memset(qx, 0, A.ld);
+
+        for (MX t = 0; t < x.dim; t++)
+        {
+            amax = fabsf(x.elements[t]) > amax ? fabsf(x.elements[t]) : amax;
+        }
+
+        /* x simetrik: sıfır noktası 0 */
+        ctx.sx = amax > 0.0f ? amax / 127.0f : 1.0f;
+
+        for (MX t = 0; t < x.dim; t++)
+        {
+            qx[t] = (int8_t)quant_clamp(lrintf(x.elements[t] / ctx.sx));
+            ctx.sum_x += qx[t];
+        }
+
+        ctx.qx = qx;
+
+        parallel_for(0, A.row, A.ld >= QUANT_CHUNK ? 1 : QUANT_CHUNK / (A.ld + 1), quant_matvec_rows, &ctx);
+
+        memory_free_aligned(qx);
+    }
+    else
+    {
+        /* Her parça tüm sütunları kendi satır aralığı için tarar; en az 64 satır */
+        unsigned long block = QUANT_CHUNK / (A.col + 1);
+
+        parallel_for(0, A.row, block > 64 ? block : 64, quant_matvec_cols, &ctx);
+    }
+
+    PROFILE_END(PROFILE_QUANT_MATVEC, 2ull * A.row * A.col, (size_t)A.lines * A.ld + (A.row + A.col) * sizeof(float));
+
+    return y;
+}
+
+typedef struct
+{
+    qmatrix A;
+    qmatrix B;
+
+    /* Ham çıktı (raw != NULL) veya ölçeklenmiş matrix */
+    int32_t *raw;
+    MX ldc;
+    matrix C;
+
+} quant_multiply_ctx;
+
+/**
+ * @brief A'nın 4 satırlık blokları [begin, end). B hatları QUANT_B_BLOCK
+ * büyüklüğünde gruplar halinde gezilir ve parçadaki tüm satırlar için kullanılır.
+ */
+static void quant_multiply_rows(void *arg, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    quant_multiply_ctx *c = (quant_multiply_ctx *)arg;
+    MX m = c->A.row, n = c->B.lines, k = c->A.length;
+    MX jblock = c->B.ld >= QUANT_B_BLOCK ? 1 : QUANT_B_BLOCK / (c->B.ld > 0 ? c->B.ld : 1);
+    (void)worker;
+
+    for (MX j0 = 0; j0 < n; j0 += jblock)
+    {
+        MX j1 = n - j0 > jblock ? j0 + jblock : n;
+
+        for (MX blk = (MX)begin; blk < (MX)end; blk++)
+        {
+            MX i0 = blk * 4;
+            MX r = m - i0 < 4 ? m - i0 : 4;
+            const int8_t *a[4];
+            int32_t sa[4];
+
+            for (MX t = 0; t < 4; t++)
+            {
+                MX i = t < r ? i0 + t : i0;
+
+                a[t] = c->A.data + (size_t)i * c->A.ld;
+                sa[t] = c->A.sum[i];
+            }
+
+            for (MX j = j0; j < j1; j++)
+            {
+                int32_t d[4];
+
+                quant_dot4(a, sa, c->B.data + (size_t)j * c->B.ld, c->A.ld, d);
+
+                for (MX t = 0; t < r; t++)
+                {
+                    MX i = i0 + t;
+
+                    if (c->raw != NULL)
+                    {
+                        c->raw[(size_t)i * c->ldc + j] = d[t];
+                        continue;
+                    }
+
+                    /* sum (qa - za)(qb - zb) = d - za sum(qb) - zb sum(qa) + k za zb */
+                    int64_t za = c->A.zero[i], zb = c->B.zero[j];
+                    int64_t v = (int64_t)d[t] - za * c->B.sum[j] - zb * c->A.sum[i] + (int64_t)k * za * zb;
+
+                    c->C.vrows[i]->elements[j] = c->A.scale[i] * c->B.scale[j] * (float)v;
+                }
+            }
+        }
+    }
+}
+
+static bool quant_multiply(qmatrix A, qmatrix B, int32_t *raw, MX ldc, matrix *C)
+{
+    if (A.axis != QUANT_PER_ROW || B.axis != QUANT_PER_COL || A.col != B.row ||
+        (A.row > 0 && A.data == NULL) || (B.col > 0 && B.data == NULL))
+    {
+        printf("\n\nDimention Error quant multiplication function\n\n");
+        return false;
+    }
+
+    PROFILE_BEGIN(PROFILE_QUANT_MULTIPLICATION);
+
+    quant_multiply_ctx ctx = {A, B, raw, ldc, MATRIX_UNDEFINED};
+    unsigned long blocks = (A.row + 3) / 4;
+    unsigned long block_work = 4ul * B.col * (A.ld + 1);
+
+    if (raw == NULL)
+    {
+        ctx.C = __zero_matrix(A.row, B.col);
+    }
+
+    parallel_for(0, blocks, block_work >= QUANT_CHUNK ? 1 : QUANT_CHUNK / block_work, quant_multiply_rows, &ctx);
+
+    if (C != NULL)
+    {
+        *C = ctx.C;
+    }
+
+    PROFILE_END(PROFILE_QUANT_MULTIPLICATION, 2ull * A.row * A.col * B.col,
+                (size_t)A.lines * A.ld + (size_t)B.lines * B.ld + (size_t)A.row * B.col * sizeof(float));
+
+    return true;
+}
+
+bool __quant_multiplication_int32(qmatrix A, qmatrix B, int32_t *C, MX ldc)
+{
+    if (C == NULL || ldc < B.col)
+    {
+        printf("\n\nDimention Error quant multiplication function\n\n");
+        return false;
+    }
+
+    return quant_multiply(A, B, C, ldc, NULL);
+}
+
+matrix __quant_multiplication(qmatrix A, qmatrix B)
+{
+    matrix C = MATRIX_UNDEFINED;
+
+    return quant_multiply(A, B, NULL, 0, &C) ? C : MATRIX_UNDEFINED;
+}
\ No newline at end of file
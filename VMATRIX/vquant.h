@@ -0,0 +1,116 @@
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vmatrix.h"
+#include "../CMATH/vec.h"
+
+#ifndef VQUANT_H
+#define VQUANT_H
+
+/**
+ * @brief Ölçek ve sıfır noktasının paylaşıldığı eksen.
+ *
+ * QUANT_PER_ROW : her satırın kendi ölçeği vardır, satırlar art arda tutulur
+ * QUANT_PER_COL : her sütunun kendi ölçeği vardır, sütunlar art arda tutulur
+ *
+ * Her iki durumda da aynı ölçeği paylaşan elemanlara "hat" denir ve bir hat
+ * bellekte bitişiktir; böylece int8 nokta çarpımları hat üzerinde yapılır.
+ */
+typedef enum
+{
+    QUANT_PER_ROW,
+    QUANT_PER_COL
+
+} quant_axis;
+
+/**
+ * @brief int8 olarak tutulan matrix: A[i][j] ~ scale[h] * (q - zero[h]).
+ *
+ * Hatlar ld bayt aralıkla ve sıfırla doldurularak tutulur; sum[h] hattaki
+ * q değerlerinin toplamıdır (sıfır noktası düzeltmesi için).
+ */
+typedef struct
+{
+    quant_axis axis;
+    MX row;
+    MX col;
+
+    /* Hat sayısı ve hat uzunluğu (PER_ROW: row ve col, PER_COL: col ve row) */
+    MX lines;
+    MX length;
+    MX ld;
+
+    int8_t *data;
+    float *scale;
+    int32_t *zero;
+    int32_t *sum;
+
+} qmatrix;
+
+extern const qmatrix QMATRIX_UNDEFINED;
+
+/**
+ * @brief Her hattın [min, max] aralığını (0 dahil) 256 düzeye böler.
+ *
+ * @param matx
+ * @param axis
+ * @return qmatrix
+ */
+qmatrix __quantize_matrix(matrix matx, quant_axis axis);
+
+/**
+ * @brief float karşılığı; her eleman scale * (q - zero).
+ *
+ * @param q
+ * @return matrix
+ */
+matrix __dequantize_matrix(qmatrix q);
+
+void __free_qmatrix(qmatrix *q);
+
+float __qmatrix_get(qmatrix q, MX i, MX j);
+
+/**
+ * @brief Bellekteki bayt sayısı (veri ve hat parametreleri).
+ */
+size_t __qmatrix_bytes(qmatrix q);
+
+/**
+ * @brief y = A . x.
+ *
+ * PER_ROW: x simetrik olarak int8'e çevrilir, her satır int8 x int8 -> int32
+ * nokta çarpımıyla hesaplanır ve sonuç ölçek/sıfır noktası ile float'a döner.
+ * PER_COL: sütunlar x_j * scale_j katsayısıyla float birikece eklenir.
+ *
+ * @param A
+ * @param x A.col boyutlu
+ * @return vec
+ */
+vec __quant_matvec(qmatrix A, vec x);
+
+/**
+ * @brief Ham tamsayı çarpımı: C[i][j] = sum_t qA[i][t] * qB[t][j] (int32).
+ *
+ * A satır başına (QUANT_PER_ROW), B sütun başına (QUANT_PER_COL) ölçeklenmiş
+ * olmalıdır; böylece her C elemanı iki bitişik hattın nokta çarpımıdır.
+ * Sıfır noktası düzeltmesi yapılmaz.
+ *
+ * @param A
+ * @param B
+ * @param C En az A.row * ldc eleman
+ * @param ldc
+ * @return bool Boyutlar veya eksenler uymuyorsa false
+ */
+bool __quant_multiplication_int32(qmatrix A, qmatrix B, int32_t *C, MX ldc);
+
+/**
+ * @brief C = A . B; tamsayı çarpımının ardından ölçek ve sıfır noktası
+ * düzeltmesi aynı döngüde uygulanır (int32 ara matrix tutulmaz).
+ *
+ * @param A QUANT_PER_ROW
+ * @param B QUANT_PER_COL
+ * @return matrix
+ */
+matrix __quant_multiplication(qmatrix A, qmatrix B);
+
+#endif
\ No newline at end of file
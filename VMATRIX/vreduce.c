@@ -0,0 +1,788 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+//
+//      VREDUCE.C
+//  Satır ve sütun indirgemeleri,
+//  satır normalleştirme
+//
+#include "vreduce.h"
+#include "../CMATH/memory.h"
+#include "../CMATH/parallel.h"
+#include "../CMATH/profile.h"
+#include "../CMATH/simd.h"
+
+/**
+ * @brief Bir parallel_for parçasının hedeflediği eleman sayısı.
+ */
+#define REDUCE_CHUNK 32768
+
+/**
+ * @brief Arg indirgemelerinde henüz aday bulunmadığını gösterir.
+ */
+#define REDUCE_NO_INDEX 0xFFFFFFFFu
+
+static unsigned long reduce_grain(MX col)
+{
+    return col >= REDUCE_CHUNK ? 1 : REDUCE_CHUNK / (col > 0 ? col : 1);
+}
+
+//
+//  Satır çekirdekleri
+//
+
+/**
+ * @brief Toplam veya mutlak değerlerin toplamı.
+ */
+static float row_sum(const float *x, MX n, bool absolute)
+{
+    float r = 0.0f;
+    MX j = 0;
+
+#if SIMD_WIDTH > 1
+    simd_f s0 = simd_zero(), s1 = simd_zero();
+
+    if (absolute)
+    {
+        for (; j + 2 * SIMD_WIDTH <= n; j += 2 * SIMD_WIDTH)
+        {
+            s0 = simd_addv(s0, simd_absv(simd_loadu(x + j)));
+            s1 = simd_addv(s1, simd_absv(simd_loadu(x + j + SIMD_WIDTH)));
+        }
+    }
+    else
+    {
+        for (; j + 2 * SIMD_WIDTH <= n; j += 2 * SIMD_WIDTH)
+        {
+            s0 = simd_addv(s0, simd_loadu(x + j));
+            s1 = simd_addv(s1, simd_loadu(x + j + SIMD_WIDTH));
+        }
+    }
+
+    r = simd_hsum(simd_addv(s0, s1));
+#endif
+
+    for (; j < n; j++)
+    {
+        r += absolute ? fabsf(x[j]) : x[j];
+    }
+
+    return r;
+}
+
+/**
+ * @brief En küçük, en büyük veya en büyük mutlak değer (n > 0).
+ */
+static float row_extreme(const float *x, MX n, reduce_op op)
+{
+    float r = op == REDUCE_LINF ? fabsf(x[0]) : x[0];
+    MX j = 1;
+
+#if SIMD_WIDTH > 1
+    if (n >= SIMD_WIDTH)
+    {
+        simd_f m = simd_loadu(x);
+
+        switch (op)
+        {
+        case REDUCE_MIN:
+            for (j = SIMD_WIDTH; j + SIMD_WIDTH <= n; j += SIMD_WIDTH)
+            {
+                m = simd_minv(m, simd_loadu(x + j));
+            }
+            r = simd_hmin(m);
+            break;
+        case REDUCE_MAX:
+            for (j = SIMD_WIDTH; j + SIMD_WIDTH <= n; j += SIMD_WIDTH)
+            {
+                m = simd_maxv(m, simd_loadu(x + j));
+            }
+            r = simd_hmax(m);
+            break;
+        default:
+            m = simd_absv(m);
+            for (j = SIMD_WIDTH; j + SIMD_WIDTH <= n; j += SIMD_WIDTH)
+            {
+                m = simd_maxv(m, simd_absv(simd_loadu(x + j)));
+            }
+            r = simd_hmax(m);
+            break;
+        }
+    }
+#endif
+
+    for (; j < n; j++)
+    {
+        float v = op == REDUCE_LINF ? fabsf(x[j]) : x[j];
+
+        if (op == REDUCE_MIN ? v < r : v > r)
+        {
+            r = v;
+        }
+    }
+
+    return r;
+}
+
+/**
+ * @brief Satırın op ile indirgenmiş değeri (n > 0).
+ */
+static float row_reduce(const float *x, MX n, reduce_op op)
+{
+    switch (op)
+    {
+    case REDUCE_SUM:
+        return row_sum(x, n, false);
+    case REDUCE_MEAN:
+        return row_sum(x, n, false) / (float)n;
+    case REDUCE_L1:
+        return row_sum(x, n, true);
+    case REDUCE_L2:
+        return sqrtf(simd_dot(x, x, n));
+    default:
+        return row_extreme(x, n, op);
+    }
+}
+
+/**
+ * @brief Şerit konumları float tutulur; 2^24'e kadar tam olduğundan satır
+ * en fazla bu uzunlukta parçalar halinde taranır.
+ */
+#define REDUCE_ARG_SPAN (1u << 24)
+
+/**
+ * @brief Satırdaki en küçük (maximum ise en büyük) elemanın ilk konumu.
+ *
+ * Tek geçiştir: her şerit ±sonsuzdan başlayarak kendi adayını ve konumunu
+ * tutar, kesin karşılaştırma ile şerit içindeki ilk konum korunur; şeritler
+ * parça sonunda bir kez birleştirilir. NaN değerler atlanır. Yalnızca satırın
+ * uç değeri sonsuz ise (veya satırda yalnızca NaN varsa) satır bir kez daha
+ * taranır; yalnızca NaN varsa 0 döner.
+ */
+static unsigned int row_arg(const float *x, MX n, bool maximum)
+{
+    const float none = maximum ? -INFINITY : INFINITY;
+    float best = none;
+    unsigned int best_j = 0;
+    MX j = 0;
+
+#if SIMD_WIDTH > 1
+    static const float ramp[16] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    const simd_f step = simd_set1((float)SIMD_WIDTH);
+
+    while (j + SIMD_WIDTH <= n)
+    {
+        const MX base = j;
+        const MX stop = n - base > REDUCE_ARG_SPAN ? base + REDUCE_ARG_SPAN : n;
+        simd_f m = simd_set1(none);
+        simd_f at = simd_subv(simd_loadu(ramp), step);
+        simd_f pos = simd_zero();
+
+        if (maximum)
+        {
+            for (; j + SIMD_WIDTH <= stop; j += SIMD_WIDTH)
+            {
+                simd_f v = simd_loadu(x + j);
+
+                at = simd_addv(at, step);
+                pos = simd_select_lt(m, v, at, pos);
+                m = simd_select_lt(m, v, v, m);
+            }
+        }
+        else
+        {
+            for (; j + SIMD_WIDTH <= stop; j += SIMD_WIDTH)
+            {
+                simd_f v = simd_loadu(x + j);
+
+                at = simd_addv(at, step);
+                pos = simd_select_lt(v, m, at, pos);
+                m = simd_select_lt(v, m, v, m);
+            }
+        }
+
+        float lane_best[SIMD_WIDTH], lane_pos[SIMD_WIDTH];
+
+        simd_storeu(lane_best, m);
+        simd_storeu(lane_pos, pos);
+
+        for (int l = 0; l < SIMD_WIDTH; l++)
+        {
+            const float v = lane_best[l];
+            const unsigned int at_j = base + (unsigned int)lane_pos[l];
+
+            // Şeritler sırasız birleştiğinden eşitlikte küçük konum seçilir
+            if ((maximum ? v > best : v < best) || (v == best && v != none && at_j < best_j))
+            {
+                best = v;
+                best_j = at_j;
+            }
+        }
+    }
+#endif
+
+    for (; j < n; j++)
+    {
+        if (maximum ? x[j] > best : x[j] < best)
+        {
+            best = x[j];
+            best_j = j;
+        }
+    }
+
+    if (best != none)
+    {
+        return best_j;
+    }
+
+    // Hiçbir eleman başlangıç değerini geçemedi: ilk NaN olmayan eleman
+    for (j = 0; j < n; j++)
+    {
+        if (x[j] == x[j])
+        {
+            return j;
+        }
+    }
+
+    return 0;
+}
+
+typedef struct
+{
+    matrix matx;
+    reduce_op op;
+    float *values;
+    unsigned int *indices;
+
+} reduce_rows_ctx;
+
+static void reduce_rows_task(void *ctx, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    (void)worker;
+
+    reduce_rows_ctx *c = (reduce_rows_ctx *)ctx;
+
+    for (unsigned long i = begin; i < end; i++)
+    {
+        const float *x = c->matx.vrows[i]->elements;
+
+        if (c->indices != NULL)
+        {
+            c->indices[i] = row_arg(x, c->matx.col, c->op == REDUCE_MAX);
+        }
+        else
+        {
+            c->values[i] = row_reduce(x, c->matx.col, c->op);
+        }
+    }
+}
+
+vec __reduce_rows(matrix matx, reduce_op op)
+{
+    if (matx.row == 0 || matx.col == 0)
+    {
+        printf("\n\nDimention Error reduce rows function\n\n");
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_REDUCE);
+
+    vec ret_vec = allocate_vector_mem(matx.row);
+    reduce_rows_ctx ctx = {matx, op, ret_vec.elements, NULL};
+
+    parallel_for(0, matx.row, reduce_grain(matx.col), reduce_rows_task, &ctx);
+
+    PROFILE_END(PROFILE_MATRIX_REDUCE, 2ull * matx.row * matx.col,
+                ((unsigned long long)matx.row * matx.col + matx.row) * sizeof(float));
+
+    return ret_vec;
+}
+
+static bool arg_rows(matrix matx, reduce_op op, unsigned int *indices)
+{
+    if (matx.row == 0 || matx.col == 0 || indices == NULL)
+    {
+        printf("\n\nDimention Error arg reduce function\n\n");
+        return false;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_REDUCE);
+
+    reduce_rows_ctx ctx = {matx, op, NULL, indices};
+
+    parallel_for(0, matx.row, reduce_grain(matx.col), reduce_rows_task, &ctx);
+
+    PROFILE_END(PROFILE_MATRIX_REDUCE, (unsigned long long)matx.row * matx.col,
+                (unsigned long long)matx.row * matx.col * sizeof(float));
+
+    return true;
+}
+
+bool __argmin_rows(matrix matx, unsigned int *indices)
+{
+    return arg_rows(matx, REDUCE_MIN, indices);
+}
+
+bool __argmax_rows(matrix matx, unsigned int *indices)
+{
+    return arg_rows(matx, REDUCE_MAX, indices);
+}
+
+//
+//  Sütun çekirdekleri
+//
+
+/**
+ * @brief Bir satırı sütun birikimlerine ekler: acc[j] = op(acc[j], x[j]).
+ */
+static void col_accumulate(float *acc, const float *x, MX n, reduce_op op)
+{
+    MX j = 0;
+
+#if SIMD_WIDTH > 1
+#define COL_LOOP(EXPR)                                         \
+    for (; j + SIMD_WIDTH <= n; j += SIMD_WIDTH)               \
+    {                                                          \
+        simd_f a = simd_loadu(acc + j), v = simd_loadu(x + j); \
+        simd_storeu(acc + j, EXPR);                            \
+    }
+
+    switch (op)
+    {
+    case REDUCE_SUM:
+    case REDUCE_MEAN:
+        COL_LOOP(simd_addv(a, v))
+        break;
+    case REDUCE_L1:
+        COL_LOOP(simd_addv(a, simd_absv(v)))
+        break;
+    case REDUCE_L2:
+        COL_LOOP(simd_fmaddv(v, v, a))
+        break;
+    case REDUCE_LINF:
+        COL_LOOP(simd_maxv(a, simd_absv(v)))
+        break;
+    case REDUCE_MIN:
+        COL_LOOP(simd_minv(a, v))
+        break;
+    case REDUCE_MAX:
+        COL_LOOP(simd_maxv(a, v))
+        break;
+    }
+
+#undef COL_LOOP
+#endif
+
+    for (; j < n; j++)
+    {
+        float v = x[j];
+
+        switch (op)
+        {
+        case REDUCE_SUM:
+        case REDUCE_MEAN:
+            acc[j] += v;
+            break;
+        case REDUCE_L1:
+            acc[j] += fabsf(v);
+            break;
+        case REDUCE_L2:
+            acc[j] += v * v;
+            break;
+        case REDUCE_LINF:
+            acc[j] = fabsf(v) > acc[j] ? fabsf(v) : acc[j];
+            break;
+        case REDUCE_MIN:
+            acc[j] = v < acc[j] ? v : acc[j];
+            break;
+        case REDUCE_MAX:
+            acc[j] = v > acc[j] ? v : acc[j];
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Arg sütun birikimlerine bir satır ekler. Bir thread satırları artan
+ * sırada gördüğünden kesin karşılaştırma ilk konumu korur. Değişen şeritler
+ * SIMD karşılaştırma maskesiyle bulunur.
+ */
+static void col_arg_accumulate(float *acc, unsigned int *idx, const float *x, MX n,
+                               bool maximum, unsigned int row)
+{
+    MX j = 0;
+
+#if SIMD_WIDTH > 1
+    for (; j + SIMD_WIDTH <= n; j += SIMD_WIDTH)
+    {
+        simd_f a = simd_loadu(acc + j), v = simd_loadu(x + j);
+        unsigned int mask = maximum ? simd_lt_mask(a, v) : simd_lt_mask(v, a);
+
+        while (mask != 0)
+        {
+            unsigned int lane = (unsigned int)__builtin_ctz(mask);
+            mask &= mask - 1;
+
+            acc[j + lane] = x[j + lane];
+            idx[j + lane] = row;
+        }
+    }
+#endif
+
+    for (; j < n; j++)
+    {
+        if (maximum ? x[j] > acc[j] : x[j] < acc[j])
+        {
+            acc[j] = x[j];
+            idx[j] = row;
+        }
+    }
+}
+
+typedef struct
+{
+    matrix matx;
+    reduce_op op;
+
+    /* Thread başına stride elemanlık kısmi sonuçlar */
+    float *partial;
+    unsigned int *partial_idx;
+    size_t stride;
+
+} reduce_cols_ctx;
+
+static void reduce_cols_task(void *ctx, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    reduce_cols_ctx *c = (reduce_cols_ctx *)ctx;
+    float *acc = c->partial + worker * c->stride;
+
+    for (unsigned long i = begin; i < end; i++)
+    {
+        const float *x = c->matx.vrows[i]->elements;
+
+        if (c->partial_idx != NULL)
+        {
+            col_arg_accumulate(acc, c->partial_idx + worker * c->stride, x, c->matx.col,
+                               c->op == REDUCE_MAX, (unsigned int)i);
+        }
+        else
+        {
+            col_accumulate(acc, x, c->matx.col, c->op);
+        }
+    }
+}
+
+/**
+ * @brief Sütun indirgemelerinin ortak gövdesi. indices NULL değilse arg
+ * indirgemesi yapılır ve values yalnızca ara tampon olarak kullanılır.
+ */
+static bool reduce_cols(matrix matx, reduce_op op, float *values, unsigned int *indices)
+{
+    const unsigned int threads = parallel_threads();
+    const size_t stride = (matx.col + 15) & ~(size_t)15;
+    const MX n = matx.col;
+
+    float *partial = (float *)MEMORY_ALLOC_ALIGNED(threads * stride * sizeof(float));
+    unsigned int *partial_idx = NULL;
+
+    __allocation_err(partial, "reduce cols");
+
+    float init = 0.0f;
+
+    if (op == REDUCE_MIN)
+    {
+        init = INFINITY;
+    }
+    else if (op == REDUCE_MAX)
+    {
+        init = -INFINITY;
+    }
+
+    for (size_t i = 0; i < threads * stride; i++)
+    {
+        partial[i] = init;
+    }
+
+    if (indices != NULL)
+    {
+        partial_idx = (unsigned int *)MEMORY_ALLOC(threads * stride * sizeof(unsigned int));
+        __allocation_err(partial_idx, "reduce cols");
+
+        memset(partial_idx, 0xFF, threads * stride * sizeof(unsigned int));
+    }
+
+    reduce_cols_ctx ctx = {matx, op, partial, partial_idx, stride};
+
+    parallel_for(0, matx.row, reduce_grain(matx.col), reduce_cols_task, &ctx);
+
+    // Kısmi sonuçlar birleştirilir
+    for (MX j = 0; j < n; j++)
+    {
+        values[j] = partial[j];
+    }
+
+    for (unsigned int w = 1; w < threads; w++)
+    {
+        const float *p = partial + w * stride;
+
+        if (indices != NULL)
+        {
+            const unsigned int *pi = partial_idx + w * stride;
+
+            for (MX j = 0; j < n; j++)
+            {
+                bool better = op == REDUCE_MAX ? p[j] > values[j] : p[j] < values[j];
+
+                if (pi[j] != REDUCE_NO_INDEX &&
+                    (better || partial_idx[j] == REDUCE_NO_INDEX || (p[j] == values[j] && pi[j] < partial_idx[j])))
+                {
+                    values[j] = p[j];
+                    partial_idx[j] = pi[j];
+                }
+            }
+            continue;
+        }
+
+        switch (op)
+        {
+        case REDUCE_SUM:
+        case REDUCE_MEAN:
+        case REDUCE_L1:
+        case REDUCE_L2:
+            simd_add(values, values, p, n);
+            break;
+        default:
+            col_accumulate(values, p, n, op == REDUCE_LINF ? REDUCE_MAX : op);
+            break;
+        }
+    }
+
+    if (indices != NULL)
+    {
+        for (MX j = 0; j < n; j++)
+        {
+            // Sütunda yalnızca NaN veya sonsuz varsa
+            indices[j] = partial_idx[j] != REDUCE_NO_INDEX ? partial_idx[j] : 0;
+        }
+    }
+    else if (op == REDUCE_MEAN)
+    {
+        simd_scale(values, values, 1.0f / (float)matx.row, n);
+    }
+    else if (op == REDUCE_L2)
+    {
+        for (MX j = 0; j < n; j++)
+        {
+            values[j] = sqrtf(values[j]);
+        }
+    }
+
+    memory_free_aligned(partial);
+    memory_free(partial_idx);
+
+    return true;
+}
+
+vec __reduce_cols(matrix matx, reduce_op op)
+{
+    if (matx.row == 0 || matx.col == 0)
+    {
+        printf("\n\nDimention Error reduce cols function\n\n");
+        return VEC_UNDEFINED;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_REDUCE);
+
+    vec ret_vec = allocate_vector_mem(matx.col);
+
+    reduce_cols(matx, op, ret_vec.elements, NULL);
+
+    PROFILE_END(PROFILE_MATRIX_REDUCE, 2ull * matx.row * matx.col,
+                ((unsigned long long)matx.row * matx.col + matx.col) * sizeof(float));
+
+    return ret_vec;
+}
+
+static bool arg_cols(matrix matx, reduce_op op, unsigned int *indices)
+{
+    if (matx.row == 0 || matx.col == 0 || indices == NULL)
+    {
+        printf("\n\nDimention Error arg reduce function\n\n");
+        return false;
+    }
+
+    PROFILE_BEGIN(PROFILE_MATRIX_REDUCE);
+
+    float *values = (float *)MEMORY_ALLOC(matx.col * sizeof(float));
+
+    __allocation_err(values, "arg reduce");
+
+    reduce_cols(matx, op, values, indices);
+
+    memory_free(values);
+
+    PROFILE_END(PROFILE_MATRIX_REDUCE, (unsigned long long)matx.row * matx.col,
+                (unsigned long long)matx.row * matx.col * sizeof(float));
+
+    return true;
+}
+
+bool __argmin_cols(matrix matx, unsigned int *indices)
+{
+    return arg_cols(matx, REDUCE_MIN, indices);
+}
+
+bool __argmax_cols(matrix matx, unsigned int *indices)
+{
+    return arg_cols(matx, REDUCE_MAX, indices);
+}
+
+//
+//  Yerinde normalleştirme
+//
+
+static void normalize_rows_task(void *ctx, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    (void)worker;
+
+    matrix *matx = (matrix *)ctx;
+    const MX n = matx->col;
+    const bool aligned = (matx->flags & MATRIX_ALIGNED) != 0;
+
+    for (unsigned long i = begin; i < end; i++)
+    {
+        float *x = matx->vrows[i]->elements;
+
+        // Satır ikinci okumada hala L1 önbellekte olur
+        float norm = sqrtf(aligned ? simd_dot_a(x, x, n) : simd_dot(x, x, n));
+
+        if (norm <= 0.0f)
+        {
+            continue;
+        }
+
+        if (aligned)
+        {
+            simd_scale_a(x, x, 1.0f / norm, n);
+        }
+        else
+        {
+            simd_scale(x, x, 1.0f / norm, n);
+        }
+    }
+}
+
+void __normalize_rows(matrix *matx)
+{
+    if (matx->row == 0 || matx->col == 0)
+    {
+        return;
+    }
+
+    __unshare_matrix(matx);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_NORMALIZE);
+
+    parallel_for(0, matx->row, reduce_grain(matx->col), normalize_rows_task, matx);
+
+    PROFILE_END(PROFILE_MATRIX_NORMALIZE, 3ull * matx->row * matx->col,
+                2ull * matx->row * matx->col * sizeof(float));
+}
+
+typedef struct
+{
+    matrix *matx;
+    float epsilon;
+
+} standardize_ctx;
+
+static void standardize_rows_task(void *ctx, unsigned long begin, unsigned long end, unsigned int worker)
+{
+    (void)worker;
+
+    standardize_ctx *c = (standardize_ctx *)ctx;
+    const MX n = c->matx->col;
+
+    for (unsigned long i = begin; i < end; i++)
+    {
+        float *x = c->matx->vrows[i]->elements;
+
+        // Toplamlar ilk elemana göre kaydırılarak alınır; büyük ortalamalı
+        // satırlarda sum(x^2) - n * mean^2 farkındaki kaybı önler
+        const float shift = x[0];
+        float s = 0.0f, ss = 0.0f;
+        MX j = 0;
+
+#if SIMD_WIDTH > 1
+        simd_f vk = simd_set1(shift);
+        simd_f vs = simd_zero(), vss = simd_zero();
+
+        for (; j + SIMD_WIDTH <= n; j += SIMD_WIDTH)
+        {
+            simd_f d = simd_subv(simd_loadu(x + j), vk);
+            vs = simd_addv(vs, d);
+            vss = simd_fmaddv(d, d, vss);
+        }
+
+        s = simd_hsum(vs);
+        ss = simd_hsum(vss);
+#endif
+
+        for (; j < n; j++)
+        {
+            float d = x[j] - shift;
+            s += d;
+            ss += d * d;
+        }
+
+        const float mean_d = s / (float)n;
+        float var = ss / (float)n - mean_d * mean_d;
+        var = var > 0.0f ? var : 0.0f;
+
+        // x' = x * scale + bias
+        const float scale = var + c->epsilon > 0.0f ? 1.0f / sqrtf(var + c->epsilon) : 0.0f;
+        const float bias = -(shift + mean_d) * scale;
+
+        j = 0;
+
+#if SIMD_WIDTH > 1
+        simd_f va = simd_set1(scale), vb = simd_set1(bias);
+
+        for (; j + SIMD_WIDTH <= n; j += SIMD_WIDTH)
+        {
+            simd_storeu(x + j, simd_fmaddv(simd_loadu(x + j), va, vb));
+        }
+#endif
+
+        for (; j < n; j++)
+        {
+            x[j] = x[j] * scale + bias;
+        }
+    }
+}
+
+void __standardize_rows(matrix *matx, float epsilon)
+{
+    if (matx->row == 0 || matx->col == 0)
+    {
+        return;
+    }
+
+    if (epsilon < 0.0f)
+    {
+        printf("\n\nStandardize epsilon cannot be negative\n\n");
+        return;
+    }
+
+    __unshare_matrix(matx);
+
+    PROFILE_BEGIN(PROFILE_MATRIX_NORMALIZE);
+
+    standardize_ctx ctx = {matx, epsilon};
+
+    parallel_for(0, matx->row, reduce_grain(matx->col), standardize_rows_task, &ctx);
+
+    PROFILE_END(PROFILE_MATRIX_NORMALIZE, 5ull * matx->row * matx->col,
+                2ull * matx->row * matx->col * sizeof(float));
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "vmatrix.h"
+#include "../CMATH/vec.h"
+
+#ifndef VREDUCE_H
+#define VREDUCE_H
+
+/**
+ * @brief Bir satır veya sütun boyunca uygulanacak indirgeme.
+ *
+ * REDUCE_SUM  : toplam
+ * REDUCE_MEAN : ortalama
+ * REDUCE_L1   : mutlak değerlerin toplamı
+ * REDUCE_L2   : öklid normu
+ * REDUCE_LINF : en büyük mutlak değer
+ * REDUCE_MIN  : en küçük değer
+ * REDUCE_MAX  : en büyük değer
+ */
+typedef enum
+{
+    REDUCE_SUM,
+    REDUCE_MEAN,
+    REDUCE_L1,
+    REDUCE_L2,
+    REDUCE_LINF,
+    REDUCE_MIN,
+    REDUCE_MAX
+
+} reduce_op;
+
+/**
+ * @brief Her satırı tek bir değere indirger.
+ *
+ * @param matx
+ * @param op
+ * @return vec matx.row boyutlu vektör
+ */
+vec __reduce_rows(matrix matx, reduce_op op);
+
+/**
+ * @brief Her sütunu tek bir değere indirger.
+ *
+ * Satırlar thread'lere bölünür, her thread kendi kısmi sonucunu tutar
+ * ve sonuçlar en sonda birleştirilir. Matrix satır satır tek kez okunur.
+ *
+ * @param matx
+ * @param op
+ * @return vec matx.col boyutlu vektör
+ */
+vec __reduce_cols(matrix matx, reduce_op op);
+
+/**
+ * @brief Her satırdaki en küçük / en büyük elemanın sütun indeksi.
+ * Eşitlikte küçük indeks seçilir; NaN elemanlar atlanır. Satır tek geçişte okunur.
+ *
+ * @param matx
+ * @param indices matx.row elemanlı dizi
+ * @return bool
+ */
+bool __argmin_rows(matrix matx, unsigned int *indices);
+bool __argmax_rows(matrix matx, unsigned int *indices);
+
+/**
+ * @brief Her sütundaki en küçük / en büyük elemanın satır indeksi.
+ * Eşitlikte küçük indeks seçilir.
+ *
+ * @param matx
+ * @param indices matx.col elemanlı dizi
+ * @return bool
+ */
+bool __argmin_cols(matrix matx, unsigned int *indices);
+bool __argmax_cols(matrix matx, unsigned int *indices);
+
+/**
+ * @brief Her satırı yerinde birim L2 normuna getirir.
+ * Normu 0 olan satırlar değişmez.
+ *
+ * @param matx
+ */
+void __normalize_rows(matrix *matx);
+
+/**
+ * @brief Her satırı yerinde sıfır ortalama ve birim varyansa getirir.
+ *
+ * x = (x - ortalama) / sqrt(varyans + epsilon)
+ * Ortalama ve varyans satır üzerinden tek geçişte hesaplanır.
+ *
+ * @param matx
+ * @param epsilon Sabit satırlarda sıfıra bölmeyi önler
+ */
+void __standardize_rows(matrix *matx, float epsilon);
+
+#endif
\ No newline at end of file
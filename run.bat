@@ -1,2 +1,2 @@
-gcc -Wvarargs ./VMATRIX/vmatrix.c main.c ./CMATH/vec.c
+gcc -Wvarargs ./VMATRIX/vmatrix.c ./VMATRIX/vkernel.c ./VMATRIX/vdistance.c main.c ./CMATH/vec.c ./CMATH/matrix.c ./CMATH/profile.c ./CMATH/memory.c ./CMATH/parallel.c ./VMATRIX/vknn.c ./VMATRIX/vreduce.c ./VMATRIX/vmap.c ./VMATRIX/vasync.c ./VMATRIX/vgraph.c ./VMATRIX/vfile.c ./VMATRIX/vpacked.c ./VMATRIX/vimplicit.c ./VMATRIX/vbatch.c ./VMATRIX/vquant.c ./VMATRIX/vhalf.c ./VMATRIX/vexpm.c ./VMATRIX/vmodular.c ./VMATRIX/vblock.c -pthread
 a.exe
\ No newline at end of file